@@ -0,0 +1,200 @@
+#include "Bench.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+ * GameEngineBench [--filter=text] [--out=file] [--min-time=seconds] [--repetitions=count] [--list]
+ * Writes the results as JSON (bench_results.json by default) and a summary table to stdout.
+ */
+
+namespace {
+	struct Case {
+		std::string name;
+		std::vector<int64_t> arguments;
+		Bench::Function function;
+	};
+
+	std::vector<Case>& getCases() {
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	struct Options {
+		std::string filter;
+		std::string outputFilename = "bench_results.json";
+		double minTime = 0.1;
+		int repetitions = 5;
+		bool list = false;
+	};
+
+	Options parseOptions(int argc, char** argv) {
+		Options options;
+		for (int i = 1; i < argc; ++i) {
+			const std::string_view argument = argv[i];
+			auto value = [&](std::string_view prefix) { return std::string(argument.substr(prefix.size())); };
+			if (argument.starts_with("--filter=")) options.filter = value("--filter=");
+			else if (argument.starts_with("--out=")) options.outputFilename = value("--out=");
+			else if (argument.starts_with("--min-time=")) options.minTime = std::atof(value("--min-time=").c_str());
+			else if (argument.starts_with("--repetitions=")) options.repetitions = std::max(1, std::atoi(value("--repetitions=").c_str()));
+			else if (argument == "--list") options.list = true;
+			else std::println("Ignoring unknown option {}", argument);
+		}
+		return options;
+	}
+
+	std::string getCaseName(const Case& benchCase, int64_t argument) {
+		return benchCase.name + "/" + std::to_string(argument);
+	}
+
+	/* runs until one run takes at least minTime, returns the iteration count that did */
+	uint64_t calibrate(const Case& benchCase, int64_t argument, double minTime, std::string& skipReason) {
+		uint64_t iterations = 1;
+		while (true) {
+			Bench::State state(iterations, argument);
+			benchCase.function(state);
+			if (!state.skipReason.empty()) {
+				skipReason = state.skipReason;
+				return 0;
+			}
+
+			const double elapsed = state.elapsedSeconds();
+			if (elapsed >= minTime || iterations >= 1'000'000'000) return iterations;
+
+			/* aim 20% past minTime, but never grow more than 10x on a noisy first run */
+			const double perIteration = elapsed / static_cast<double>(iterations);
+			const double wanted = perIteration > 0.0 ? minTime * 1.2 / perIteration : iterations * 10.0;
+			iterations = static_cast<uint64_t>(std::clamp(wanted, iterations * 2.0, iterations * 10.0));
+		}
+	}
+
+	std::string getTimestamp() {
+		const std::time_t now = std::time(nullptr);
+		char buffer[32];
+		std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+		return buffer;
+	}
+}
+
+void Bench::registerCase(std::string name, std::vector<int64_t> arguments, Function function) {
+	getCases().push_back({ std::move(name), std::move(arguments), std::move(function) });
+}
+
+void Bench::doNotOptimize(const void* value) {
+	static std::atomic<const void*> sink;
+	sink.store(value, std::memory_order_relaxed);
+}
+
+bool Bench::State::next() {
+	if (!m_started) {
+		m_started = true;
+		m_running = true;
+		m_start = Clock::now();
+	}
+	if (m_remaining == 0) {
+		pause();
+		return false;
+	}
+	--m_remaining;
+	return true;
+}
+
+void Bench::State::pause() {
+	if (!m_running) return;
+	m_elapsed += Clock::now() - m_start;
+	m_running = false;
+}
+
+void Bench::State::resume() {
+	if (m_running) return;
+	m_running = true;
+	m_start = Clock::now();
+}
+
+int main(int argc, char** argv) {
+	const Options options = parseOptions(argc, argv);
+
+	if (options.list) {
+		for (const auto& benchCase : getCases()) {
+			for (const int64_t argument : benchCase.arguments) std::println("{}", getCaseName(benchCase, argument));
+		}
+		return EXIT_SUCCESS;
+	}
+
+	nlohmann::ordered_json results = nlohmann::ordered_json::array();
+	std::println("{:<44} {:>14} {:>14} {:>14} {:>12}", "benchmark", "median ns/op", "min ns/op", "ns/item", "iterations");
+
+	for (const auto& benchCase : getCases()) {
+		for (const int64_t argument : benchCase.arguments) {
+			const std::string name = getCaseName(benchCase, argument);
+			if (!options.filter.empty() && name.find(options.filter) == std::string::npos) continue;
+
+			std::string skipReason;
+			const uint64_t iterations = calibrate(benchCase, argument, options.minTime, skipReason);
+			if (iterations == 0) {
+				std::println("{:<44} skipped: {}", name, skipReason);
+				results.push_back({ { "name", name }, { "skipped", skipReason } });
+				continue;
+			}
+
+			std::vector<double> samples;
+			uint64_t itemsPerIteration = 1;
+			for (int repetition = 0; repetition < options.repetitions; ++repetition) {
+				Bench::State state(iterations, argument);
+				benchCase.function(state);
+				samples.push_back(state.elapsedSeconds() * 1e9 / static_cast<double>(iterations));
+				itemsPerIteration = std::max<uint64_t>(state.itemsPerIteration, 1);
+			}
+			std::sort(samples.begin(), samples.end());
+			const double median = samples[samples.size() / 2];
+
+			std::println("{:<44} {:>14.1f} {:>14.1f} {:>14.2f} {:>12}", name, median, samples.front(), median / itemsPerIteration, iterations);
+			results.push_back({
+				{ "name", name },
+				{ "case", benchCase.name },
+				{ "argument", argument },
+				{ "iterations", iterations },
+				{ "repetitions", options.repetitions },
+				{ "itemsPerIteration", itemsPerIteration },
+				{ "nsPerOpMedian", median },
+				{ "nsPerOpMin", samples.front() },
+				{ "nsPerOpMax", samples.back() },
+				{ "nsPerItemMedian", median / itemsPerIteration },
+			});
+		}
+	}
+
+	const nlohmann::ordered_json document = {
+		{ "context", {
+			{ "date", getTimestamp() },
+			{ "hardwareThreads", std::thread::hardware_concurrency() },
+#ifdef NDEBUG
+			{ "buildType", "release" },
+#else
+			{ "buildType", "debug" },
+#endif
+			{ "minTime", options.minTime },
+		} },
+		{ "benchmarks", results },
+	};
+
+	std::ofstream file{ options.outputFilename, std::ios::trunc };
+	if (!file.is_open()) {
+		std::println("Cannot write {}", options.outputFilename);
+		return EXIT_FAILURE;
+	}
+	file << document.dump(2) << '\n';
+	std::println("Results written to {}", options.outputFilename);
+	return EXIT_SUCCESS;
+}
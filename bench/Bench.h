@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ * Minimal benchmark harness. A case runs its timed loop as
+ *     while (state.next()) { ... }
+ * with untimed setup either before the loop or between pause() and resume(). The runner grows
+ * the iteration count until a run takes long enough to time, then repeats it and reports the
+ * spread per iteration (and per item when the case sets itemsPerIteration).
+ */
+namespace Bench {
+	class State {
+	public:
+		State(uint64_t iterations, int64_t argument) : m_remaining(iterations), m_iterations(iterations), m_argument(argument) {}
+
+		bool next();
+		void pause();
+		void resume();
+
+		int64_t argument() const { return m_argument; }
+		uint64_t iterations() const { return m_iterations; }
+		double elapsedSeconds() const { return m_elapsed.count(); }
+
+		/* work units per iteration, e.g. nodes visited, reported as ns per item */
+		uint64_t itemsPerIteration = 1;
+		/* set when the case can't run here, the result is reported as skipped */
+		std::string skipReason;
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		uint64_t m_remaining;
+		uint64_t m_iterations;
+		int64_t m_argument;
+		bool m_started = false;
+		bool m_running = false;
+		Clock::time_point m_start;
+		std::chrono::duration<double> m_elapsed{ 0.0 };
+	};
+
+	using Function = std::function<void(State&)>;
+
+	/* one result per argument, in registration order */
+	void registerCase(std::string name, std::vector<int64_t> arguments, Function function);
+
+	struct Registrar {
+		Registrar(std::string name, std::vector<int64_t> arguments, Function function) {
+			registerCase(std::move(name), std::move(arguments), std::move(function));
+		}
+	};
+
+	/* keeps the compiler from discarding a computed value */
+	void doNotOptimize(const void* value);
+
+	template<typename T>
+	void doNotOptimize(const T& value) {
+		doNotOptimize(static_cast<const void*>(&value));
+	}
+}
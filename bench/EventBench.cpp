@@ -0,0 +1,21 @@
+#include "Bench.h"
+#include <Event/Event.h>
+#include <Event/Connection.h>
+#include <cstdint>
+#include <vector>
+
+namespace {
+	Bench::Registrar fire("Event/fire", { 0, 1, 100 }, [](Bench::State& state) {
+		Event<int> event;
+		uint64_t sum = 0;
+		std::vector<EventConnection> connections;
+		for (int64_t i = 0; i < state.argument(); ++i) {
+			connections.push_back(event.connect([&sum](int value) { sum += static_cast<uint64_t>(value); }));
+		}
+
+		while (state.next()) {
+			event.fire(1);
+		}
+		Bench::doNotOptimize(sum);
+	});
+}
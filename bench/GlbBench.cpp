@@ -0,0 +1,123 @@
+#include "Bench.h"
+#include <MeshDeserializer/GlbDeserializer.h>
+#include <MeshDeserializer/CookedMeshDeserializer.h>
+#include <MeshDeserializer/CookedMeshSerializer.h>
+#include <Util/MappedFile.h>
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+	template<typename T>
+	void append(std::vector<uint8_t>& buffer, const std::vector<T>& values) {
+		const size_t offset = buffer.size();
+		buffer.resize(offset + values.size() * sizeof(T));
+		std::memcpy(buffer.data() + offset, values.data(), values.size() * sizeof(T));
+	}
+
+	void pad(std::vector<uint8_t>& buffer, uint8_t value) {
+		while (buffer.size() % 4) buffer.push_back(value);
+	}
+
+	/* a side x side vertex grid with normals, texture coordinates and 32 bit indices */
+	std::filesystem::path writeGridGlb(int64_t vertexCount) {
+		const auto side = static_cast<uint32_t>(std::sqrt(static_cast<double>(vertexCount)));
+		const auto path = std::filesystem::temp_directory_path() / ("bench_grid_" + std::to_string(side) + ".glb");
+		if (std::filesystem::exists(path)) return path;
+
+		std::vector<float> positions, normals, textureCoords;
+		for (uint32_t z = 0; z < side; ++z) {
+			for (uint32_t x = 0; x < side; ++x) {
+				positions.insert(positions.end(), { static_cast<float>(x), 0.0f, static_cast<float>(z) });
+				normals.insert(normals.end(), { 0.0f, 1.0f, 0.0f });
+				textureCoords.insert(textureCoords.end(), { x / static_cast<float>(side), z / static_cast<float>(side) });
+			}
+		}
+		std::vector<uint32_t> indices;
+		for (uint32_t z = 0; z + 1 < side; ++z) {
+			for (uint32_t x = 0; x + 1 < side; ++x) {
+				const uint32_t i = z * side + x;
+				indices.insert(indices.end(), { i, i + side, i + 1, i + 1, i + side, i + side + 1 });
+			}
+		}
+
+		std::vector<uint8_t> bin;
+		nlohmann::json bufferViews = nlohmann::json::array();
+		auto addView = [&](const auto& values) {
+			const size_t offset = bin.size();
+			append(bin, values);
+			bufferViews.push_back({ { "buffer", 0 }, { "byteOffset", offset }, { "byteLength", bin.size() - offset } });
+		};
+		addView(positions);
+		addView(normals);
+		addView(textureCoords);
+		addView(indices);
+		pad(bin, 0);
+
+		const size_t count = static_cast<size_t>(side) * side;
+		const nlohmann::json document = {
+			{ "asset", { { "version", "2.0" } } },
+			{ "scene", 0 },
+			{ "scenes", { { { "nodes", { 0 } } } } },
+			{ "nodes", { { { "mesh", 0 } } } },
+			{ "meshes", { { { "primitives", { {
+				{ "attributes", { { "POSITION", 0 }, { "NORMAL", 1 }, { "TEXCOORD_0", 2 } } },
+				{ "indices", 3 },
+			} } } } } },
+			{ "buffers", { { { "byteLength", bin.size() } } } },
+			{ "bufferViews", bufferViews },
+			{ "accessors", {
+				{ { "bufferView", 0 }, { "componentType", 5126 }, { "count", count }, { "type", "VEC3" } },
+				{ { "bufferView", 1 }, { "componentType", 5126 }, { "count", count }, { "type", "VEC3" } },
+				{ { "bufferView", 2 }, { "componentType", 5126 }, { "count", count }, { "type", "VEC2" } },
+				{ { "bufferView", 3 }, { "componentType", 5125 }, { "count", indices.size() }, { "type", "SCALAR" } },
+			} },
+		};
+		const std::string text = document.dump();
+		std::vector<uint8_t> jsonChunk(text.begin(), text.end());
+		pad(jsonChunk, ' ');
+
+		const uint32_t totalLength = static_cast<uint32_t>(12 + 8 + jsonChunk.size() + 8 + bin.size());
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+		auto writeU32 = [&file](uint32_t value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+		file.write("glTF", 4);
+		writeU32(2);
+		writeU32(totalLength);
+		writeU32(static_cast<uint32_t>(jsonChunk.size()));
+		file.write("JSON", 4);
+		file.write(reinterpret_cast<const char*>(jsonChunk.data()), static_cast<std::streamsize>(jsonChunk.size()));
+		writeU32(static_cast<uint32_t>(bin.size()));
+		file.write("BIN\0", 4);
+		file.write(reinterpret_cast<const char*>(bin.data()), static_cast<std::streamsize>(bin.size()));
+		return path;
+	}
+
+	/* vertex counts are rounded down to a square grid: 1024, 16384, 262144, 1048576 */
+	Bench::Registrar deserialize("GlbDeserializer/deserialize", { 1'024, 16'384, 262'144, 1'048'576 }, [](Bench::State& state) {
+		const std::string filename = writeGridGlb(state.argument()).string();
+		state.itemsPerIteration = static_cast<uint64_t>(state.argument());
+		while (state.next()) {
+			auto mesh = GlbDeserializer::deserialize(filename);
+			Bench::doNotOptimize(mesh);
+		}
+	});
+
+	/* the same grids cooked, mapped and validated in place the way MeshManager loads them; the GPU upload is left out of both */
+	Bench::Registrar cookedView("CookedMesh/load", { 1'024, 16'384, 262'144, 1'048'576 }, [](Bench::State& state) {
+		const auto glb = writeGridGlb(state.argument());
+		const auto cooked = std::filesystem::path(glb).replace_extension(".emesh");
+		if (!CookedMeshDeserializer::isCurrent(cooked.string())) CookedMeshSerializer::serialize(GlbDeserializer::deserialize(glb.string()), cooked.string());
+		state.itemsPerIteration = static_cast<uint64_t>(state.argument());
+		while (state.next()) {
+			MappedFile file;
+			file.open(cooked.string());
+			auto mesh = CookedMeshDeserializer::view(file.getBytes());
+			Bench::doNotOptimize(mesh);
+		}
+	});
+}
@@ -0,0 +1,118 @@
+#include "Bench.h"
+#include <Instance/Instance.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+	const std::vector<int64_t> nodeCounts = { 1'000, 10'000, 100'000, 1'000'000 };
+	constexpr size_t fanout = 16;
+
+	/* count nodes under one root, breadth first so every parent has fanout children */
+	std::vector<InstancePtr> buildTree(size_t count) {
+		std::vector<InstancePtr> nodes;
+		nodes.reserve(count + 1);
+		nodes.push_back(std::make_shared<Instance>());
+		nodes.front()->name = "Root";
+		for (size_t i = 1; i <= count; ++i) {
+			auto node = std::make_shared<Instance>();
+			node->name = "Node" + std::to_string(i);
+			node->setParent(nodes[(i - 1) / fanout]);
+			nodes.push_back(std::move(node));
+		}
+		return nodes;
+	}
+
+	/* count children directly under one parent */
+	std::vector<InstancePtr> buildFlat(size_t count) {
+		std::vector<InstancePtr> nodes;
+		nodes.reserve(count + 1);
+		nodes.push_back(std::make_shared<Instance>());
+		for (size_t i = 1; i <= count; ++i) {
+			auto node = std::make_shared<Instance>();
+			node->name = "Node" + std::to_string(i);
+			node->setParent(nodes.front());
+			nodes.push_back(std::move(node));
+		}
+		return nodes;
+	}
+
+	/* trees the non-destructive cases share, building a million nodes is slower than most cases */
+	const std::vector<InstancePtr>& getTree(int64_t count) {
+		static std::map<int64_t, std::vector<InstancePtr>> trees;
+		auto& tree = trees[count];
+		if (tree.empty()) tree = buildTree(static_cast<size_t>(count));
+		return tree;
+	}
+
+	const std::vector<InstancePtr>& getFlat(int64_t count) {
+		static std::map<int64_t, std::vector<InstancePtr>> flats;
+		auto& flat = flats[count];
+		if (flat.empty()) flat = buildFlat(static_cast<size_t>(count));
+		return flat;
+	}
+
+	/* moves the deepest leaf to another deep parent and back, every ancestor fires descendant events */
+	Bench::Registrar setParent("Instance/setParent", nodeCounts, [](Bench::State& state) {
+		const auto& tree = getTree(state.argument());
+		const InstancePtr& leaf = tree.back();
+		const InstancePtr home = leaf->parent.lock();
+		const InstancePtr& away = tree[tree.size() / 2];
+		state.itemsPerIteration = 2;
+		while (state.next()) {
+			leaf->setParent(away);
+			leaf->setParent(home);
+		}
+	});
+
+	/* the same move out of and back into a parent holding every node, the sibling scan dominates */
+	Bench::Registrar setParentFlat("Instance/setParentFlat", nodeCounts, [](Bench::State& state) {
+		const auto& flat = getFlat(state.argument());
+		const InstancePtr& child = flat[1];
+		const InstancePtr away = std::make_shared<Instance>();
+		state.itemsPerIteration = 2;
+		while (state.next()) {
+			child->setParent(away);
+			child->setParent(flat.front());
+		}
+	});
+
+	Bench::Registrar destroy("Instance/destroy", nodeCounts, [](Bench::State& state) {
+		state.itemsPerIteration = static_cast<uint64_t>(state.argument());
+		while (state.next()) {
+			state.pause();
+			auto tree = buildTree(static_cast<size_t>(state.argument()));
+			state.resume();
+
+			tree.front()->destroy();
+
+			/* freeing the nodes isn't part of destroy() */
+			state.pause();
+			tree.clear();
+			state.resume();
+		}
+	});
+
+	Bench::Registrar getDescendants("Instance/getDescendants", nodeCounts, [](Bench::State& state) {
+		const auto& tree = getTree(state.argument());
+		state.itemsPerIteration = static_cast<uint64_t>(state.argument());
+		while (state.next()) {
+			auto descendants = tree.front()->getDescendants();
+			Bench::doNotOptimize(descendants);
+		}
+	});
+
+	/* the last child, so the whole child list is scanned */
+	Bench::Registrar findFirstChild("Instance/findFirstChild", nodeCounts, [](Bench::State& state) {
+		const auto& flat = getFlat(state.argument());
+		const std::string name = flat.back()->name;
+		state.itemsPerIteration = static_cast<uint64_t>(state.argument());
+		while (state.next()) {
+			auto child = flat.front()->findFirstChild(name);
+			Bench::doNotOptimize(child);
+		}
+	});
+}
@@ -0,0 +1,66 @@
+#include "Bench.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <Shader/Shader.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+
+/* only built with the client, it needs a GL 4.6 context from a hidden window */
+
+namespace {
+	const std::string vertexSource = R"(#version 460
+layout(location=0) in vec3 vertex;
+uniform mat4 projection;
+uniform mat4 view;
+uniform mat4 model;
+void main() {
+	gl_Position = projection * view * model * vec4(vertex, 1.0);
+}
+)";
+
+	const std::string fragmentSource = R"(#version 460
+uniform int useTexture;
+uniform vec2 uTile;
+out vec4 fragColor;
+void main() {
+	fragColor = useTexture == 1 ? vec4(uTile, 0.0, 1.0) : vec4(1.0);
+}
+)";
+
+	/* created on first use and kept for the whole run, nullptr when no context is available */
+	GLFWwindow* getContext() {
+		static GLFWwindow* window = []() -> GLFWwindow* {
+			if (!glfwInit()) return nullptr;
+			glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+			GLFWwindow* created = glfwCreateWindow(64, 64, "bench", nullptr, nullptr);
+			if (!created) return nullptr;
+			glfwMakeContextCurrent(created);
+			if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) return nullptr;
+			return created;
+		}();
+		return window;
+	}
+
+	/* the uniforms the client's render loop sets around a textured draw, looked up by name each call */
+	Bench::Registrar setUniforms("Shader/setUniforms", { 1 }, [](Bench::State& state) {
+		if (!getContext()) {
+			state.skipReason = "no OpenGL 4.6 context";
+			return;
+		}
+		static const auto shader = std::make_unique<Shader>(vertexSource, fragmentSource);
+		const glm::mat4 matrix(1.0f);
+		state.itemsPerIteration = 5;
+		while (state.next()) {
+			shader->setMat4("projection", matrix);
+			shader->setMat4("view", matrix);
+			shader->setMat4("model", matrix);
+			shader->setInt("useTexture", 1);
+			shader->setFloat2("uTile", 1.0f, 1.0f);
+		}
+		glFinish();
+	});
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <Asset/AssetArchiveFormat.h>
+#include <Util/MappedFile.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using AssetId = uint64_t;
+
+/*
+ * A memory-mapped asset archive (see AssetArchiveFormat). The resource managers look assets up here
+ * before falling back to loose files. Mount it before loading starts, lookups are read-only and safe
+ * from any thread while it stays mounted.
+ */
+class AssetArchive {
+public:
+	struct Entry {
+		AssetId id = 0;
+		uint64_t contentHash = 0;
+		AssetArchiveFormat::AssetType type = AssetArchiveFormat::AssetType::Unknown;
+		std::string_view path;
+		/* points into the map, valid until unmount() */
+		std::span<const uint8_t> bytes;
+	};
+
+	AssetArchive() = default;
+
+	AssetArchive(const AssetArchive&) = delete;
+	AssetArchive& operator=(const AssetArchive&) = delete;
+
+	/* the archive the resource managers read from */
+	static AssetArchive& getInstance();
+
+	/* the same id for "./resources/a.glb", "resources\\a.glb" and "resources/x/../a.glb" */
+	static std::string normalizePath(std::string_view path);
+	static AssetId getId(std::string_view path);
+	static AssetArchiveFormat::AssetType getType(std::string_view path);
+
+	/* false, with the reason printed, if the file is missing or not a valid archive */
+	bool mount(const std::string& filename);
+	void unmount();
+	bool isMounted() const { return m_file.isOpen(); }
+
+	std::optional<Entry> find(AssetId id) const;
+	std::optional<Entry> find(std::string_view path) const { return find(getId(path)); }
+
+	size_t getEntryCount() const { return m_toc.size(); }
+	Entry getEntry(size_t index) const;
+private:
+	MappedFile m_file;
+	std::span<const AssetArchiveFormat::TocEntry> m_toc;
+	std::span<const char> m_strings;
+};
+
+/* builds an archive in memory and writes it in one go */
+class AssetArchiveWriter {
+public:
+	/* a later add() with the same path replaces the earlier one */
+	void add(std::string path, std::vector<uint8_t> bytes);
+
+	/* returns false if the file can't be written */
+	bool write(const std::string& filename) const;
+
+	size_t getEntryCount() const { return m_assets.size(); }
+private:
+	struct Asset {
+		std::string path;
+		std::vector<uint8_t> bytes;
+	};
+
+	std::vector<Asset> m_assets;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+/*
+ * Packed asset archive layout (little-endian):
+ *   Header
+ *   data blobs, each starting on a Header::alignment boundary, identical contents stored once
+ *   TocEntry[entryCount], sorted by id
+ *   strings: the entries' paths, null-terminated, for listing and error messages
+ *
+ * An entry's id is the FNV-1a hash of its normalised relative path (AssetArchive::getId), its
+ * contentHash the FNV-1a hash of its bytes. Entries with the same contents share one blob.
+ */
+namespace AssetArchiveFormat {
+	constexpr char magic[8] = { 'E', 'L', 'P', 'A', 'C', 'K', '\0', '\0' };
+	constexpr uint32_t version = 1;
+	/* blobs are aligned so they can be handed to the GPU or cast in place straight from the map */
+	constexpr uint32_t alignment = 64;
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t entryCount;
+		uint64_t tocOffset;
+		uint64_t stringsOffset;
+		uint64_t stringsSize;
+		uint32_t alignment;
+		uint32_t reserved;
+	};
+	static_assert(sizeof(Header) == 48);
+
+	enum class AssetType : uint32_t {
+		Unknown = 0,
+		Mesh = 1,
+		Texture = 2,
+	};
+
+	struct TocEntry {
+		uint64_t id;
+		uint64_t contentHash;
+		uint64_t offset;
+		uint64_t size;
+		AssetType type;
+		/* into the strings block */
+		uint32_t pathOffset;
+	};
+	static_assert(sizeof(TocEntry) == 40);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <Event/Connection.h>
+#include <Profiling/StatsRegistry.h>
 
 #include <functional>
 #include <unordered_map>
@@ -33,6 +34,10 @@ public:
 	}
 
 	void fire(Args... args) {
+		static auto& fires = StatsRegistry::getInstance().counter("Event/Fires");
+		static auto& handlerCalls = StatsRegistry::getInstance().counter("Event/HandlerCalls");
+		fires.add();
+
 		std::vector<Handler> toCall;
 		{
 			std::lock_guard<std::mutex> lk(m_impl->mutex);
@@ -42,6 +47,7 @@ public:
 			}
 		}
 
+		handlerCalls.add(static_cast<int64_t>(toCall.size()));
 		for (auto& fn : toCall) {
 			try {
 				fn(args...);
@@ -0,0 +1,9 @@
+#pragma once
+#include <Instance/Instance.h>
+
+/* Scripts under an Actor run in the Actor's own Luau VM and may run in parallel with other Actors */
+class Actor : public Instance {
+public:
+	Actor() { name = "Actor"; };
+	~Actor() = default;
+};
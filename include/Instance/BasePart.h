@@ -5,6 +5,7 @@
 class BasePart : public Instance {
 public:
 	glm::vec3 position{ 0.0f, 0.0f, 0.0f };
+	/* euler angles in degrees, applied in Y, X, Z order */
 	glm::vec3 orientation{0.0f, 0.0f, 0.0f};
 	glm::vec3 size{ 4.0f, 1.0f, 2.0f };
 	glm::u8vec3 color{ 163, 162, 165 };
@@ -14,6 +15,21 @@ public:
 	bool canCollide = true;
 	bool anchored = true;
 
+	/* studs/s and radians/s, written back by PhysicsWorld for unanchored parts */
+	glm::vec3 velocity{ 0.0f, 0.0f, 0.0f };
+	glm::vec3 angularVelocity{ 0.0f, 0.0f, 0.0f };
+	/* defaults match Roblox's plastic */
+	float density = 0.7f;
+	float friction = 0.3f;
+	float elasticity = 0.5f;
+
 	BasePart() { name = "BasePart"; };
 	~BasePart() = default;
-};
\ No newline at end of file
+
+	static glm::mat3 orientationToMatrix(const glm::vec3& orientation);
+	glm::mat3 getRotationMatrix() const;
+	/* translation * rotation * scale(size), the transform of a unit cube mesh */
+	glm::mat4 getModelMatrix() const;
+	/* world space AABB of the rotated part */
+	void getBounds(glm::vec3& outMin, glm::vec3& outMax) const;
+};
@@ -11,8 +11,8 @@ using WeakInstancePtr = std::weak_ptr<Instance>;
 
 class Instance: public std::enable_shared_from_this<Instance> {
 public:
-	Instance() = default;
-	virtual ~Instance() {};
+	Instance();
+	virtual ~Instance();
 
 	std::string name = "Instance";
 	WeakInstancePtr parent;
@@ -20,6 +20,9 @@ public:
 	Event<> childAdded;
 	Event<> childRemoved;
 	Event<> destroyed;
+	/* fired on every ancestor, after the descendant is attached / before it is detached */
+	Event<InstancePtr> descendantAdded;
+	Event<InstancePtr> descendantRemoving;
 
 	InstancePtr findFirstChild(const std::string& name);
 	InstancePtr findFirstChildOfClass(const std::string& className);
@@ -31,6 +34,9 @@ public:
 
 	std::vector<InstancePtr> getChildren() const;
 	std::vector<InstancePtr> getDescendants() const;
+	/* descendant is this instance or one of its descendants */
+	bool isAncestorOf(const Instance* descendant) const;
+	/* throws std::runtime_error if newParent is this instance or one of its descendants */
 	void setParent(const InstancePtr& newParent);
 
 	virtual void destroy();
@@ -38,6 +44,8 @@ public:
 
 	std::string getClassName();
 private:
+	void setParentLocked(const InstancePtr& oldParent, const InstancePtr& newParent);
+
 	std::vector<InstancePtr> m_children;
 	std::mutex m_mutexChildren;
 };
\ No newline at end of file
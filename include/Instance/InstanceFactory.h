@@ -0,0 +1,35 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <functional>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+// Maps stable class names to constructors, independent of compiler typeid names.
+class InstanceFactory {
+public:
+	using Creator = std::function<InstancePtr()>;
+
+	static InstanceFactory& getInstance();
+
+	template<typename T>
+	void registerClass(const std::string& className) {
+		registerClass(className, typeid(T), []() -> InstancePtr { return std::make_shared<T>(); });
+	}
+	void registerClass(const std::string& className, const std::type_info& type, Creator creator);
+
+	InstancePtr create(const std::string& className) const;
+	bool isRegistered(const std::string& className) const;
+
+	/* returns nullptr for classes that were never registered */
+	const std::string* getClassName(const Instance& instance) const;
+private:
+	InstanceFactory();
+	~InstanceFactory() = default;
+
+	InstanceFactory(const InstanceFactory&) = delete;
+	InstanceFactory& operator=(const InstanceFactory&) = delete;
+
+	std::unordered_map<std::string, Creator> m_creators;
+	std::unordered_map<std::type_index, std::string> m_classNames;
+};
@@ -0,0 +1,12 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <string>
+
+/* Luau source run by ScriptContext when the DataModel starts */
+class Script : public Instance {
+public:
+	std::string source;
+
+	Script() { name = "Script"; };
+	~Script() = default;
+};
@@ -1,29 +1,83 @@
 #pragma once
 
 #include <Mesh/IMesh.h>
+#include <Mesh/MeshData.h>
+#include <Mesh/VertexLayout.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+/*
+ * A mesh rewritten while it's being drawn. Its buffers are persistently mapped and split into
+ * regionCount copies: writes go into a copy the GPU is done with, guarded by a fence, and draws read
+ * the newest through the base vertex and first index, so updates never reallocate or stall on the
+ * driver. A CPU copy of the data brings each region up to date with only the ranges that changed.
+ */
 class DynamicMesh3D : public IMesh {
+public:
+	static constexpr uint32_t regionCount = 3;
 private:
+	/* ranges changed since this region was last written, in vertices and indices */
+	struct Region {
+		GLsync fence = nullptr;
+		size_t vertexBegin = 0;
+		size_t vertexEnd = 0;
+		size_t indexBegin = 0;
+		size_t indexEnd = 0;
+	};
+
 	GLuint m_vao = 0;
 	GLuint m_vbo = 0;
 	GLuint m_ebo = 0;
+	uint8_t* m_mappedVertices = nullptr;
+	uint8_t* m_mappedIndices = nullptr;
+	/* per region, in vertices and in bytes */
+	size_t m_vertexCapacity = 0;
+	size_t m_indexCapacity = 0;
+	std::array<Region, regionCount> m_regions;
+	uint32_t m_region = 0;
+	/* drawn since the current region was written, the next write has to move on */
+	mutable bool m_inFlight = false;
+
+	std::vector<uint8_t> m_vertexData;
+	std::vector<uint32_t> m_indices;
 	GLsizei m_indexCount = 0;
+	GLenum m_indexType = GL_UNSIGNED_SHORT;
+	size_t m_vertexCount = 0;
+	VertexLayout m_layout;
+
+	/* moves to the next region if the current one may be read, waiting for the GPU to finish with it */
+	void beginWrite();
+	void markDirty(size_t vertexBegin, size_t vertexEnd, size_t indexBegin, size_t indexEnd);
+	/* regrows the buffers if the data outgrew them, every region is rewritten then */
+	void reserve();
+	/* copies the current region's changed ranges into it */
+	void flush();
+	void releaseBuffers();
 public:
-	struct Vertex {
-		glm::vec3 position;
-		glm::vec3 normal;
-		glm::vec3 vertexColor;
-		glm::vec2 textureCoords;
-	};
-	explicit DynamicMesh3D();
-	explicit DynamicMesh3D(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+	using Vertex = MeshVertex;
+	explicit DynamicMesh3D(const VertexLayout& layout = VertexLayout::quantized());
+	explicit DynamicMesh3D(std::span<const Vertex> vertices, std::span<const uint32_t> indices, const VertexLayout& layout = VertexLayout::quantized());
 	~DynamicMesh3D();
+
+	DynamicMesh3D(const DynamicMesh3D&) = delete;
+	DynamicMesh3D& operator=(const DynamicMesh3D&) = delete;
+
 	GLuint getVAO() const override;
 	GLsizei getIndicesCount() const override;
+	GLenum getIndexType() const override;
+	GLint getBaseVertex() const override;
+	GLuint getFirstIndex() const override;
+	void onDrawn() const override;
 
-	void updateVBO(const std::vector<Vertex>& vertices) const;
-	void updateEBO(const std::vector<unsigned int>& indices) const;
-};
\ No newline at end of file
+	/* replace everything; indices are repacked by themselves if the vertex count crosses the 16-bit limit */
+	void updateVBO(std::span<const Vertex> vertices);
+	void updateEBO(std::span<const uint32_t> indices);
+	/* overwrite from first on, extending the mesh past its end; first can't be past the end */
+	void updateVBO(size_t first, std::span<const Vertex> vertices);
+	void updateEBO(size_t first, std::span<const uint32_t> indices);
+};
@@ -1,9 +1,28 @@
 #pragma once
 #include <glad/glad.h>
+#include <Mesh/MeshData.h>
+#include <cstddef>
+#include <glm/glm.hpp>
 
 class IMesh {
 public:
 	virtual ~IMesh() = default;
 	virtual GLuint getVAO() const = 0;
+	/* of the finest level */
 	virtual GLsizei getIndicesCount() const = 0;
-};
\ No newline at end of file
+	/* GL_UNSIGNED_SHORT or GL_UNSIGNED_INT */
+	virtual GLenum getIndexType() const = 0;
+
+	/* where the mesh starts in buffers it shares with others, 0 for buffers of its own */
+	virtual GLint getBaseVertex() const { return 0; }
+	virtual GLuint getFirstIndex() const { return 0; }
+
+	/* after each draw call that reads the mesh's buffers, for meshes that rewrite them in place */
+	virtual void onDrawn() const {}
+
+	/* levels of detail in the index buffer, finest first; a single level unless the mesh has any */
+	virtual size_t getLodCount() const { return 1; }
+	virtual MeshLod getLod(size_t /* level */) const { return { 0, static_cast<uint32_t>(getIndicesCount()), 0.0f }; }
+	/* centre and radius in mesh space, for picking a level; a zero radius when unknown */
+	virtual glm::vec4 getBoundingSphere() const { return glm::vec4(0.0f); }
+};
@@ -1,26 +1,54 @@
 #pragma once
 #include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 #include <Mesh/IMesh.h>
+#include <Mesh/MeshArena.h>
+#include <Mesh/MeshData.h>
+#include <Mesh/VertexLayout.h>
+#include <MeshDeserializer/CookedMeshDeserializer.h>
 #include <glm/glm.hpp>
 
 
 
 class Mesh3D: public IMesh {
 private:
-	GLuint m_vao = 0;
-	GLuint m_vbo = 0;
-	GLuint m_ebo = 0;
+	MeshArena* m_arena = nullptr;
+	MeshArena::Handle m_handle = MeshArena::invalid;
 	GLsizei m_indexCount = 0;
+	GLenum m_indexType = GL_UNSIGNED_INT;
+	size_t m_byteSize = 0;
+	std::vector<MeshLod> m_lods;
+	glm::vec4 m_boundingSphere{ 0.0f };
+
+	void setBounds(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+	void upload(const VertexLayout& layout, std::span<const uint8_t> vertexData, std::span<const uint8_t> indexData);
 public:
-	struct Vertex {
-		glm::vec3 position;
-		glm::vec3 normal;
-		glm::vec3 vertexColor;
-		glm::vec2 textureCoords;
-	};
-	explicit Mesh3D(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+	using Vertex = MeshVertex;
+	/*
+	 * vertices are stored in layout, indices as 16 bits whenever the vertex count allows; both go into
+	 * the MeshArena for that pair rather than buffers of their own
+	 */
+	explicit Mesh3D(std::span<const Vertex> vertices, std::span<const uint32_t> indices, std::span<const MeshLod> lods, const VertexLayout& layout = VertexLayout::quantized());
+	explicit Mesh3D(std::span<const Vertex> vertices, std::span<const uint32_t> indices, const VertexLayout& layout = VertexLayout::quantized()) : Mesh3D(vertices, indices, {}, layout) {}
+	explicit Mesh3D(const MeshData& data, const VertexLayout& layout = VertexLayout::quantized()) : Mesh3D(data.vertices, data.indices, data.lods, layout) {}
+	/* from the cooked bytes, e.g. a memory-mapped .emesh, uploaded as they are in the layout they were cooked in */
+	explicit Mesh3D(const CookedMeshView& cooked);
 	~Mesh3D();
 	GLuint getVAO() const override;
 	GLsizei getIndicesCount() const override;
+	GLenum getIndexType() const override;
+	GLint getBaseVertex() const override;
+	GLuint getFirstIndex() const override;
+	size_t getLodCount() const override;
+	MeshLod getLod(size_t level) const override;
+	glm::vec4 getBoundingSphere() const override;
+
+	const MeshArena& getArena() const { return *m_arena; }
+
+	/* its share of the arena's buffers; the vertices aren't kept on the CPU after upload */
+	size_t getGpuByteSize() const { return m_byteSize; }
+	size_t getCpuByteSize() const { return sizeof(*this) + m_lods.size() * sizeof(MeshLod); }
 };
\ No newline at end of file
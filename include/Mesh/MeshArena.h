@@ -0,0 +1,89 @@
+#pragma once
+#include <glad/glad.h>
+#include <Mesh/VertexLayout.h>
+#include <Util/RangeAllocator.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/*
+ * Shared vertex and index buffers for every static mesh in one vertex layout and index type, with a
+ * single vertex array over them. Meshes are ranges of the buffers drawn with a base vertex, so any
+ * number of them go out in one glMultiDrawElementsIndirect. Ranges come from a RangeAllocator, the
+ * buffers grow by copying into larger ones and are compacted, and shrunk, by defragment() once freed
+ * holes waste enough of them. Meshes hold a handle, so a range can move without them noticing.
+ * GL thread only; arenas live until exit so meshes freed during static destruction are safe.
+ */
+class MeshArena {
+public:
+	using Handle = uint32_t;
+	static constexpr Handle invalid = ~0u;
+
+	struct Allocation {
+		/* added to every index, in vertices */
+		GLint baseVertex = 0;
+		/* in indices from the start of the index buffer */
+		GLuint firstIndex = 0;
+		GLuint vertexCount = 0;
+		GLuint indexCount = 0;
+	};
+
+	/* the arena for layout and indexType, created on first use */
+	static MeshArena& get(const VertexLayout& layout, GLenum indexType);
+	/* defragment() every arena whose fragmentation is past threshold, between frames */
+	static void defragmentAll(float threshold = 0.25f);
+
+	/* vertices already in the layout, indices already in the index type */
+	Handle allocate(std::span<const uint8_t> vertices, std::span<const uint8_t> indices);
+	void free(Handle handle);
+	/* where the handle's ranges are now; only valid until the next defragment() */
+	const Allocation& getAllocation(Handle handle) const { return m_slots[handle].allocation; }
+
+	/* the share of either buffer lost to holes besides the largest free range, 0 to 1 */
+	float getFragmentation() const;
+	/*
+	 * moves every range to the front of fresh buffers in order, closing the holes between them; the
+	 * buffers shrink to what is used plus some headroom
+	 */
+	void defragment();
+
+	GLuint getVAO() const { return m_vao; }
+	GLenum getIndexType() const { return m_indexType; }
+	const VertexLayout& getLayout() const { return m_layout; }
+	/* capacity of both buffers, allocated or not */
+	size_t getGpuByteSize() const;
+private:
+	struct Slot {
+		Allocation allocation;
+		RangeAllocator::Handle vertexRange = RangeAllocator::invalid;
+		RangeAllocator::Handle indexRange = RangeAllocator::invalid;
+		bool live = false;
+	};
+
+	MeshArena(const VertexLayout& layout, GLenum indexType);
+	~MeshArena() = default;
+
+	MeshArena(const MeshArena&) = delete;
+	MeshArena& operator=(const MeshArena&) = delete;
+
+	static std::vector<MeshArena*>& getArenas();
+
+	/* a range of count elements, growing buffer when no free range is large enough */
+	RangeAllocator::Handle claim(RangeAllocator& ranges, GLuint& buffer, size_t elementSize, size_t count);
+	/* an uninitialised buffer of capacity elements */
+	static GLuint createBuffer(size_t capacity, size_t elementSize);
+	static void upload(GLuint buffer, size_t offset, std::span<const uint8_t> bytes);
+	/* points the vertex array at the current buffers */
+	void bindBuffers();
+
+	VertexLayout m_layout;
+	GLenum m_indexType = GL_UNSIGNED_INT;
+	GLuint m_vao = 0;
+	GLuint m_vbo = 0;
+	GLuint m_ebo = 0;
+	RangeAllocator m_vertices;
+	RangeAllocator m_indices;
+	std::vector<Slot> m_slots;
+	std::vector<Handle> m_freeSlots;
+};
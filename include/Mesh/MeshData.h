@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/* CPU side mesh as decoded from disk, no GL types so decoders build without a context */
+struct MeshVertex {
+	glm::vec3 position;
+	glm::vec3 normal;
+	glm::vec3 vertexColor;
+	glm::vec2 textureCoords;
+};
+
+/* one level of detail: a range of MeshData::indices drawn over the shared vertices */
+struct MeshLod {
+	uint32_t firstIndex = 0;
+	uint32_t indexCount = 0;
+	/* how far the level strays from the full mesh, in mesh units; 0 for the full mesh */
+	float error = 0.0f;
+};
+
+struct MeshData {
+	std::vector<MeshVertex> vertices;
+	std::vector<uint32_t> indices;
+	/* finest first; empty when the whole index list is the only level */
+	std::vector<MeshLod> lods;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <Mesh/MeshData.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/*
+ * Import-time index and vertex reordering, no GL so the cooker runs it offline. optimize() runs
+ * every pass in order:
+ *   weldVertices         merge bit-identical vertices, e.g. the unshared ones of non-indexed glTF
+ *   optimizeOverdraw     Tipsify triangle order for the post-transform vertex cache, then its
+ *                        clusters sorted so outward-facing ones draw first (Sander et al. 2007)
+ *   optimizeVertexFetch  vertices in first-use order so fetches walk the buffer forwards
+ */
+class MeshOptimizer {
+public:
+	/* FIFO post-transform cache size the passes and ACMR assume, typical of current GPUs */
+	static constexpr uint32_t cacheSize = 16;
+
+	struct CacheStats {
+		/* average cache miss ratio: transformed vertices per triangle, 0.5 at best, 3 at worst */
+		float acmr = 0.0f;
+		/* average transform to vertex ratio: transformed vertices per vertex, 1 at best */
+		float atvr = 0.0f;
+	};
+
+	struct Report {
+		size_t verticesBefore = 0;
+		size_t verticesAfter = 0;
+		size_t triangleCount = 0;
+		CacheStats before;
+		CacheStats after;
+	};
+
+	static CacheStats analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount);
+
+	static Report optimize(MeshData& mesh);
+
+	static void weldVertices(MeshData& mesh);
+	/* Tipsify alone */
+	static std::vector<uint32_t> optimizeVertexCache(std::span<const uint32_t> indices, size_t vertexCount);
+	/* Tipsify, then the cluster sort unless it would raise the ACMR past threshold times Tipsify's */
+	static std::vector<uint32_t> optimizeOverdraw(std::span<const uint32_t> indices, std::span<const MeshVertex> vertices, float threshold = 1.05f);
+	/* drops vertices no index refers to */
+	static void optimizeVertexFetch(MeshData& mesh);
+private:
+	/* clusterStarts gets the first triangle of every run that began at a dead end */
+	static std::vector<uint32_t> tipsify(std::span<const uint32_t> indices, size_t vertexCount, std::vector<uint32_t>* clusterStarts);
+};
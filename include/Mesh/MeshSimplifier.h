@@ -0,0 +1,38 @@
+#pragma once
+#include <Mesh/MeshData.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/*
+ * Quadric error metric simplification (Garland & Heckbert 1997) by collapsing vertices onto their
+ * neighbours, so every level reuses the full mesh's vertex buffer and only the indices differ.
+ * Vertices on attribute seams (one position, several vertices) stay put; open borders only
+ * collapse along themselves.
+ */
+class MeshSimplifier {
+public:
+	struct LodSettings {
+		/* levels after the full mesh */
+		uint32_t maxLevels = 4;
+		/* triangles of each level relative to the one before */
+		float reduction = 0.5f;
+		size_t minTriangles = 64;
+		/* relative to the mesh's bounding radius, levels past it aren't generated */
+		float maxError = 0.05f;
+	};
+
+	/*
+	 * at most targetIndexCount indices over the same vertices, fewer collapses if they'd stray more
+	 * than maxError mesh units; error gets how far the result strays
+	 */
+	static std::vector<uint32_t> simplify(std::span<const uint32_t> indices, std::span<const MeshVertex> vertices, size_t targetIndexCount, float maxError, float* error = nullptr);
+
+	/*
+	 * appends coarser levels to mesh.indices and describes them all in mesh.lods; run it after
+	 * MeshOptimizer::optimize(), each level is cache-optimized on its own
+	 */
+	static void generateLods(MeshData& mesh, const LodSettings& settings);
+	static void generateLods(MeshData& mesh) { generateLods(mesh, LodSettings()); }
+};
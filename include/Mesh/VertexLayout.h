@@ -0,0 +1,72 @@
+#pragma once
+#include <glad/glad.h>
+#include <Mesh/MeshData.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/*
+ * How MeshVertex is stored in a vertex buffer, and in cooked meshes: a storage format per attribute, packed in location
+ * order (position 0, normal 1, vertexColor 2, textureCoords 3) with each attribute 4-byte aligned.
+ * Normalized formats read back as floats, so shaders are the same for every layout.
+ */
+class VertexLayout {
+public:
+	enum class Format : uint8_t {
+		/* 32-bit float per component */
+		Float,
+		/* 16-bit float per component */
+		Half,
+		/* signed normalized 10:10:10:2, for unit vectors */
+		Snorm10,
+		/* unsigned normalized 8 bits per component, for [0, 1] colours */
+		Unorm8,
+	};
+
+	struct Attribute {
+		GLuint location = 0;
+		Format format = Format::Float;
+		GLint size = 0;
+		GLenum type = GL_FLOAT;
+		GLboolean normalized = GL_FALSE;
+		GLuint offset = 0;
+	};
+
+	VertexLayout(Format position, Format normal, Format vertexColor, Format textureCoords);
+
+	/* 44 bytes, MeshVertex as is */
+	static const VertexLayout& full();
+	/* 24 bytes: float positions, 10:10:10:2 normals, RGBA8 colours, half float texture coordinates */
+	static const VertexLayout& quantized();
+
+	GLsizei getStride() const { return m_stride; }
+	const std::array<Attribute, 4>& getAttributes() const { return m_attributes; }
+	/* the layout is MeshVertex itself, vertices upload without packing */
+	bool isFull() const;
+	/* same formats, so the same attribute pointers and stride */
+	bool operator==(const VertexLayout& other) const;
+
+	/*
+	 * attribute formats of vao, all read from buffer binding 0; attach the vertex buffer with
+	 * glVertexArrayVertexBuffer(vao, 0, buffer, 0, getStride()). Inline so targets without GL can
+	 * still pack vertices, e.g. the mesh cooker
+	 */
+	void apply(GLuint vao) const {
+		for (const auto& attribute : m_attributes) {
+			glEnableVertexArrayAttrib(vao, attribute.location);
+			glVertexArrayAttribFormat(vao, attribute.location, attribute.size, attribute.type, attribute.normalized, attribute.offset);
+			glVertexArrayAttribBinding(vao, attribute.location, 0);
+		}
+	}
+	std::vector<uint8_t> pack(std::span<const MeshVertex> vertices) const;
+
+	/* GL_UNSIGNED_SHORT when every index fits in 16 bits, else GL_UNSIGNED_INT */
+	static GLenum getIndexType(size_t vertexCount);
+	static GLsizei getIndexSize(GLenum indexType) { return indexType == GL_UNSIGNED_SHORT ? 2 : 4; }
+	static std::vector<uint8_t> packIndices(std::span<const uint32_t> indices, GLenum indexType);
+private:
+	std::array<Attribute, 4> m_attributes;
+	GLsizei m_stride = 0;
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <glad/glad.h>
+#include <Mesh/MeshData.h>
+#include <Mesh/VertexLayout.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <glm/glm.hpp>
+
+/* a cooked mesh read in place, the spans point into the bytes it was read from */
+struct CookedMeshView {
+	/* vertexCount vertices packed in layout */
+	VertexLayout layout = VertexLayout::quantized();
+	std::span<const uint8_t> vertices;
+	size_t vertexCount = 0;
+	/* indexCount indices of indexType */
+	GLenum indexType = GL_UNSIGNED_INT;
+	std::span<const uint8_t> indices;
+	size_t indexCount = 0;
+	/* empty for a single level over all the indices */
+	std::span<const MeshLod> lods;
+	glm::vec3 boundsMin{ 0.0f };
+	glm::vec3 boundsMax{ 0.0f };
+};
+
+class CookedMeshDeserializer {
+public:
+	CookedMeshDeserializer() = default;
+	~CookedMeshDeserializer() = default;
+	/* validates the header and bounds without copying, bytes must be 16-byte aligned */
+	static CookedMeshView view(std::span<const uint8_t> bytes);
+	/* the header is this build's version, so view() won't reject it as stale */
+	static bool isCurrent(std::span<const uint8_t> bytes);
+	static bool isCurrent(const std::string& filename);
+};
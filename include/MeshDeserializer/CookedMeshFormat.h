@@ -0,0 +1,42 @@
+#pragma once
+#include <Mesh/MeshData.h>
+#include <cstdint>
+
+/*
+ * Cooked mesh layout (.emesh, little-endian), written by GameEngineMeshCooker:
+ *   Header
+ *   vertexCount vertices packed in the VertexLayout of vertexFormats, node transforms already applied, at vertexOffset
+ *   indexCount indices of indexSize bytes at indexOffset, every level of detail one after the other
+ *   MeshLod[lodCount] at lodOffset, finest first; none for a single level
+ * Vertices and indices are stored exactly as Mesh3D keeps them in its MeshArena, so loading is a
+ * bounds check and a copy into the buffer objects, no parsing or conversion.
+ */
+namespace CookedMeshFormat {
+	constexpr char magic[8] = { 'E', 'L', 'M', 'E', 'S', 'H', '\0', '\0' };
+	/* bump whenever the header or a VertexLayout format changes, old cooked files are then rejected and the .glb is used */
+	constexpr uint32_t version = 3;
+	constexpr uint32_t alignment = 16;
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		/* VertexLayout::getStride() of vertexFormats */
+		uint32_t vertexStride;
+		uint64_t vertexCount;
+		uint64_t indexCount;
+		uint64_t vertexOffset;
+		uint64_t indexOffset;
+		uint64_t lodOffset;
+		uint32_t lodCount;
+		/* VertexLayout::Format of position, normal, vertexColor and textureCoords */
+		uint8_t vertexFormats[4];
+		/* 2 or 4 */
+		uint32_t indexSize;
+		uint32_t reserved;
+		/* the AABB of the positions, for culling without touching the vertices */
+		float boundsMin[3];
+		float boundsMax[3];
+	};
+	static_assert(sizeof(Header) == 96);
+	static_assert(sizeof(MeshLod) == 12, "MeshLod must stay tightly packed to be cooked");
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <Mesh/MeshData.h>
+#include <Mesh/VertexLayout.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class CookedMeshSerializer {
+public:
+	CookedMeshSerializer() = default;
+	~CookedMeshSerializer() = default;
+	/* data in the cooked layout (see CookedMeshFormat.h), vertices packed in layout and indices as Mesh3D would pick */
+	static std::vector<uint8_t> serialize(const MeshData& data, const VertexLayout& layout = VertexLayout::quantized());
+	static void serialize(const MeshData& data, const std::string& filename, const VertexLayout& layout = VertexLayout::quantized());
+};
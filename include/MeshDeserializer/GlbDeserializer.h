@@ -1,11 +1,15 @@
 #pragma once
 #include <memory>
-#include <Mesh/Mesh3D.h>
+#include <Mesh/MeshData.h>
+#include <cstdint>
+#include <span>
 #include <string>
 
 class GlbDeserializer {
 public:
 	GlbDeserializer() = default;
 	~GlbDeserializer() = default;
-	static std::pair<std::vector<Mesh3D::Vertex>, std::vector<uint32_t>> deserialize(const std::string& filename);
+	static MeshData deserialize(const std::string& filename);
+	/* a whole .glb already in memory, e.g. an AssetArchive entry */
+	static MeshData deserialize(std::span<const uint8_t> bytes);
 };
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+#include <Spatial/Obb.h>
+#include <glm/glm.hpp>
+
+struct ContactPoint {
+	glm::vec3 position{ 0.0f };
+	/* positive while the boxes overlap, negative for speculative points within the margin */
+	float penetration = 0.0f;
+};
+
+struct ContactManifold {
+	/* a quad clipped against a rectangle keeps at most 8 vertices */
+	static constexpr int maxPoints = 8;
+
+	/* world space, pointing from the first box towards the second */
+	glm::vec3 normal{ 0.0f };
+	ContactPoint points[maxPoints];
+	int pointCount = 0;
+};
+
+/*
+ * Finds the axis of least penetration among the 15 SAT candidates, then builds the manifold
+ * by clipping the incident face against the reference face (face axes) or from the closest
+ * points of the two edges (edge axes). Boxes up to margin apart still produce (speculative)
+ * points; returns false when they are further apart than that.
+ */
+bool collideBoxes(const Obb& a, const Obb& b, float margin, ContactManifold& out);
@@ -0,0 +1,181 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <Instance/BasePart.h>
+#include <Physics/BoxCollision.h>
+#include <Spatial/Aabb.h>
+#include <Spatial/DynamicAabbTree.h>
+#include <Event/Connection.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Rigid body simulation for the BaseParts under a root instance (usually Workspace).
+ * Anchored parts are static colliders, unanchored parts are simulated as boxes and written
+ * back to position, orientation, velocity and angularVelocity after every step.
+ *
+ * Touching bodies form islands that are solved independently across the ThreadPool, with
+ * substepped soft contacts (sequential impulses, warm started from the previous step). Islands never share a dynamic body and are built in
+ * body order, so a step's result depends only on the scene and dt, never on the thread count.
+ * step() must not run concurrently with changes to the instance tree.
+ */
+class PhysicsWorld {
+public:
+	struct Settings {
+		/* studs/s², Roblox's default Workspace.Gravity */
+		glm::vec3 gravity{ 0.0f, -196.2f, 0.0f };
+		/* solver substeps per step, 8 at 60 Hz is twice Roblox's 240 Hz solver rate */
+		int substeps = 8;
+		/* stiffness of the contact springs that push overlapping parts apart (capped at a quarter
+		 * of the substep rate), and the fastest they push */
+		float contactHertz = 60.0f;
+		float contactDampingRatio = 10.0f;
+		float contactPushVelocity = 10.0f;
+		/* approach speed below which contacts don't bounce, above gravity * dt so resting parts stay put */
+		float restitutionThreshold = 10.0f;
+		/* boxes closer than this (plus their relative motion over the step) get speculative contacts */
+		float contactMargin = 0.1f;
+		float sleepLinearVelocity = 0.25f;
+		float sleepAngularVelocity = 0.05f;
+		float timeToSleep = 0.5f;
+		/* unanchored parts falling below this height are destroyed */
+		float fallenPartsDestroyHeight = -500.0f;
+		bool multithreaded = true;
+	};
+
+	struct Stats {
+		size_t bodyCount = 0;
+		size_t awakeBodyCount = 0;
+		size_t contactCount = 0;
+		size_t islandCount = 0;
+		double stepMilliseconds = 0.0;
+	};
+
+	PhysicsWorld();
+	explicit PhysicsWorld(const Settings& settings);
+	~PhysicsWorld() = default;
+
+	PhysicsWorld(const PhysicsWorld&) = delete;
+	PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+
+	/* simulates the BaseParts under root and keeps following it */
+	void attach(const InstancePtr& root);
+	void detach();
+
+	void insert(const std::shared_ptr<BasePart>& part);
+	void remove(const BasePart* part);
+
+	void step(float dt);
+
+	/* the part's model matrix blended between the last two steps (alpha 0 = previous, 1 = latest),
+	 * nullopt for parts that aren't simulated */
+	std::optional<glm::mat4> getInterpolatedModelMatrix(const BasePart* part, float alpha) const;
+
+	Settings& getSettings() { return m_settings; }
+	const Stats& getStats() const { return m_stats; }
+private:
+	struct Body {
+		std::shared_ptr<BasePart> part;
+		glm::vec3 position{ 0.0f };
+		glm::quat rotation{ 1.0f, 0.0f, 0.0f, 0.0f };
+		glm::vec3 velocity{ 0.0f };
+		glm::vec3 angularVelocity{ 0.0f };
+		glm::vec3 halfExtents{ 0.5f };
+		/* motion since the start of the last step, for contact separation between substeps and interpolation */
+		glm::vec3 deltaPosition{ 0.0f };
+		glm::quat stepRotation{ 1.0f, 0.0f, 0.0f, 0.0f };
+
+		float inverseMass = 0.0f;
+		glm::vec3 inverseInertiaLocal{ 0.0f };
+		glm::mat3 inverseInertiaWorld{ 0.0f };
+		float friction = 0.0f;
+		float elasticity = 0.0f;
+
+		Aabb bounds;
+		/* bounds swept over the step's motion and grown by the contact margin, what the tree holds */
+		Aabb sweptBounds;
+		int32_t proxyId = DynamicAabbTree::nullNode;
+		float sleepTime = 0.0f;
+		bool isStatic = true;
+		bool canCollide = false;
+		bool awake = false;
+
+		/* the part's state as last read or written, a mismatch means something else changed it */
+		glm::vec3 syncedPosition{ 0.0f };
+		glm::vec3 syncedOrientation{ 0.0f };
+		glm::vec3 syncedSize{ 0.0f };
+		glm::vec3 syncedVelocity{ 0.0f };
+		glm::vec3 syncedAngularVelocity{ 0.0f };
+		float syncedDensity = 0.0f;
+		bool syncedAnchored = true;
+		bool syncedCanCollide = false;
+	};
+
+	struct ContactConstraintPoint {
+		/* contact point in A's local space, used to match points between steps */
+		glm::vec3 localPoint{ 0.0f };
+		glm::vec3 rA{ 0.0f };
+		glm::vec3 rB{ 0.0f };
+		float penetration = 0.0f;
+		float adjustedSeparation = 0.0f;
+		/* normal speed before solving, negative when approaching */
+		float approachSpeed = 0.0f;
+		float normalImpulse = 0.0f;
+		float maxNormalImpulse = 0.0f;
+		float tangentImpulse[2] = { 0.0f, 0.0f };
+		float normalMass = 0.0f;
+		float tangentMass[2] = { 0.0f, 0.0f };
+	};
+
+	struct Contact {
+		/* bodyA < bodyB */
+		uint32_t bodyA = 0;
+		uint32_t bodyB = 0;
+		glm::vec3 normal{ 0.0f };
+		glm::vec3 tangents[2];
+		float friction = 0.0f;
+		float elasticity = 0.0f;
+		ContactConstraintPoint points[ContactManifold::maxPoints];
+		int pointCount = 0;
+
+		uint64_t getKey() const { return (static_cast<uint64_t>(bodyA) << 32) | bodyB; }
+	};
+
+	void loadBody(uint32_t index);
+	void syncFromParts();
+	void updateBroadPhase(float dt);
+	void findContacts(float dt);
+	void buildIslands();
+	void solveIsland(size_t island, float dt);
+	void writeToParts();
+	void wakeBody(uint32_t index);
+	Obb getBox(const Body& body) const;
+
+	Settings m_settings;
+	Stats m_stats;
+
+	std::vector<Body> m_bodies;
+	std::vector<uint32_t> m_freeBodies;
+	std::unordered_map<const BasePart*, uint32_t> m_lookup;
+	/* awake dynamic bodies in ascending index order, rebuilt every step */
+	std::vector<uint32_t> m_awakeBodies;
+
+	DynamicAabbTree m_tree;
+	/* sorted by key, the previous step's contacts are kept for warm starting */
+	std::vector<Contact> m_contacts;
+	std::vector<Contact> m_previousContacts;
+	std::vector<uint64_t> m_pairs;
+
+	/* islands as ranges into flat body and contact index arrays */
+	std::vector<uint32_t> m_islandBodies;
+	std::vector<uint32_t> m_islandBodyOffsets;
+	std::vector<uint32_t> m_islandContacts;
+	std::vector<uint32_t> m_islandContactOffsets;
+
+	EventConnection m_addedConnection;
+	EventConnection m_removingConnection;
+};
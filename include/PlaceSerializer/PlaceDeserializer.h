@@ -0,0 +1,43 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct PlaceRegion {
+	glm::ivec3 cell{ 0 };
+	uint32_t instanceCount = 0;
+	/* file offset and size of the region's chunk stream */
+	uint64_t offset = 0;
+	uint32_t size = 0;
+};
+
+struct PlaceDocument {
+	InstancePtr root;
+	/* place body instances by referent, used to parent streamed regions */
+	std::vector<WeakInstancePtr> referents;
+	std::vector<PlaceRegion> regions;
+	float streamingRegionSize = 0.0f;
+};
+
+struct PlaceRegionContents {
+	/* streamed subtrees paired with the base referent of their parent */
+	std::vector<std::pair<InstancePtr, int32_t>> roots;
+	uint32_t instanceCount = 0;
+};
+
+class PlaceDeserializer {
+public:
+	PlaceDeserializer() = default;
+	~PlaceDeserializer() = default;
+	/* reads the place body and the region table, regions themselves are left on disk */
+	static PlaceDocument open(const std::string& filename);
+	/* returns the root instance of the place */
+	static InstancePtr deserialize(const std::string& filename);
+	/* deserializes the place and moves the children of its root into target */
+	static PlaceDocument load(const std::string& filename, const InstancePtr& target);
+	/* builds a region's instances without parenting them, safe to call from worker threads */
+	static PlaceRegionContents deserializeRegion(const std::string& filename, const PlaceRegion& region);
+};
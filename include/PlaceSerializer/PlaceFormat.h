@@ -0,0 +1,158 @@
+#pragma once
+#include <Instance/BasePart.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+/*
+ * Binary place layout (little-endian):
+ *   Header
+ *   Chunk*  -- { char type[4]; uint32_t length; uint8_t payload[length]; }
+ *
+ *   INST  uint32 classId, string className, uint32 count, int32 referents[count]
+ *   PROP  uint32 classId, string propertyName, uint8 type, column[count]
+ *   PRNT  uint32 count, int32 children[count], int32 parents[count] (-1 = no parent)
+ *   REGN  int32 x, y, z, uint32 instanceCount, Chunk* -- a streaming region, see below
+ *   END   empty, terminates the place
+ *
+ * When Header::streamingRegionSize is non-zero, BaseParts under Workspace (with their
+ * subtrees) are stored in REGN chunks keyed by the grid cell of their position instead of
+ * in the place body. A region holds its own INST/PROP/PRNT/END stream with region-local
+ * referents; a PRNT parent below -1 refers to base place referent -(parent + 2).
+ *
+ * Property columns hold one value per instance of the class, in INST order.
+ * Vector3 and Color3uint8 columns are split per component (all X, then all Y, ...).
+ * Readers skip chunk types they do not know.
+ */
+namespace PlaceFormat {
+	constexpr char magic[8] = { 'E', 'L', 'P', 'L', 'A', 'C', 'E', '\0' };
+	constexpr uint32_t version = 1;
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t classCount;
+		uint32_t instanceCount;
+		float streamingRegionSize;
+	};
+	static_assert(sizeof(Header) == 24);
+
+	struct ChunkHeader {
+		char type[4];
+		uint32_t length;
+	};
+	static_assert(sizeof(ChunkHeader) == 8);
+
+	constexpr char chunkInstances[4] = { 'I', 'N', 'S', 'T' };
+	constexpr char chunkProperty[4] = { 'P', 'R', 'O', 'P' };
+	constexpr char chunkParents[4] = { 'P', 'R', 'N', 'T' };
+	constexpr char chunkRegion[4] = { 'R', 'E', 'G', 'N' };
+	constexpr char chunkEnd[4] = { 'E', 'N', 'D', '\0' };
+
+	struct RegionHeader {
+		int32_t x, y, z;
+		uint32_t instanceCount;
+	};
+	static_assert(sizeof(RegionHeader) == 16);
+
+	constexpr int32_t encodeBaseReferent(int32_t referent) { return -(referent + 2); }
+	constexpr int32_t decodeBaseReferent(int32_t parent) { return -parent - 2; }
+
+	enum class PropertyType : uint8_t {
+		String = 1,
+		Bool = 2,
+		Float = 3,
+		Vector3 = 4,
+		Color3uint8 = 5,
+	};
+
+	/* BasePart columns, written for every class deriving from BasePart */
+	using BasePartMember = std::variant<bool BasePart::*, float BasePart::*, glm::vec3 BasePart::*, glm::u8vec3 BasePart::*>;
+
+	struct BasePartProperty {
+		const char* name;
+		BasePartMember member;
+	};
+
+	inline const BasePartProperty basePartProperties[] = {
+		{ "Position", &BasePart::position },
+		{ "Orientation", &BasePart::orientation },
+		{ "Size", &BasePart::size },
+		{ "Color", &BasePart::color },
+		{ "Transparency", &BasePart::transparency },
+		{ "CastShadow", &BasePart::castShadow },
+		{ "CanCollide", &BasePart::canCollide },
+		{ "Anchored", &BasePart::anchored },
+		{ "Velocity", &BasePart::velocity },
+		{ "AngularVelocity", &BasePart::angularVelocity },
+		{ "Density", &BasePart::density },
+		{ "Friction", &BasePart::friction },
+		{ "Elasticity", &BasePart::elasticity },
+	};
+
+	template<typename T> constexpr PropertyType propertyTypeOf();
+	template<> constexpr PropertyType propertyTypeOf<bool>() { return PropertyType::Bool; }
+	template<> constexpr PropertyType propertyTypeOf<float>() { return PropertyType::Float; }
+	template<> constexpr PropertyType propertyTypeOf<glm::vec3>() { return PropertyType::Vector3; }
+	template<> constexpr PropertyType propertyTypeOf<glm::u8vec3>() { return PropertyType::Color3uint8; }
+
+	class ByteWriter {
+	public:
+		std::vector<uint8_t> buffer;
+
+		template<typename T>
+		void write(const T& value) {
+			const auto offset = buffer.size();
+			buffer.resize(offset + sizeof(T));
+			std::memcpy(buffer.data() + offset, &value, sizeof(T));
+		}
+		void writeBytes(const void* data, size_t size) {
+			const auto offset = buffer.size();
+			buffer.resize(offset + size);
+			if (size) std::memcpy(buffer.data() + offset, data, size);
+		}
+		void writeString(const std::string& value) {
+			write(static_cast<uint32_t>(value.size()));
+			writeBytes(value.data(), value.size());
+		}
+	};
+
+	class ByteReader {
+	public:
+		ByteReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+		template<typename T>
+		T read() {
+			T value;
+			readBytes(&value, sizeof(T));
+			return value;
+		}
+		void readBytes(void* out, size_t size) {
+			if (size > m_size - m_offset) throw std::runtime_error("Place chunk is truncated");
+			if (size) std::memcpy(out, m_data + m_offset, size);
+			m_offset += size;
+		}
+		std::string readString() {
+			const auto length = read<uint32_t>();
+			if (length > m_size - m_offset) throw std::runtime_error("Place chunk is truncated");
+			std::string value(reinterpret_cast<const char*>(m_data + m_offset), length);
+			m_offset += length;
+			return value;
+		}
+		/* pointer to the next `size` bytes, for column loops that read in place */
+		const uint8_t* take(size_t size) {
+			if (size > m_size - m_offset) throw std::runtime_error("Place chunk is truncated");
+			const uint8_t* ptr = m_data + m_offset;
+			m_offset += size;
+			return ptr;
+		}
+	private:
+		const uint8_t* m_data;
+		size_t m_size;
+		size_t m_offset = 0;
+	};
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <string>
+
+class PlaceSerializer {
+public:
+	PlaceSerializer() = default;
+	~PlaceSerializer() = default;
+	/*
+	 * writes root and all of its descendants; a non-zero streamingRegionSize moves the
+	 * BaseParts under Workspace into streaming regions of that size (see PlaceFormat.h)
+	 */
+	static void serialize(const InstancePtr& root, const std::string& filename, float streamingRegionSize = 0.0f);
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <glad/glad.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * GL_TIME_ELAPSED queries around render passes. Results are read frameLatency frames later, when the
+ * GPU is done with them, and handed to Profiler::addGpuZone() for the frame that issued them. Only one
+ * elapsed-time query can be active at once, so passes don't nest: a pass begun inside another is ignored.
+ */
+class GpuProfiler {
+public:
+	static constexpr size_t frameLatency = 4;
+	static constexpr size_t maxPassesPerFrame = 32;
+
+	/* needs a current GL context */
+	GpuProfiler();
+	~GpuProfiler();
+
+	GpuProfiler(const GpuProfiler&) = delete;
+	GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+	/* collects the oldest frame's results, call after Profiler::beginFrame() */
+	void beginFrame();
+
+	/* name must outlive the profiler (a string literal), false when the pass isn't timed */
+	bool beginPass(const char* name);
+	void endPass();
+private:
+	struct FrameQueries {
+		uint64_t frameIndex = 0;
+		size_t passCount = 0;
+		std::array<GLuint, maxPassesPerFrame> queries{};
+		std::array<const char*, maxPassesPerFrame> names{};
+	};
+
+	void collect(FrameQueries& frame);
+
+	std::array<FrameQueries, frameLatency> m_frames;
+	size_t m_current = 0;
+	bool m_passActive = false;
+};
+
+class GpuZone {
+public:
+	GpuZone(GpuProfiler& profiler, const char* name) : m_profiler(profiler), m_active(profiler.beginPass(name)) {}
+	~GpuZone() { if (m_active) m_profiler.endPass(); }
+
+	GpuZone(const GpuZone&) = delete;
+	GpuZone& operator=(const GpuZone&) = delete;
+private:
+	GpuProfiler& m_profiler;
+	bool m_active;
+};
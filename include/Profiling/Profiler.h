@@ -0,0 +1,125 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Frame profiler. PROFILE_ZONE("Name") times the rest of the enclosing scope on whichever thread runs
+ * it; every thread records into its own ring buffer without locking, and endFrame() on the main thread
+ * drains the rings into the frame history. Zone names must outlive the profiler (string literals).
+ * GPU pass timings arrive frames later through addGpuZone(), see GpuProfiler.
+ */
+class Profiler {
+public:
+	struct Zone {
+		const char* name = nullptr;
+		uint64_t startNanoseconds = 0;
+		uint64_t endNanoseconds = 0;
+		uint32_t threadIndex = 0;
+		/* 0 for a zone with no enclosing zone on its thread */
+		uint32_t depth = 0;
+	};
+
+	struct GpuZone {
+		const char* name = nullptr;
+		uint64_t nanoseconds = 0;
+	};
+
+	struct Frame {
+		uint64_t index = 0;
+		uint64_t startNanoseconds = 0;
+		uint64_t endNanoseconds = 0;
+		std::vector<Zone> zones;
+		/* in submission order, GL_TIME_ELAPSED only measures durations */
+		std::vector<GpuZone> gpuZones;
+	};
+
+	/* zones a thread can record between two endFrame() calls before the rest are dropped */
+	static constexpr size_t threadCapacity = 16384;
+	static constexpr size_t historySize = 300;
+
+	static Profiler& getInstance();
+
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	/* nanoseconds since the profiler was created */
+	static uint64_t now();
+
+	void beginFrame();
+	void endFrame();
+	uint64_t getFrameIndex() const { return m_frameIndex; }
+
+	/* called by ProfileZone, from any thread */
+	void record(const char* name, uint64_t startNanoseconds, uint64_t endNanoseconds, uint32_t depth);
+	/* names the calling thread's track */
+	void setThreadName(std::string name);
+	void addGpuZone(uint64_t frameIndex, const char* name, uint64_t nanoseconds);
+
+	bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+	void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+	/* keeps recording but stops adding frames, so the history can be inspected */
+	bool isPaused() const { return m_paused; }
+	void setPaused(bool paused) { m_paused = paused; }
+
+	/* main thread only, oldest first */
+	const std::deque<Frame>& getFrames() const { return m_frames; }
+	std::vector<std::string> getThreadNames() const;
+	uint64_t getDroppedZoneCount() const;
+
+	/* the frame history as Chrome trace JSON (chrome://tracing, Perfetto), false if it can't be written */
+	bool exportChromeTrace(const std::string& filename) const;
+private:
+	struct ThreadBuffer {
+		std::string name;
+		uint32_t index = 0;
+		std::unique_ptr<Zone[]> zones;
+		/* written by the owning thread */
+		std::atomic<uint64_t> writeIndex{ 0 };
+		/* written by the thread calling endFrame() */
+		std::atomic<uint64_t> readIndex{ 0 };
+		std::atomic<uint64_t> droppedCount{ 0 };
+	};
+
+	Profiler() = default;
+
+	ThreadBuffer& getThreadBuffer();
+
+	std::atomic<bool> m_enabled{ true };
+	bool m_paused = false;
+
+	mutable std::mutex m_threadsMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+
+	uint64_t m_frameIndex = 0;
+	uint64_t m_frameStart = 0;
+	std::deque<Frame> m_frames;
+};
+
+class ProfileZone {
+public:
+	explicit ProfileZone(const char* name);
+	~ProfileZone();
+
+	ProfileZone(const ProfileZone&) = delete;
+	ProfileZone& operator=(const ProfileZone&) = delete;
+private:
+	const char* m_name;
+	uint64_t m_start = 0;
+	uint32_t m_depth = 0;
+	bool m_active = false;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef ENGINE_PROFILER
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__){ name }
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
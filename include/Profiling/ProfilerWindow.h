@@ -0,0 +1,21 @@
+#pragma once
+#include <Profiling/Profiler.h>
+#include <cstdint>
+#include <string>
+
+/* ImGui view of the Profiler: frame time graph, per-thread flame timeline of one frame, heaviest zones */
+class ProfilerWindow {
+public:
+	explicit ProfilerWindow(Profiler& profiler = Profiler::getInstance());
+
+	/* inside an ImGui frame */
+	void draw();
+private:
+	void drawTimeline(const Profiler::Frame& frame);
+	void drawHeaviestZones(const Profiler::Frame& frame);
+
+	Profiler& m_profiler;
+	/* frame index being inspected, follows the newest frame while not paused */
+	uint64_t m_selectedFrame = 0;
+	std::string m_exportStatus;
+};
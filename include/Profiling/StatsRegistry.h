@@ -0,0 +1,123 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Named engine counters, gauges and histograms. Look a stat up once and keep the reference, updating
+ * it is a relaxed atomic and safe from any thread:
+ *   static auto& drawCalls = StatsRegistry::getInstance().counter("Render/DrawCalls");
+ *   drawCalls.add();
+ * Counters are per frame, endFrame() moves what was counted into getLastFrame() and the total.
+ */
+class StatsRegistry {
+public:
+	class Counter {
+	public:
+		void add(int64_t amount = 1) { m_current.fetch_add(amount, std::memory_order_relaxed); }
+		int64_t getLastFrame() const { return m_lastFrame.load(std::memory_order_relaxed); }
+		int64_t getTotal() const { return m_total.load(std::memory_order_relaxed); }
+	private:
+		friend class StatsRegistry;
+		std::atomic<int64_t> m_current{ 0 };
+		std::atomic<int64_t> m_lastFrame{ 0 };
+		std::atomic<int64_t> m_total{ 0 };
+	};
+
+	/* a level that persists across frames: live objects, allocated bytes */
+	class Gauge {
+	public:
+		void set(int64_t value);
+		void add(int64_t amount);
+		void sub(int64_t amount) { add(-amount); }
+		int64_t get() const { return m_value.load(std::memory_order_relaxed); }
+		int64_t getPeak() const { return m_peak.load(std::memory_order_relaxed); }
+	private:
+		void raisePeak(int64_t value);
+
+		std::atomic<int64_t> m_value{ 0 };
+		std::atomic<int64_t> m_peak{ 0 };
+	};
+
+	/* fixed buckets, percentiles are reported as the upper bound of the bucket they fall in */
+	class Histogram {
+	public:
+		explicit Histogram(std::vector<double> upperBounds);
+
+		void record(double value);
+
+		uint64_t getCount() const { return m_count.load(std::memory_order_relaxed); }
+		double getMean() const;
+		double getMax() const { return m_max.load(std::memory_order_relaxed); }
+		double getPercentile(double fraction) const;
+	private:
+		std::vector<double> m_upperBounds;
+		/* one per bound plus one for values past the last bound */
+		std::unique_ptr<std::atomic<uint64_t>[]> m_buckets;
+		std::atomic<uint64_t> m_count{ 0 };
+		std::atomic<double> m_sum{ 0.0 };
+		std::atomic<double> m_max{ 0.0 };
+	};
+
+	struct Snapshot {
+		struct CounterValue {
+			std::string name;
+			int64_t lastFrame = 0;
+			int64_t total = 0;
+		};
+		struct GaugeValue {
+			std::string name;
+			int64_t value = 0;
+			int64_t peak = 0;
+		};
+		struct HistogramValue {
+			std::string name;
+			uint64_t count = 0;
+			double mean = 0.0;
+			double p50 = 0.0;
+			double p95 = 0.0;
+			double p99 = 0.0;
+			double max = 0.0;
+		};
+
+		uint64_t frameCount = 0;
+		std::vector<CounterValue> counters;
+		std::vector<GaugeValue> gauges;
+		std::vector<HistogramValue> histograms;
+	};
+
+	static StatsRegistry& getInstance();
+
+	StatsRegistry(const StatsRegistry&) = delete;
+	StatsRegistry& operator=(const StatsRegistry&) = delete;
+
+	/* bounds that double from first, for millisecond and size distributions */
+	static std::vector<double> exponentialBounds(double first, double factor, size_t count);
+
+	/* the same name always returns the same stat, references stay valid for the whole run */
+	Counter& counter(const std::string& name);
+	Gauge& gauge(const std::string& name);
+	/* upperBounds only apply when the histogram is created */
+	Histogram& histogram(const std::string& name, std::vector<double> upperBounds = exponentialBounds(0.125, 2.0, 16));
+
+	/* once per frame or tick, from the thread that owns the loop */
+	void endFrame();
+
+	/* sorted by name */
+	Snapshot snapshot() const;
+	/* the snapshot as JSON, false if it can't be written */
+	bool writeJson(const std::string& filename) const;
+private:
+	StatsRegistry() = default;
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::unique_ptr<Counter>> m_counters;
+	std::map<std::string, std::unique_ptr<Gauge>> m_gauges;
+	std::map<std::string, std::unique_ptr<Histogram>> m_histograms;
+	std::atomic<uint64_t> m_frameCount{ 0 };
+};
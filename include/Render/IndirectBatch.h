@@ -0,0 +1,72 @@
+#pragma once
+#include <glad/glad.h>
+#include <Mesh/Mesh3D.h>
+#include <Texture/ITexture.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+/*
+ * Draws collected over a frame, submitted as one glMultiDrawElementsIndirect per MeshArena and
+ * texture set. Repeats of a mesh and level become instances of one command. Model matrices go to a
+ * shader storage buffer at instanceBinding; a vertex shader reads its own as
+ *   layout(std430, binding = 0) readonly buffer Instances { mat4 models[]; };
+ *   mat4 model = models[gl_BaseInstance + gl_InstanceID];
+ */
+class IndirectBatch {
+public:
+	using Textures = std::vector<std::shared_ptr<ITexture>>;
+
+	/* the DrawElementsIndirectCommand layout glMultiDrawElementsIndirect reads */
+	struct Command {
+		GLuint count = 0;
+		GLuint instanceCount = 0;
+		GLuint firstIndex = 0;
+		GLint baseVertex = 0;
+		GLuint baseInstance = 0;
+	};
+	static_assert(sizeof(Command) == 20);
+
+	static constexpr GLuint instanceBinding = 0;
+
+	IndirectBatch();
+	~IndirectBatch();
+
+	IndirectBatch(const IndirectBatch&) = delete;
+	IndirectBatch& operator=(const IndirectBatch&) = delete;
+
+	/* the mesh must outlive the next draw() */
+	void add(const Mesh3D& mesh, size_t lod, const glm::mat4& model, const Textures& textures = {});
+	void clear();
+	size_t size() const { return m_items.size(); }
+
+	/*
+	 * bindTextures runs before each texture set's draws, for the caller's texture uniforms; without it
+	 * the textures are bound to units from 0 as MeshRenderer::draw() does
+	 */
+	void draw(const std::function<void(const Textures&)>& bindTextures = nullptr);
+private:
+	struct Item {
+		const Mesh3D* mesh = nullptr;
+		uint32_t lod = 0;
+		uint32_t textureSet = 0;
+		glm::mat4 model{ 1.0f };
+	};
+
+	/* replaces buffer with a larger one if bytes don't fit, then fills it */
+	static void upload(GLuint& buffer, size_t& capacity, const void* data, size_t bytes);
+
+	std::vector<Item> m_items;
+	std::vector<Textures> m_textureSets;
+
+	/* kept between frames so they're only reallocated when a frame needs more */
+	std::vector<Command> m_commands;
+	std::vector<glm::mat4> m_models;
+	GLuint m_commandBuffer = 0;
+	GLuint m_instanceBuffer = 0;
+	size_t m_commandCapacity = 0;
+	size_t m_instanceCapacity = 0;
+};
@@ -1,13 +1,28 @@
 #pragma once
 #include <glad/glad.h>
+#include <Camera/Camera3D.h>
 #include <Mesh/IMesh.h>
 #include <Texture/ITexture.h>
+#include <cstddef>
 #include <memory>
 #include <vector>
+#include <glm/glm.hpp>
 
 class MeshRenderer {
 public:
 	static void draw(const IMesh& mesh);
 	static void draw(const IMesh& mesh, const std::vector<std::shared_ptr<ITexture>>& textures);
+	/* one level of detail, see selectLod() */
+	static void draw(const IMesh& mesh, size_t lod);
+	static void draw(const IMesh& mesh, const std::vector<std::shared_ptr<ITexture>>& textures, size_t lod);
 	//static void draw(const std::unique_ptr<IMesh>& mesh, const std::unique_ptr<Shader>& shader);
-};
\ No newline at end of file
+
+	/* textures to units from 0 in one glBindTextures call */
+	static void bindTextures(const std::vector<std::shared_ptr<ITexture>>& textures);
+
+	/*
+	 * the coarsest level whose error, projected at the mesh's nearest point to the camera, stays
+	 * within pixelError pixels of a viewport viewportHeight pixels tall
+	 */
+	static size_t selectLod(const IMesh& mesh, const glm::mat4& model, const Camera3D& camera, float viewportHeight, float pixelError = 1.0f);
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Mesh/Mesh3D.h>
+#include <ResourceManager/ResourceCache.h>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -9,15 +10,27 @@
 class MeshManager {
 public:
 	static MeshManager& getInstance();
-	/* SUPPORTED ONLY GLB */
+	/*
+	 * SUPPORTED ONLY GLB; a cooked .emesh next to it (or packed in the archive) is loaded instead when
+	 * present and not older than the .glb. Safe to call from several threads, but the first load
+	 * creates GL objects
+	 */
 	std::shared_ptr<Mesh3D> loadMeshFromFile(const std::string& filename);
 	uint32_t count();
+
+	/* where GameEngineMeshCooker writes the cooked form of filename */
+	static std::string getCookedFilename(const std::string& filename);
+
+	ResourceCache<Mesh3D>& getCache() { return m_cache; }
+	const ResourceCache<Mesh3D>& getCache() const { return m_cache; }
 private:
+	static bool isCookedFileCurrent(const std::string& filename, const std::string& cookedFilename);
+
 	MeshManager() = default;
 	~MeshManager() = default;
 
 	MeshManager(const MeshManager&) = delete;
 	MeshManager& operator=(const MeshManager&) = delete;
 
-	std::unordered_map<std::string, std::shared_ptr<Mesh3D>> m_meshes;
+	ResourceCache<Mesh3D> m_cache;
 };
\ No newline at end of file
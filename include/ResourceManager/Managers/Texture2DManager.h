@@ -1,5 +1,6 @@
 #pragma once
 #include <Texture/Texture2D.h>
+#include <ResourceManager/ResourceCache.h>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -8,8 +9,12 @@
 class Texture2DManager {
 public:
 	static Texture2DManager& getInstance();
+	/* safe to call from several threads, but the first load creates GL objects */
 	std::shared_ptr<Texture2D> loadTextureFromFile(const std::string& filename);
 	uint32_t count();
+
+	ResourceCache<Texture2D>& getCache() { return m_cache; }
+	const ResourceCache<Texture2D>& getCache() const { return m_cache; }
 private:
 	Texture2DManager() = default;
 	~Texture2DManager() = default;
@@ -17,5 +22,5 @@ private:
 	Texture2DManager(const Texture2DManager&) = delete;
 	Texture2DManager& operator=(const Texture2DManager&) = delete;
 
-	std::unordered_map<std::string, std::shared_ptr<Texture2D>> m_textures;
+	ResourceCache<Texture2D> m_cache;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <Texture/TextureCubeMap.h>
+#include <ResourceManager/ResourceCache.h>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -8,7 +9,8 @@
 class TextureCubeMapManager {
 public:
 	static TextureCubeMapManager& getInstance();
-	std::shared_ptr<TextureCubeMap> loadTexturesFromFile(const std::string& name,
+	/* safe to call from several threads, but the first load creates GL objects */
+	std::shared_ptr<TextureCubeMap> loadTexturesFromFile(
 		const std::string& frontFilename,
 		const std::string& backFilename,
 		const std::string& leftFilename,
@@ -17,6 +19,9 @@ public:
 		const std::string& bottomFilename
 	);
 	uint32_t count();
+
+	ResourceCache<TextureCubeMap>& getCache() { return m_cache; }
+	const ResourceCache<TextureCubeMap>& getCache() const { return m_cache; }
 private:
 	TextureCubeMapManager() = default;
 	~TextureCubeMapManager() = default;
@@ -24,5 +29,5 @@ private:
 	TextureCubeMapManager(const TextureCubeMapManager&) = delete;
 	TextureCubeMapManager& operator=(const TextureCubeMapManager&) = delete;
 
-	std::unordered_map<std::string, std::shared_ptr<TextureCubeMap>> m_cubeMaps;
+	ResourceCache<TextureCubeMap> m_cache;
 };
\ No newline at end of file
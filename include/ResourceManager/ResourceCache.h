@@ -0,0 +1,235 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/* one clock for every cache, so entries of different resource types can be ordered by last use */
+struct ResourceUseClock {
+	static uint64_t next() {
+		static std::atomic<uint64_t> clock{ 0 };
+		return clock.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+};
+
+/*
+ * The resources a manager has loaded, keyed by makeKey(), with the bytes each one holds and when it was
+ * last handed out. T reports its size through getGpuByteSize() and getCpuByteSize().
+ *
+ * Safe to use from any thread. Lookups read an immutable snapshot of the table without taking the
+ * lock; inserts and evictions copy the table under the lock and publish the copy, which is cheap at
+ * the few thousand entries a place loads. Concurrent getOrLoad() calls for a key that is still
+ * loading wait for that one load instead of starting their own. An entry is only evictable while the
+ * cache holds the sole reference to it: lookups pin the entry while they copy the reference, and
+ * evict() backs off from pinned entries, so a lookup on an old snapshot can't revive an evicted
+ * resource. Evicted resources are destroyed on the thread calling evict().
+ */
+template<typename T>
+class ResourceCache {
+public:
+	using Loader = std::function<std::shared_ptr<T>()>;
+
+	struct Candidate {
+		std::string key;
+		uint64_t lastUsed = 0;
+		size_t gpuBytes = 0;
+		size_t cpuBytes = 0;
+	};
+
+	ResourceCache() : m_table(std::make_shared<const Table>()) {}
+
+	ResourceCache(const ResourceCache&) = delete;
+	ResourceCache& operator=(const ResourceCache&) = delete;
+
+	/* the absolute, normalised path plus whatever load parameters change the result */
+	static std::string makeKey(const std::string& path, std::string_view parameters = {}) {
+		std::error_code error;
+		auto canonical = std::filesystem::weakly_canonical(std::filesystem::absolute(path, error), error);
+		std::string key = error ? std::filesystem::path(path).lexically_normal().generic_string() : canonical.generic_string();
+		if (!parameters.empty()) {
+			key += '|';
+			key += parameters;
+		}
+		return key;
+	}
+
+	/* for archived assets: the same bytes are one resource whichever path they were packed under */
+	static std::string makeContentKey(uint64_t contentHash, std::string_view parameters = {}) {
+		char hex[16];
+		const auto end = std::to_chars(hex, hex + sizeof(hex), contentHash, 16).ptr;
+		std::string key = "asset:";
+		key.append(hex, end);
+		if (!parameters.empty()) {
+			key += '|';
+			key += parameters;
+		}
+		return key;
+	}
+
+	/* nullptr when not loaded, counts as a use */
+	std::shared_ptr<T> find(const std::string& key) const {
+		bool evicting = false;
+		if (auto resource = lookup(key, evicting); resource || !evicting) return resource;
+		/* an eviction is deciding on the entry, it holds the lock until it has */
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return lookup(key, evicting);
+	}
+
+	/* returns the cached resource, or runs load once however many threads ask for the key meanwhile */
+	std::shared_ptr<T> getOrLoad(const std::string& key, const Loader& load) {
+		if (auto cached = find(key)) return cached;
+
+		std::promise<std::shared_ptr<T>> promise;
+		{
+			std::unique_lock<std::mutex> lk(m_mutex);
+			bool evicting = false;
+			if (auto cached = lookup(key, evicting)) return cached;
+			auto pending = m_pending.find(key);
+			if (pending != m_pending.end()) {
+				auto future = pending->second;
+				lk.unlock();
+				return future.get();
+			}
+			m_pending.emplace(key, promise.get_future().share());
+		}
+
+		std::shared_ptr<T> resource;
+		try {
+			resource = load();
+		}
+		catch (...) {
+			{
+				std::lock_guard<std::mutex> lk(m_mutex);
+				m_pending.erase(key);
+			}
+			promise.set_exception(std::current_exception());
+			throw;
+		}
+
+		{
+			std::lock_guard<std::mutex> lk(m_mutex);
+			publish(key, resource);
+			m_pending.erase(key);
+		}
+		promise.set_value(resource);
+		return resource;
+	}
+
+	std::shared_ptr<T> insert(const std::string& key, std::shared_ptr<T> resource) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		publish(key, resource);
+		return resource;
+	}
+
+	/* drops the entry only if nothing outside the cache references it, returns whether it did */
+	bool evict(const std::string& key) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		const auto table = m_table.load(std::memory_order_relaxed);
+		auto it = table->find(key);
+		if (it == table->end()) return false;
+
+		/* sequentially consistent with lookup(): either it sees the flag or this sees its pin */
+		Entry& entry = *it->second;
+		entry.evicting.store(true);
+		if (entry.pins.load() != 0 || entry.resource.use_count() != 1) {
+			entry.evicting.store(false);
+			return false;
+		}
+		/* old snapshots still hold the entry, the resource itself goes here */
+		const auto evicted = std::move(entry.resource);
+
+		auto updated = std::make_shared<Table>(*table);
+		updated->erase(key);
+		m_gpuBytes.fetch_sub(it->second->gpuBytes, std::memory_order_relaxed);
+		m_cpuBytes.fetch_sub(it->second->cpuBytes, std::memory_order_relaxed);
+		m_table.store(std::move(updated), std::memory_order_release);
+		return true;
+	}
+
+	/* unreferenced entries, least recently used first */
+	std::vector<Candidate> getEvictionCandidates() const {
+		const auto table = m_table.load(std::memory_order_acquire);
+		std::vector<Candidate> candidates;
+		for (const auto& [key, entry] : *table) {
+			/* a hint, evict() checks again */
+			if (!entry->evicting.load(std::memory_order_relaxed) && entry->resource.use_count() == 1) {
+				candidates.push_back({ key, entry->lastUsed.load(std::memory_order_relaxed), entry->gpuBytes, entry->cpuBytes });
+			}
+		}
+		std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.lastUsed < b.lastUsed; });
+		return candidates;
+	}
+
+	size_t size() const { return m_table.load(std::memory_order_acquire)->size(); }
+	size_t getGpuBytes() const { return m_gpuBytes.load(std::memory_order_relaxed); }
+	size_t getCpuBytes() const { return m_cpuBytes.load(std::memory_order_relaxed); }
+private:
+	struct Entry {
+		std::shared_ptr<T> resource;
+		std::atomic<uint64_t> lastUsed{ 0 };
+		/* lookups copying resource right now, and whether evict() is deciding on or has taken it */
+		std::atomic<uint32_t> pins{ 0 };
+		std::atomic<bool> evicting{ false };
+		size_t gpuBytes = 0;
+		size_t cpuBytes = 0;
+	};
+	/* entries are shared between table versions so a use recorded in an old snapshot isn't lost */
+	using Table = std::unordered_map<std::string, std::shared_ptr<Entry>>;
+
+	/* the resource, or nullptr with evicting set when an eviction got to the entry first */
+	std::shared_ptr<T> lookup(const std::string& key, bool& evicting) const {
+		const auto table = m_table.load(std::memory_order_acquire);
+		auto it = table->find(key);
+		evicting = false;
+		if (it == table->end()) return nullptr;
+
+		Entry& entry = *it->second;
+		std::shared_ptr<T> resource;
+		entry.pins.fetch_add(1);
+		evicting = entry.evicting.load();
+		if (!evicting) {
+			resource = entry.resource;
+			entry.lastUsed.store(ResourceUseClock::next(), std::memory_order_relaxed);
+		}
+		entry.pins.fetch_sub(1);
+		return resource;
+	}
+
+	/* with m_mutex held */
+	void publish(const std::string& key, const std::shared_ptr<T>& resource) {
+		auto entry = std::make_shared<Entry>();
+		entry->resource = resource;
+		entry->lastUsed.store(ResourceUseClock::next(), std::memory_order_relaxed);
+		entry->gpuBytes = resource->getGpuByteSize();
+		entry->cpuBytes = resource->getCpuByteSize();
+
+		auto updated = std::make_shared<Table>(*m_table.load(std::memory_order_relaxed));
+		auto& slot = (*updated)[key];
+		if (slot) {
+			m_gpuBytes.fetch_sub(slot->gpuBytes, std::memory_order_relaxed);
+			m_cpuBytes.fetch_sub(slot->cpuBytes, std::memory_order_relaxed);
+		}
+		slot = std::move(entry);
+		m_gpuBytes.fetch_add(slot->gpuBytes, std::memory_order_relaxed);
+		m_cpuBytes.fetch_add(slot->cpuBytes, std::memory_order_relaxed);
+		m_table.store(std::move(updated), std::memory_order_release);
+	}
+
+	std::atomic<std::shared_ptr<const Table>> m_table;
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::string, std::shared_future<std::shared_ptr<T>>> m_pending;
+	std::atomic<size_t> m_gpuBytes{ 0 };
+	std::atomic<size_t> m_cpuBytes{ 0 };
+};
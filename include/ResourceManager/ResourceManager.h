@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <ResourceManager/Managers/MeshManager.h>
 #include <ResourceManager/Managers/Texture2DManager.h>
@@ -7,15 +9,46 @@
 
 class ResourceManager {
 public:
+	/* 0 = no budget */
+	struct Settings {
+		size_t gpuBudgetBytes = 512ull * 1024 * 1024;
+		size_t cpuBudgetBytes = 64ull * 1024 * 1024;
+	};
+
+	struct Stats {
+		size_t gpuBytes = 0;
+		size_t cpuBytes = 0;
+		uint64_t evictedCount = 0;
+		size_t evictedGpuBytes = 0;
+		/* still over budget after the last enforceBudgets(), everything left is referenced */
+		bool overBudget = false;
+	};
+
 	MeshManager& meshManager = MeshManager::getInstance();
 	Texture2DManager& texture2DManager = Texture2DManager::getInstance();
 	TextureCubeMapManager& textureCubeMapManager = TextureCubeMapManager::getInstance();
 
 	static ResourceManager& getInstance();
+
+	/*
+	 * Evicts unreferenced resources, least recently used first across every manager, until the totals
+	 * are within budget. Frees GL objects, so call it on the GL thread, e.g. once per frame.
+	 */
+	void enforceBudgets();
+
+	size_t getGpuBytes() const;
+	size_t getCpuBytes() const;
+
+	const Settings& getSettings() const { return m_settings; }
+	void setSettings(const Settings& settings) { m_settings = settings; }
+	const Stats& getStats() const { return m_stats; }
 private:
 	ResourceManager() = default;
 	~ResourceManager() = default;
 
 	ResourceManager(const ResourceManager&) = delete;
 	ResourceManager& operator=(const ResourceManager&) = delete;
-};
\ No newline at end of file
+
+	Settings m_settings;
+	Stats m_stats;
+};
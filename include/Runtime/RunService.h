@@ -0,0 +1,60 @@
+#pragma once
+#include <Event/Event.h>
+#include <cstdint>
+#include <functional>
+
+/*
+ * Runs the simulation at a fixed rate, decoupled from the frame rate. Every frame update():
+ *   renderStepped(frameDeltaTime)            once, before anything is simulated
+ *   stepped(time, fixedDeltaTime), simulate  once per fixed step the accumulated time allows
+ *   heartbeat(frameDeltaTime)                once, after the frame's steps
+ * What is left in the accumulator becomes getInterpolationAlpha(), the fraction of a step the
+ * renderer should blend the last simulated state towards the next one.
+ */
+class RunService {
+public:
+	using SimulateFn = std::function<void(double)>;
+
+	struct Settings {
+		double fixedDeltaTime = 1.0 / 60.0;
+		/* steps per frame at most, slower frames drop the rest instead of falling further behind */
+		int maxStepsPerFrame = 4;
+	};
+
+	struct Stats {
+		uint64_t stepCount = 0;
+		int stepsLastFrame = 0;
+		/* wall time of the last frame's steps, stepped handlers included */
+		double simulationMilliseconds = 0.0;
+		/* simulated time thrown away by maxStepsPerFrame */
+		double droppedSeconds = 0.0;
+	};
+
+	RunService();
+	explicit RunService(const Settings& settings);
+
+	RunService(const RunService&) = delete;
+	RunService& operator=(const RunService&) = delete;
+
+	Event<double> renderStepped;
+	Event<double, double> stepped;
+	Event<double> heartbeat;
+
+	/* the work of one fixed step, runs right after stepped */
+	void bindSimulation(SimulateFn simulate);
+	/* returns the number of fixed steps run this frame */
+	int update(double frameDeltaTime);
+
+	/* in [0, 1), how far the render frame is between the last step and the next */
+	double getInterpolationAlpha() const;
+	/* seconds simulated since creation */
+	double getTime() const;
+	const Settings& getSettings() const { return m_settings; }
+	const Stats& getStats() const { return m_stats; }
+private:
+	Settings m_settings;
+	Stats m_stats;
+	SimulateFn m_simulate;
+	double m_accumulator = 0.0;
+	double m_time = 0.0;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+struct lua_CompileOptions;
+
+/*
+ * Compiled Luau bytecode on disk, one file per key. The key hashes the source, the compile
+ * options, Luau's bytecode version and the cache format, so an edit, an option change or a Luau
+ * upgrade is just a miss. Unreadable, truncated or mismatched entries are misses too; a miss
+ * compiles and rewrites the entry.
+ * Sources that fail to compile aren't cached so their errors are reported every run.
+ */
+class BytecodeCache {
+public:
+	struct Stats {
+		size_t hitCount = 0;
+		size_t missCount = 0;
+		size_t writeFailureCount = 0;
+		size_t refreshCount = 0;
+	};
+
+	explicit BytecodeCache(std::filesystem::path directory);
+
+	static BytecodeCache& getInstance();
+
+	/* the bytecode for source, as luau_compile would return it */
+	std::string getBytecode(const std::string& source, const lua_CompileOptions& options);
+	/* compiles source again and overwrites its entry, for cached bytecode luau_load rejected */
+	std::string refresh(const std::string& source, const lua_CompileOptions& options);
+
+	static uint64_t getKey(const std::string& source, const lua_CompileOptions& options);
+
+	Stats getStats() const;
+private:
+	std::filesystem::path getPath(uint64_t key) const;
+	bool read(uint64_t key, size_t sourceSize, std::string& bytecode) const;
+	bool write(uint64_t key, size_t sourceSize, const std::string& bytecode) const;
+	std::string compileAndStore(uint64_t key, const std::string& source, const lua_CompileOptions& options);
+
+	std::filesystem::path m_directory;
+	mutable std::mutex m_mutex;
+	Stats m_stats;
+};
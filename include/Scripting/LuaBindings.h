@@ -0,0 +1,92 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+struct lua_State;
+struct lua_CompileOptions;
+
+/*
+ * Engine types as Luau userdata. Every type has its own userdata tag and a metatable bound to
+ * that tag, so type checks are a tag compare instead of a metatable lookup. Member names are
+ * resolved through string atoms: the VM asks getAtom() once when it interns a string, and
+ * __index / __newindex / __namecall switch on the cached atom instead of comparing strings.
+ * Vector3 is not userdata but Luau's native vector value, see compileOptions().
+ */
+namespace LuaBindings {
+	enum UserdataTag : int {
+		InstanceTag = 1,
+		SignalTag,
+		ConnectionTag,
+	};
+
+	enum class Atom : int16_t {
+		/* Instance */
+		Name,
+		ClassName,
+		Parent,
+		ChildAdded,
+		ChildRemoved,
+		Destroying,
+		DescendantAdded,
+		DescendantRemoving,
+		FindFirstChild,
+		FindFirstChildOfClass,
+		FindFirstAncestor,
+		FindFirstAncestorOfClass,
+		GetChildren,
+		GetDescendants,
+		GetFullName,
+		GetService,
+		IsA,
+		Clone,
+		Destroy,
+		/* BasePart */
+		Position,
+		Orientation,
+		Size,
+		Transparency,
+		Anchored,
+		CanCollide,
+		CastShadow,
+		Velocity,
+		AngularVelocity,
+		Density,
+		Friction,
+		Elasticity,
+		/* Script */
+		Source,
+		/* Vector3 */
+		X,
+		Y,
+		Z,
+		Magnitude,
+		Unit,
+		Dot,
+		Cross,
+		/* Signal / Connection */
+		Connect,
+		Disconnect,
+		Connected,
+		Wait,
+
+		Count,
+	};
+
+	/* lua_Callbacks::useratom, -1 for strings that aren't engine member names */
+	int16_t getAtom(const char* s, size_t length);
+
+	/* registers the metatables and the Instance / Vector3 globals, game and workspace */
+	void open(lua_State* L, const InstancePtr& dataModel);
+	/* compile options for scripts, they make Vector3.new a builtin that constructs a native vector */
+	lua_CompileOptions compileOptions();
+
+	/* the same Instance always maps to the same userdata while scripts hold on to it */
+	void pushInstance(lua_State* L, const InstancePtr& instance);
+	Instance* checkInstance(lua_State* L, int index);
+
+	/* allocation free, vectors are values */
+	void pushVector3(lua_State* L, const glm::vec3& value);
+	glm::vec3 checkVector3(lua_State* L, int index);
+}
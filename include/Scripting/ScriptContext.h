@@ -0,0 +1,79 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <Event/Connection.h>
+#include <Scripting/TaskScheduler.h>
+#include <Scripting/BytecodeCache.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+struct lua_State;
+class Script;
+
+/*
+ * Owns the Luau VM the DataModel's Scripts run in. Each script runs on its own sandboxed
+ * thread with a `script` global; event handlers run on a fresh thread per call. Threads that
+ * yield through the task library or :Wait() are resumed by the TaskScheduler.
+ * A context created for an Actor only runs the Scripts whose nearest Actor ancestor it is.
+ * Everything here happens on the thread that owns the DataModel, except the parallel phase,
+ * which runs one context per worker with instance writes rejected.
+ */
+class ScriptContext {
+public:
+	explicit ScriptContext(const InstancePtr& dataModel, const InstancePtr& actor = nullptr, BytecodeCache& bytecodeCache = BytecodeCache::getInstance());
+	~ScriptContext();
+
+	ScriptContext(const ScriptContext&) = delete;
+	ScriptContext& operator=(const ScriptContext&) = delete;
+
+	static ScriptContext* fromState(lua_State* L);
+
+	/* runs every Script under the DataModel that belongs to this context, in tree order */
+	void runScripts();
+	/* returns false and logs when the source fails to compile or errors before yielding,
+	 * compiled bytecode comes from the BytecodeCache when the source was seen before */
+	bool runScript(const std::string& source, const std::string& chunkName, const std::shared_ptr<Script>& script = nullptr);
+
+	using PushArgs = std::function<int(lua_State*)>;
+
+	/* keeps the function at functionRef connected until disconnect() or destruction,
+	 * connectEvent gets the new connection's id to hand to invokeConnection.
+	 * The handler's time is charged to the script L belongs to */
+	uint32_t connect(lua_State* L, int functionRef, const std::function<EventConnection(uint32_t)>& connectEvent);
+	void disconnect(uint32_t id);
+	bool isConnected(uint32_t id) const;
+
+	/* calls a connected function on a new thread, pushArgs pushes its arguments and returns their count */
+	void invokeConnection(uint32_t id, const PushArgs& pushArgs);
+
+	/* resumes a suspended or new thread, logs and returns false when it errors */
+	bool resume(lua_State* thread, int argumentCount);
+
+	lua_State* getState() const { return m_state; }
+	TaskScheduler& getScheduler() { return m_scheduler; }
+	const InstancePtr& getActor() const { return m_actor; }
+private:
+	struct ScriptConnection {
+		EventConnection connection;
+		int functionRef = 0;
+		TaskScheduler::ScriptStats* stats = nullptr;
+	};
+
+	static void interrupt(lua_State* L, int gc);
+	static void userthread(lua_State* parent, lua_State* thread);
+
+	lua_State* m_state = nullptr;
+	InstancePtr m_dataModel;
+	InstancePtr m_actor;
+	TaskScheduler m_scheduler;
+	BytecodeCache& m_bytecodeCache;
+	/* lua_clock() time the outermost running resume must finish by */
+	double m_resumeDeadline = 0.0;
+	int m_resumeDepth = 0;
+	/* time spent in resumes nested inside the current one, so it isn't charged twice */
+	double m_nestedSeconds = 0.0;
+	std::unordered_map<uint32_t, ScriptConnection> m_connections;
+	uint32_t m_nextConnectionId = 1;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <Scripting/ScriptContext.h>
+#include <Threading/ThreadPool.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/*
+ * The DataModel's script VMs: one for Scripts outside any Actor and one per Actor, so that
+ * Actors can run on separate cores. Each frame has three resumption points:
+ *   serial    every VM in turn on the calling thread, timers fire here
+ *   parallel  desynchronized threads, one Actor VM per worker, the tree is read-only
+ *   serial    threads that called task.synchronize during the parallel phase
+ * Actors are found when start() runs; ones added later get no VM.
+ */
+class ScriptRuntime {
+public:
+	struct Stats {
+		size_t actorCount = 0;
+		double serialMilliseconds = 0.0;
+		double parallelMilliseconds = 0.0;
+	};
+
+	explicit ScriptRuntime(const InstancePtr& dataModel, ThreadPool& pool = ThreadPool::getInstance());
+	~ScriptRuntime() = default;
+
+	ScriptRuntime(const ScriptRuntime&) = delete;
+	ScriptRuntime& operator=(const ScriptRuntime&) = delete;
+
+	/* creates the Actor VMs and runs every Script */
+	void start();
+	void step(double now);
+
+	ScriptContext& getMainContext() { return *m_contexts.front(); }
+	/* the main context first, then one per Actor in tree order */
+	const std::vector<std::unique_ptr<ScriptContext>>& getContexts() const { return m_contexts; }
+	const Stats& getStats() const { return m_stats; }
+private:
+	InstancePtr m_dataModel;
+	ThreadPool& m_pool;
+	std::vector<std::unique_ptr<ScriptContext>> m_contexts;
+	Stats m_stats;
+};
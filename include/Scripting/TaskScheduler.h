@@ -0,0 +1,133 @@
+#pragma once
+#include <Event/Connection.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct lua_State;
+class ScriptContext;
+
+/*
+ * Cooperative scheduling for script threads. Yielded threads wait in a timer heap (task.wait,
+ * task.delay) or on an event (:Wait()); step() moves the due ones to the ready queue and
+ * resumes it in order until the frame's budget is spent, the rest run first next frame.
+ * CPU time is charged to the Script that started a thread, threads it creates inherit it.
+ *
+ * Threads of an Actor's VM can desynchronize into the parallel phase, which the ScriptRuntime
+ * runs for every Actor at once on the ThreadPool; synchronize brings them back to serial.
+ * Waits started in the parallel phase resume in it.
+ */
+class TaskScheduler {
+public:
+	using PushArgs = std::function<int(lua_State*)>;
+	/* resumes a thread waiting on an event with the event's arguments */
+	using EventResumer = std::function<void(const PushArgs&)>;
+
+	struct Settings {
+		/* wall time each resumption point may spend resuming threads, at least one thread always runs */
+		double resumeBudgetMilliseconds = 4.0;
+		/* a single resume running longer than this is aborted with an error */
+		double scriptTimeoutSeconds = 5.0;
+	};
+
+	struct ScriptStats {
+		std::string name;
+		double totalMilliseconds = 0.0;
+		/* time spent between the last two step() calls */
+		double frameMilliseconds = 0.0;
+		uint64_t resumeCount = 0;
+		double pendingMilliseconds = 0.0;
+	};
+
+	struct Stats {
+		size_t waitingCount = 0;
+		size_t readyCount = 0;
+		size_t parallelReadyCount = 0;
+		size_t resumedLastStep = 0;
+		double stepMilliseconds = 0.0;
+	};
+
+	explicit TaskScheduler(ScriptContext& context);
+	~TaskScheduler() = default;
+
+	TaskScheduler(const TaskScheduler&) = delete;
+	TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+	/* registers the task library (wait, spawn, defer, delay, desynchronize, synchronize) */
+	static void openLibrary(lua_State* L);
+
+	/* starts a frame: resumes the serial threads due at now, in seconds on the caller's clock */
+	void step(double now);
+	/* resumes the desynchronized threads, may run on a worker thread */
+	void stepParallel();
+	/* resumes the threads that synchronized during stepParallel */
+	void resumeSerial();
+	/* drops every waiting thread, the VM is about to close */
+	void clear();
+
+	/* the calling thread must yield right after these */
+	void waitFor(lua_State* thread, double seconds);
+	void waitForEvent(lua_State* thread, const std::function<EventConnection(EventResumer)>& connectEvent);
+	/* thread holds a function and its argumentCount arguments */
+	void delay(lua_State* thread, int argumentCount, double seconds);
+	void defer(lua_State* thread, int argumentCount);
+	void desynchronize(lua_State* thread);
+	void synchronize(lua_State* thread);
+
+	/* instance writes are rejected while this is set */
+	bool isParallel() const { return m_parallel; }
+
+	ScriptStats* createScriptStats(std::string name);
+	const std::deque<ScriptStats>& getScriptStats() const { return m_scriptStats; }
+
+	double getTime() const { return m_now; }
+	Settings& getSettings() { return m_settings; }
+	const Stats& getStats() const { return m_stats; }
+private:
+	struct ReadyThread {
+		lua_State* thread = nullptr;
+		int ref = 0;
+		int argumentCount = 0;
+	};
+
+	struct Timer {
+		double resumeAt = 0.0;
+		/* insertion order breaks ties so equal wake times resume deterministically */
+		uint64_t sequence = 0;
+		ReadyThread ready;
+		/* task.wait resumes with the time actually waited */
+		double waitStart = 0.0;
+		bool returnsElapsed = false;
+		bool parallel = false;
+	};
+
+	struct EventWait {
+		ReadyThread ready;
+		EventConnection connection;
+	};
+
+	static bool laterTimer(const Timer& a, const Timer& b);
+	int refThread(lua_State* thread);
+	void schedule(lua_State* thread, int argumentCount, double seconds, bool returnsElapsed);
+	void resumeQueue(std::deque<ReadyThread>& queue);
+
+	ScriptContext& m_context;
+	Settings m_settings;
+	Stats m_stats;
+	double m_now = 0.0;
+	bool m_parallel = false;
+
+	std::vector<Timer> m_timers;
+	uint64_t m_nextSequence = 0;
+	std::deque<ReadyThread> m_ready;
+	std::deque<ReadyThread> m_parallelReady;
+	std::unordered_map<uint64_t, EventWait> m_eventWaits;
+	uint64_t m_nextEventWait = 1;
+
+	/* deque so the pointers handed to threads stay valid */
+	std::deque<ScriptStats> m_scriptStats;
+};
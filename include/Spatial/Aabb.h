@@ -0,0 +1,48 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+
+struct Aabb {
+	glm::vec3 min{ 0.0f };
+	glm::vec3 max{ 0.0f };
+
+	glm::vec3 getCenter() const { return (min + max) * 0.5f; }
+	glm::vec3 getExtents() const { return (max - min) * 0.5f; }
+
+	float getSurfaceArea() const {
+		const glm::vec3 d = max - min;
+		return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+	}
+
+	bool overlaps(const Aabb& other) const {
+		return min.x <= other.max.x && max.x >= other.min.x
+			&& min.y <= other.max.y && max.y >= other.min.y
+			&& min.z <= other.max.z && max.z >= other.min.z;
+	}
+
+	bool contains(const Aabb& other) const {
+		return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z
+			&& max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+	}
+
+	float distanceSquared(const glm::vec3& point) const {
+		const glm::vec3 d = glm::max(glm::max(min - point, point - max), glm::vec3(0.0f));
+		return glm::dot(d, d);
+	}
+
+	/* slab test against origin + t * direction, invDirection = 1 / direction */
+	bool intersectsRay(const glm::vec3& origin, const glm::vec3& invDirection, float maxDistance, float& outDistance) const {
+		const glm::vec3 t0 = (min - origin) * invDirection;
+		const glm::vec3 t1 = (max - origin) * invDirection;
+		const glm::vec3 tNear = glm::min(t0, t1);
+		const glm::vec3 tFar = glm::max(t0, t1);
+		const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+		outDistance = enter;
+		return enter <= exit;
+	}
+
+	static Aabb merge(const Aabb& a, const Aabb& b) {
+		return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+	}
+};
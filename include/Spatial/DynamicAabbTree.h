@@ -0,0 +1,157 @@
+#pragma once
+#include <Spatial/Aabb.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/*
+ * Bounding volume hierarchy over fattened AABBs (after Box2D's b2DynamicTree).
+ * Leaves are enlarged by a margin so small movements don't touch the tree,
+ * insertion picks the sibling by surface area cost and AVL rotations keep it balanced.
+ */
+class DynamicAabbTree {
+public:
+	static constexpr int32_t nullNode = -1;
+
+	explicit DynamicAabbTree(float margin = 0.1f);
+	~DynamicAabbTree() = default;
+
+	int32_t createProxy(const Aabb& aabb, uint32_t userData);
+	void destroyProxy(int32_t proxyId);
+	/* returns true when the proxy left its fat AABB and was reinserted */
+	bool moveProxy(int32_t proxyId, const Aabb& aabb, const glm::vec3& displacement = glm::vec3(0.0f));
+
+	uint32_t getUserData(int32_t proxyId) const { return m_nodes[proxyId].userData; }
+	const Aabb& getFatAabb(int32_t proxyId) const { return m_nodes[proxyId].aabb; }
+	int32_t getHeight() const { return m_root == nullNode ? 0 : m_nodes[m_root].height; }
+	size_t getProxyCount() const { return m_proxyCount; }
+
+	void clear();
+
+	/* callback(proxyId) -> false stops the query */
+	template<typename F>
+	void query(const Aabb& aabb, F&& callback) const {
+		if (m_root == nullNode) return;
+		std::vector<int32_t> stack;
+		stack.reserve(64);
+		stack.push_back(m_root);
+		while (!stack.empty()) {
+			const int32_t index = stack.back();
+			stack.pop_back();
+			const Node& node = m_nodes[index];
+			if (!node.aabb.overlaps(aabb)) continue;
+			if (node.isLeaf()) {
+				if (!callback(index)) return;
+			}
+			else {
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+
+	/*
+	 * direction must be normalized. callback(proxyId, maxDistance) returns the new max distance
+	 * to clip the ray to, maxDistance to keep going unchanged, or 0 to stop.
+	 */
+	template<typename F>
+	void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, F&& callback) const {
+		if (m_root == nullNode) return;
+		const glm::vec3 invDirection = 1.0f / direction;
+		float distance;
+		if (!m_nodes[m_root].aabb.intersectsRay(origin, invDirection, maxDistance, distance)) return;
+
+		/* children are pushed far-first so the near side is visited first and clips the ray early */
+		std::vector<std::pair<float, int32_t>> stack;
+		stack.reserve(64);
+		stack.emplace_back(distance, m_root);
+		while (!stack.empty()) {
+			const auto [entry, index] = stack.back();
+			stack.pop_back();
+			if (entry > maxDistance) continue;
+
+			const Node& node = m_nodes[index];
+			if (node.isLeaf()) {
+				const float value = callback(index, maxDistance);
+				if (value == 0.0f) return;
+				maxDistance = std::min(maxDistance, value);
+				continue;
+			}
+
+			float distance1, distance2;
+			const bool hit1 = m_nodes[node.child1].aabb.intersectsRay(origin, invDirection, maxDistance, distance1);
+			const bool hit2 = m_nodes[node.child2].aabb.intersectsRay(origin, invDirection, maxDistance, distance2);
+			if (hit1 && hit2) {
+				if (distance1 < distance2) {
+					stack.emplace_back(distance2, node.child2);
+					stack.emplace_back(distance1, node.child1);
+				}
+				else {
+					stack.emplace_back(distance1, node.child1);
+					stack.emplace_back(distance2, node.child2);
+				}
+			}
+			else if (hit1) {
+				stack.emplace_back(distance1, node.child1);
+			}
+			else if (hit2) {
+				stack.emplace_back(distance2, node.child2);
+			}
+		}
+	}
+
+	/*
+	 * visits leaves in increasing AABB distance from point. callback(proxyId) returns the squared
+	 * distance beyond which nothing else is of interest (infinity to keep visiting everything).
+	 */
+	template<typename F>
+	void queryNearest(const glm::vec3& point, F&& callback) const {
+		if (m_root == nullNode) return;
+		using Entry = std::pair<float, int32_t>;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+		open.emplace(m_nodes[m_root].aabb.distanceSquared(point), m_root);
+		float bound = std::numeric_limits<float>::infinity();
+		while (!open.empty()) {
+			const auto [distance, index] = open.top();
+			open.pop();
+			if (distance > bound) return;
+			const Node& node = m_nodes[index];
+			if (node.isLeaf()) {
+				bound = callback(index);
+				continue;
+			}
+			open.emplace(m_nodes[node.child1].aabb.distanceSquared(point), node.child1);
+			open.emplace(m_nodes[node.child2].aabb.distanceSquared(point), node.child2);
+		}
+	}
+private:
+	struct Node {
+		Aabb aabb;
+		uint32_t userData = 0;
+		/* parent while in the tree, next free node while on the free list */
+		int32_t parent = nullNode;
+		int32_t child1 = nullNode;
+		int32_t child2 = nullNode;
+		/* leaf = 0, free = -1 */
+		int32_t height = -1;
+
+		bool isLeaf() const { return child1 == nullNode; }
+	};
+
+	int32_t allocateNode();
+	void freeNode(int32_t index);
+	void insertLeaf(int32_t leaf);
+	void removeLeaf(int32_t leaf);
+	int32_t balance(int32_t index);
+	void refit(int32_t index);
+
+	std::vector<Node> m_nodes;
+	int32_t m_root = nullNode;
+	int32_t m_freeList = nullNode;
+	size_t m_proxyCount = 0;
+	float m_margin;
+};
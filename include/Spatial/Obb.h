@@ -0,0 +1,22 @@
+#pragma once
+#include <Spatial/Aabb.h>
+#include <glm/glm.hpp>
+
+class BasePart;
+
+struct Obb {
+	glm::vec3 center{ 0.0f };
+	/* columns are the box's local X, Y and Z axes */
+	glm::mat3 axes{ 1.0f };
+	glm::vec3 halfExtents{ 0.5f };
+
+	static Obb fromPart(const BasePart& part);
+	static Obb fromAabb(const Aabb& aabb);
+
+	Aabb getBounds() const;
+	glm::vec3 closestPoint(const glm::vec3& point) const;
+	float distanceSquared(const glm::vec3& point) const;
+	bool overlaps(const Obb& other) const;
+	/* outNormal is the world normal of the face hit, the ray must start outside or report t = 0 */
+	bool intersectsRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& outDistance, glm::vec3& outNormal) const;
+};
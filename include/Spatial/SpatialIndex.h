@@ -0,0 +1,76 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <Instance/BasePart.h>
+#include <Spatial/Aabb.h>
+#include <Spatial/DynamicAabbTree.h>
+#include <Event/Connection.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+struct RaycastResult {
+	std::shared_ptr<BasePart> part;
+	glm::vec3 position{ 0.0f };
+	glm::vec3 normal{ 0.0f };
+	float distance = 0.0f;
+};
+
+/*
+ * Spatial queries over the BaseParts under a root instance (usually Workspace).
+ * Membership follows descendantAdded/descendantRemoving; transforms are plain fields,
+ * so call update() once per tick after parts have moved. Queries may run concurrently
+ * with each other but not with update() or tree changes.
+ */
+class SpatialIndex {
+public:
+	using Filter = std::function<bool(const BasePart&)>;
+
+	SpatialIndex() = default;
+	~SpatialIndex() = default;
+
+	SpatialIndex(const SpatialIndex&) = delete;
+	SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+	/* indexes the BaseParts under root and keeps following it */
+	void attach(const InstancePtr& root);
+	void detach();
+
+	void insert(const std::shared_ptr<BasePart>& part);
+	void remove(const BasePart* part);
+	/* refreshes the bounds of parts that moved, rotated or resized since the last call */
+	void update();
+
+	/* direction's length is the maximum distance */
+	std::optional<RaycastResult> raycast(const glm::vec3& origin, const glm::vec3& direction, const Filter& filter = nullptr) const;
+	/* parts overlapping a box of the given size, rotated by orientation (degrees, like BasePart) */
+	std::vector<std::shared_ptr<BasePart>> getPartsInBox(const glm::vec3& center, const glm::vec3& size, const glm::vec3& orientation = glm::vec3(0.0f), const Filter& filter = nullptr) const;
+	std::vector<std::shared_ptr<BasePart>> getPartsInRadius(const glm::vec3& center, float radius, const Filter& filter = nullptr) const;
+	/* up to k parts ordered by distance from point to their surface */
+	std::vector<std::shared_ptr<BasePart>> getNearestParts(const glm::vec3& point, size_t k, const Filter& filter = nullptr) const;
+
+	size_t size() const;
+private:
+	struct Proxy {
+		std::shared_ptr<BasePart> part;
+		int32_t treeId = DynamicAabbTree::nullNode;
+		glm::vec3 position{ 0.0f };
+		glm::vec3 orientation{ 0.0f };
+		glm::vec3 size{ 0.0f };
+		/* half extents of the rotated part's AABB, reused while only the position changes */
+		glm::vec3 extent{ 0.0f };
+	};
+
+	static glm::vec3 computeExtent(const BasePart& part);
+
+	DynamicAabbTree m_tree;
+	std::vector<Proxy> m_proxies;
+	std::vector<uint32_t> m_freeProxies;
+	std::unordered_map<const BasePart*, uint32_t> m_lookup;
+
+	EventConnection m_addedConnection;
+	EventConnection m_removingConnection;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <Instance/Instance.h>
+#include <PlaceSerializer/PlaceDeserializer.h>
+#include <Threading/ThreadPool.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <future>
+#include <string>
+#include <vector>
+
+/*
+ * Loads and unloads the streaming regions of a place around a focus point.
+ * Regions are decoded on the thread pool and parented on the thread calling update().
+ * Changes made to streamed instances are lost when their region is unloaded.
+ */
+class StreamingController {
+public:
+	struct Settings {
+		/* regions closer than this to the focus are loaded */
+		float targetRadius = 256.0f;
+		/* loaded regions further than this are unloaded, keep above targetRadius to avoid thrashing */
+		float unloadRadius = 320.0f;
+		/* estimated bytes of streamed instances kept alive at once */
+		size_t memoryBudgetBytes = 256ull * 1024 * 1024;
+		size_t maxConcurrentLoads = 4;
+	};
+
+	StreamingController(std::string filename, PlaceDocument document, Settings settings, ThreadPool& pool = ThreadPool::getInstance());
+	~StreamingController();
+
+	StreamingController(const StreamingController&) = delete;
+	StreamingController& operator=(const StreamingController&) = delete;
+
+	void update(const glm::vec3& focus);
+
+	size_t getRegionCount() const;
+	size_t getLoadedRegionCount() const;
+	size_t getPendingRegionCount() const;
+	size_t getMemoryUsage() const;
+	const Settings& getSettings() const;
+private:
+	enum class RegionState { Unloaded, Loading, Loaded };
+
+	struct Region {
+		PlaceRegion info;
+		RegionState state = RegionState::Unloaded;
+		size_t estimatedBytes = 0;
+		float distance = 0.0f;
+		std::future<PlaceRegionContents> pending;
+		std::vector<InstancePtr> roots;
+	};
+
+	void finishLoad(Region& region);
+	void unload(Region& region);
+
+	std::string m_filename;
+	PlaceDocument m_document;
+	Settings m_settings;
+	ThreadPool& m_pool;
+
+	std::vector<Region> m_regions;
+	size_t m_memoryUsage = 0;
+	size_t m_loadedCount = 0;
+	size_t m_pendingCount = 0;
+};
@@ -7,5 +7,7 @@ class ITexture {
 public:
 	virtual ~ITexture() = default;
 	virtual void bind(unsigned int slot = 0) const = 0;
+	/* the texture object, for binding several at once with glBindTextures */
+	virtual GLuint getId() const = 0;
 	//virtual glm::uvec2 getSize() const = 0;
 };
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 #include <Texture/ITexture.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <glm/glm.hpp>
 #include <glad/glad.h>
@@ -7,11 +10,19 @@
 class Texture2D: public ITexture {
 public:
 	Texture2D(const std::string& filename);
+	/* from an encoded PNG/JPEG already in memory, e.g. an asset archive entry */
+	explicit Texture2D(std::span<const uint8_t> encoded);
 	~Texture2D();
 
 	void bind(unsigned int slot = 0) const override;
+	GLuint getId() const override { return m_id; }
 	glm::uvec2 getSize() const;
+	/* RGBA8, the decoded image isn't kept on the CPU after upload */
+	size_t getGpuByteSize() const { return static_cast<size_t>(m_size.x) * m_size.y * 4; }
+	size_t getCpuByteSize() const { return sizeof(*this); }
 private:
+	void upload(unsigned char* image, int width, int height);
+
 	GLuint m_id = 0;
 	glm::uvec2 m_size{ 0, 0 };
 };
\ No newline at end of file
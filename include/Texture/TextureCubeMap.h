@@ -1,5 +1,9 @@
 #pragma once
 #include <Texture/ITexture.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <glm/glm.hpp>
 #include <glad/glad.h>
@@ -14,9 +18,26 @@ public:
 		const std::string& topFilename,
 		const std::string& bottomFilename
 	);
+	/* encoded PNG/JPEG faces already in memory, in the same front, back, left, right, top, bottom order */
+	explicit TextureCubeMap(const std::array<std::span<const uint8_t>, 6>& encodedFaces);
 	~TextureCubeMap();
 
 	void bind(unsigned int slot = 0) const override;
+	GLuint getId() const override { return m_id; }
+	/* RGB8 faces, the decoded images aren't kept on the CPU after upload */
+	size_t getGpuByteSize() const { return m_byteSize; }
+	size_t getCpuByteSize() const { return sizeof(*this); }
 private:
+	/* a decoded face, data is null if it failed to decode */
+	struct Face {
+		unsigned char* data = nullptr;
+		int width = 0;
+		int height = 0;
+	};
+
+	/* faces in GL order (+X, -X, +Y, -Y, +Z, -Z), all the same size; frees their data */
+	void upload(std::array<Face, 6>& faces);
+
 	GLuint m_id = 0;
+	size_t m_byteSize = 0;
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool {
+public:
+	/* 0 = one worker per hardware thread, minus the caller */
+	explicit ThreadPool(size_t threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	static ThreadPool& getInstance();
+
+	template<typename F>
+	auto submit(F&& fn) -> std::future<std::invoke_result_t<F>> {
+		using Result = std::invoke_result_t<F>;
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+		auto future = task->get_future();
+		enqueue([task]() { (*task)(); });
+		return future;
+	}
+
+	/* runs fn(i) for i in [0, count) across the workers and the calling thread, blocks until done */
+	void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+	size_t getThreadCount() const;
+private:
+	void enqueue(std::function<void()> job);
+	void workerLoop(std::stop_token stop, size_t index);
+
+	std::mutex m_mutex;
+	std::condition_variable_any m_condition;
+	std::deque<std::function<void()>> m_jobs;
+	std::vector<std::jthread> m_workers;
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/* FNV-1a, for content keys that are stored on disk and must not change between runs or builds */
+namespace Hash {
+	constexpr uint64_t offsetBasis = 14695981039346656037ull;
+	constexpr uint64_t prime = 1099511628211ull;
+
+	inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash = offsetBasis) {
+		const auto* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= prime;
+		}
+		return hash;
+	}
+
+	constexpr uint64_t fnv1a(std::string_view text, uint64_t hash = offsetBasis) {
+		for (const char c : text) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= prime;
+		}
+		return hash;
+	}
+
+	template<typename T>
+	uint64_t fnv1aValue(const T& value, uint64_t hash = offsetBasis) {
+		return fnv1a(&value, sizeof(value), hash);
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+/* a read-only memory map of a whole file, pages are faulted in as they are touched */
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/* false if the file can't be opened or mapped, an empty file maps to an empty span */
+	bool open(const std::string& filename);
+	void close();
+
+	bool isOpen() const { return m_open; }
+	std::span<const uint8_t> getBytes() const { return { m_data, m_size }; }
+private:
+	const uint8_t* m_data = nullptr;
+	size_t m_size = 0;
+	bool m_open = false;
+#ifdef _WIN32
+	void* m_file = nullptr;
+	void* m_mapping = nullptr;
+#endif
+};
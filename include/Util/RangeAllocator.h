@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Suballocates ranges of an abstract buffer in constant time: two-level segregated fit (Masmano et
+ * al., "TLSF: a New Dynamic Memory Allocator for Real-Time Systems") with free neighbours merged on
+ * free. Units are whatever the caller counts in, bytes, vertices or indices; nothing is stored in
+ * the buffer itself, so it works for GPU memory.
+ */
+class RangeAllocator {
+public:
+	using Handle = uint32_t;
+	static constexpr Handle invalid = ~0u;
+
+	struct Range {
+		size_t offset = 0;
+		size_t size = 0;
+	};
+
+	explicit RangeAllocator(size_t capacity = 0);
+
+	/* invalid when no free range fits; zero-sized requests take one unit */
+	Handle allocate(size_t size);
+	void free(Handle handle);
+	Range get(Handle handle) const { return { m_blocks[handle].offset, m_blocks[handle].size }; }
+
+	/* adds capacity past the end, existing ranges stay where they are */
+	void grow(size_t capacity);
+	/* frees everything, handles from before are invalid */
+	void reset(size_t capacity);
+
+	size_t getCapacity() const { return m_capacity; }
+	size_t getUsed() const { return m_used; }
+	size_t getLargestFree() const;
+private:
+	static constexpr uint32_t secondLevelBits = 4;
+	static constexpr uint32_t secondLevelCount = 1u << secondLevelBits;
+	static constexpr uint32_t firstLevelCount = 64;
+
+	struct Block {
+		size_t offset = 0;
+		size_t size = 0;
+		/* neighbours in the buffer and in the free list of the block's bin */
+		uint32_t previous = invalid;
+		uint32_t next = invalid;
+		uint32_t previousFree = invalid;
+		uint32_t nextFree = invalid;
+		bool free = false;
+	};
+
+	/* the bin a free block of size belongs in */
+	static void mapInsert(size_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+	/* the first bin whose blocks are all at least size */
+	static void mapSearch(size_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+
+	uint32_t newBlock();
+	void releaseBlock(uint32_t block);
+	void insertFree(uint32_t block);
+	void removeFree(uint32_t block);
+	uint32_t findFree(size_t size) const;
+
+	std::vector<Block> m_blocks;
+	std::vector<uint32_t> m_unusedBlocks;
+	uint64_t m_firstLevelBitmap = 0;
+	std::array<uint32_t, firstLevelCount> m_secondLevelBitmaps{};
+	std::array<uint32_t, firstLevelCount * secondLevelCount> m_freeHeads{};
+	/* the block ending at m_capacity */
+	uint32_t m_last = invalid;
+	size_t m_capacity = 0;
+	size_t m_used = 0;
+};
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <print>
 #include <memory>
+#include <filesystem>
 
 /* EXTERN DEPENDENCIES */
 #include <glad/glad.h>
@@ -15,12 +16,14 @@
 /* MESH */
 #include <Mesh/IMesh.h>
 #include <Mesh/Mesh3D.h>
+#include <Mesh/MeshArena.h>
 
 /* SHADER */
 #include <Shader/Shader.h>
 
 /* RENDERER */
 #include <Render/MeshRenderer.h>
+#include <Render/IndirectBatch.h>
 
 /* CAMERA */
 #include <Camera/ICamera.h>
@@ -31,23 +34,48 @@
 #include <Instance/DataModel.h>
 #include <Instance/BasePart.h>
 #include <Instance/Part.h>
+#include <Instance/Script.h>
+#include <Instance/Actor.h>
+
+/* PLACE SERIALIZER */
+#include <PlaceSerializer/PlaceSerializer.h>
+#include <PlaceSerializer/PlaceDeserializer.h>
+
+/* STREAMING */
+#include <Streaming/StreamingController.h>
+#include <Spatial/SpatialIndex.h>
+#include <Physics/PhysicsWorld.h>
+#include <Runtime/RunService.h>
+#include <Scripting/ScriptRuntime.h>
 
 /* GLB DESERIALIZER */
 #include <MeshDeserializer/GlbDeserializer.h>
 
+/* PROFILER */
+#include <Profiling/Profiler.h>
+#include <Profiling/GpuProfiler.h>
+#include <Profiling/ProfilerWindow.h>
+#include <Profiling/StatsRegistry.h>
+
 /* RESOURCE MANAGER */
 #include <ResourceManager/Managers/MeshManager.h>
 #include <ResourceManager/Managers/Texture2DManager.h>
 #include <ResourceManager/ResourceManager.h>
+#include <Asset/AssetArchive.h>
 
 /* CONSTANTS */
 #define WINDOW_TITLE "GameEngine Luau"
 #define WINDOW_WIDTH 720
 #define WINDOW_HEIGHT 480
+#define PLACE_FILENAME "./resources/place.elplace"
+#define STREAMING_REGION_SIZE 64.0f
+#define PICK_DISTANCE 1000.0f
+#define STATS_FILENAME "./stats.json"
+#define ASSET_ARCHIVE_FILENAME "./resources/assets.elpack"
 
 /* GLSL SHADERS */
 
-/* BASIC 3D VERTEX SHADER */
+/* BASIC 3D VERTEX SHADER, DRAWN THROUGH IndirectBatch */
 std::string vertexSrc = R"(#version 460
 
 layout(location=0) in vec3 vertex;
@@ -55,9 +83,12 @@ layout(location=1) in vec3 normal;
 layout(location=2) in vec3 vertexColor;
 layout(location=3) in vec2 textureCoords;
 
+layout(std430, binding=0) readonly buffer Instances {
+	mat4 models[];
+};
+
 uniform mat4 projection;
 uniform mat4 view;
-uniform mat4 model;
 
 out vec2 aTextureCoords;
 out vec3 aNormal;
@@ -65,6 +96,7 @@ out vec3 aVertexColor;
 out vec3 aVertex;
 
 void main(){
+	mat4 model = models[gl_BaseInstance + gl_InstanceID];
 	gl_Position = projection * view * model * vec4(vertex, 1.0);
 	aTextureCoords = textureCoords;
 	aNormal = normalize(normal);
@@ -136,6 +168,11 @@ bool showUi = true;
 bool fullscreen = false;
 bool mouseLocked = false;
 bool wireframeMode = false;
+/* how many pixels a level of detail may stray from the full mesh before a finer one is drawn */
+float lodPixelError = 1.0f;
+bool showProfiler = false;
+/* saving streamed disables saving in the next session, which only holds part of the place */
+bool saveStreamed = false;
 
 int windowPosX = 0, windowPosY = 0;
 int windowWidth = WINDOW_WIDTH, windowHeight = WINDOW_HEIGHT;
@@ -211,12 +248,23 @@ int main()
 		return 3;
 	}
 
+	Profiler& profiler = Profiler::getInstance();
+	profiler.setThreadName("Main");
+	auto gpuProfiler = std::make_unique<GpuProfiler>();
+	ProfilerWindow profilerWindow(profiler);
+	StatsRegistry& stats = StatsRegistry::getInstance();
+	auto& frameMilliseconds = stats.histogram("Frame/Milliseconds");
+
 	glEnable(GL_DEPTH_TEST);
 	glEnable(GL_CULL_FACE);
 	glCullFace(GL_BACK);
 
 	const auto mainShader = std::make_unique<Shader>(vertexSrc, fragmentSrc);
 	const auto skyboxShader = std::make_unique<Shader>(skyboxVertexSrc, skyboxFragmentSrc);
+	IndirectBatch sceneBatch;
+
+	/* packed by GameEnginePacker, anything not in it is read from the loose files */
+	if (std::filesystem::exists(ASSET_ARCHIVE_FILENAME)) AssetArchive::getInstance().mount(ASSET_ARCHIVE_FILENAME);
 
 	const auto object = resourceManager.meshManager.loadMeshFromFile("./resources/pumpkin.glb");
 	const auto object1 = resourceManager.meshManager.loadMeshFromFile("./resources/vegetable.glb");
@@ -229,7 +277,6 @@ int main()
 	const auto plasticStudsTexture = resourceManager.texture2DManager.loadTextureFromFile("./resources/plasticStuds.png");
 
 	const auto skyboxCubeMapTexture = resourceManager.textureCubeMapManager.loadTexturesFromFile(
-		"basic_cubemap",
 		"./resources/skybox/Ft.png",
 		"./resources/skybox/Bk.png",
 		"./resources/skybox/Lf.png",
@@ -240,36 +287,90 @@ int main()
 
 	datamodel->name = "Game";
 
-	auto workspace = std::make_shared<Instance>();
-	workspace->name = "Workspace";
-	workspace->setParent(datamodel);
-
-	auto foobar = std::make_shared<Instance>();
-	foobar->name = "penis";
-	foobar->setParent(workspace);
-
-	auto replicatedStorage = std::make_shared<Instance>();
-	replicatedStorage->name = "ReplicatedStorage";
-	replicatedStorage->setParent(datamodel);
-
 	const auto currentCamera = std::make_unique<Camera3D>();
 	currentCamera->position = glm::vec3{ 0.0f, 2.0f, 2.0f };
 
-	{
-		const auto part = std::make_shared<Part>();
-		part->name = "Part1";
-		part->position = glm::vec3{ 0.0f, 5.0f, 0.0f };
-		part->size = glm::vec3{ 2.0f, 2.0f, 2.0f };
-		part->setParent(workspace);
+	InstancePtr workspace;
+	std::unique_ptr<StreamingController> streamingController;
+	if (std::filesystem::exists(PLACE_FILENAME)) {
+		auto document = PlaceDeserializer::load(PLACE_FILENAME, datamodel);
+		workspace = datamodel->findFirstChild("Workspace");
+		if (!document.regions.empty()) {
+			streamingController = std::make_unique<StreamingController>(PLACE_FILENAME, std::move(document), StreamingController::Settings{});
+		}
 	}
 
-	{
-		const auto part = std::make_shared<Part>();
-		part->name = "Part2";
-		part->position = glm::vec3{ 0.0f, -2.0f, 0.0f };
-		part->size = glm::vec3{ 7.0f, 1.0f, 7.0f };
-		part->orientation = glm::vec3{ 0.0f, 0.0f, 0.0f };
-		part->setParent(workspace);
+	if (!workspace) {
+		workspace = std::make_shared<Instance>();
+		workspace->name = "Workspace";
+		workspace->setParent(datamodel);
+
+		auto foobar = std::make_shared<Instance>();
+		foobar->name = "penis";
+		foobar->setParent(workspace);
+
+		auto replicatedStorage = std::make_shared<Instance>();
+		replicatedStorage->name = "ReplicatedStorage";
+		replicatedStorage->setParent(datamodel);
+
+		{
+			const auto part = std::make_shared<Part>();
+			part->name = "Part1";
+			part->position = glm::vec3{ 0.0f, 5.0f, 0.0f };
+			part->size = glm::vec3{ 2.0f, 2.0f, 2.0f };
+			part->anchored = false;
+			part->setParent(workspace);
+		}
+
+		{
+			const auto part = std::make_shared<Part>();
+			part->name = "Part2";
+			part->position = glm::vec3{ 0.0f, -2.0f, 0.0f };
+			part->size = glm::vec3{ 7.0f, 1.0f, 7.0f };
+			part->orientation = glm::vec3{ 0.0f, 0.0f, 0.0f };
+			part->setParent(workspace);
+		}
+
+		{
+			const auto script = std::make_shared<Script>();
+			script->name = "Spawner";
+			script->source = R"(
+for i = 1, 4 do
+	local part = Instance.new("Part")
+	part.Name = "Brick" .. i
+	part.Size = Vector3.new(2, 2, 2)
+	part.Position = Vector3.new(0.5 * i, 8 + 3 * i, 0)
+	part.Anchored = false
+	part.Parent = workspace
+	task.wait(0.5)
+end
+)";
+			script->setParent(workspace);
+		}
+
+		{
+			const auto actor = std::make_shared<Actor>();
+			actor->name = "Watcher";
+			actor->setParent(workspace);
+
+			const auto script = std::make_shared<Script>();
+			script->name = "CountUnanchored";
+			script->source = R"(
+while true do
+	task.wait(1)
+	task.desynchronize()
+	local unanchored = 0
+	for _, child in workspace:GetChildren() do
+		if child:IsA("BasePart") and not child.Anchored then
+			unanchored += 1
+		end
+	end
+	task.synchronize()
+	script.Parent.Name = "Watcher: " .. unanchored .. " unanchored"
+end
+)";
+			script->setParent(actor);
+		}
 	}
 
 	IMGUI_CHECKVERSION();
@@ -279,6 +380,29 @@ int main()
 	ImGui_ImplGlfw_InitForOpenGL(window, true);
 	ImGui_ImplOpenGL3_Init("#version 460");
 
+	SpatialIndex spatialIndex;
+	spatialIndex.attach(workspace);
+	std::shared_ptr<BasePart> selectedPart;
+	auto selectionConnection = workspace->descendantRemoving.connect([&selectedPart](InstancePtr inst) {
+		if (inst == selectedPart) selectedPart = nullptr;
+	});
+	bool wasMouseDown = false;
+
+	PhysicsWorld physicsWorld;
+	physicsWorld.attach(workspace);
+
+	RunService runService;
+	runService.bindSimulation([&physicsWorld](double dt) {
+		physicsWorld.step(static_cast<float>(dt));
+	});
+
+	ScriptRuntime scriptRuntime(datamodel);
+	scriptRuntime.start();
+	/* waiting scripts resume once the frame's simulation steps are done */
+	EventConnection schedulerConnection = runService.heartbeat.connect([&scriptRuntime, &runService](double) {
+		scriptRuntime.step(runService.getTime());
+	});
+
 	double oldMouseX = 0.0f, oldMouseY = 0.0f;
 	glfwGetCursorPos(window, &oldMouseX, &oldMouseY);
 
@@ -286,12 +410,16 @@ int main()
 	double lastGlfwTime = 0;
 
 	while (!glfwWindowShouldClose(window)) {
+		profiler.beginFrame();
+		gpuProfiler->beginFrame();
+
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		glClearColor(0.0f, 0.5f, 1.0f, 1.0f);
 
 		glfwTime = glfwGetTime();
 		double deltaTime = glfwTime - lastGlfwTime;
 		lastGlfwTime = glfwTime;
+		frameMilliseconds.record(deltaTime * 1000.0);
 
 		int width, height;
 		glfwGetWindowSize(window, &width, &height);
@@ -346,80 +474,102 @@ int main()
 		if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) {
 			currentCamera->position += glm::vec3{ 0.0f, -10.0f * deltaTime, 0.0f };
 		}
-		glDisable(GL_DEPTH_TEST);
-		glDisable(GL_CULL_FACE);
-		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-		skyboxShader->use();
-		skyboxShader->setInt("skyboxTex", 0);
-		skyboxShader->setMat4("projection", currentCamera->getProjectionMatrix());
-		skyboxShader->setMat4("view", currentCamera->getRotationMatrix());
-		MeshRenderer::draw(*skyboxMesh, { skyboxCubeMapTexture });
-
-		glEnable(GL_DEPTH_TEST);
-		glEnable(GL_CULL_FACE);
-
-		mainShader->use();
-		if (wireframeMode)
-			glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		else
-			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-		mainShader->setMat4("projection", currentCamera->getProjectionMatrix());
-		mainShader->setMat4("view", currentCamera->getViewMatrix());
-
-
+		if (streamingController) {
+			streamingController->update(currentCamera->position);
+		}
 		{
-			mainShader->setInt("useTexture", 1);
-			mainShader->setInt("meshTexture", 0);
-			mainShader->setFloat2("uTile", 1.0f, 1.0f);
-			mainShader->setMat4("model", glm::identity<glm::mat4>());
-			MeshRenderer::draw(*object, std::vector<std::shared_ptr<ITexture>>{pumpkinTexture});
-
-			mainShader->setInt("useTexture", 0);
+			PROFILE_ZONE("RunService");
+			runService.update(deltaTime);
 		}
+		spatialIndex.update();
+
+		bool mouseDown = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+		if (mouseDown && !wasMouseDown && !mouseLocked && !(showUi && io.WantCaptureMouse) && width > 0 && height > 0) {
+			PROFILE_ZONE("Picking");
+			glm::mat4 inverseViewProjection = glm::inverse(currentCamera->getProjectionMatrix() * currentCamera->getViewMatrix());
+			float ndcX = 2.0f * fMouseX / fWidth - 1.0f;
+			float ndcY = 1.0f - 2.0f * fMouseY / fHeight;
+			glm::vec4 nearPoint = inverseViewProjection * glm::vec4{ ndcX, ndcY, -1.0f, 1.0f };
+			glm::vec4 farPoint = inverseViewProjection * glm::vec4{ ndcX, ndcY, 1.0f, 1.0f };
+			glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+			glm::vec3 direction = glm::normalize(glm::vec3(farPoint) / farPoint.w - origin);
+
+			auto result = spatialIndex.raycast(origin, direction * PICK_DISTANCE);
+			selectedPart = result ? result->part : nullptr;
+		}
+		wasMouseDown = mouseDown;
 
 		{
-			auto model = glm::identity<glm::mat4>();
-			model = glm::translate(model, glm::vec3{ 0.0f, 1.5f, 0.0f });
-			mainShader->setMat4("model", model);
+			PROFILE_ZONE("Skybox");
+			GpuZone gpuZone(*gpuProfiler, "Skybox");
 
-			mainShader->setInt("useTexture", 1);
-			mainShader->setInt("meshTexture", 0);
-			mainShader->setFloat2("uTile", 1.0f, 1.0f);
-
-			MeshRenderer::draw(*object1, std::vector<std::shared_ptr<ITexture>>{vegetableTexture});
+			glDisable(GL_DEPTH_TEST);
+			glDisable(GL_CULL_FACE);
+			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-			mainShader->setInt("useTexture", 0);
+			skyboxShader->use();
+			skyboxShader->setInt("skyboxTex", 0);
+			skyboxShader->setMat4("projection", currentCamera->getProjectionMatrix());
+			skyboxShader->setMat4("view", currentCamera->getRotationMatrix());
+			MeshRenderer::draw(*skyboxMesh, { skyboxCubeMapTexture });
 		}
+
 		{
-			auto model = glm::identity<glm::mat4>();
-			model = glm::translate(model, glm::vec3{ 0.0f, 3.2f, -3.0f });
-			mainShader->setFloat2("uTile", 1.0f, 1.0f);
-			mainShader->setMat4("model", model);
-			MeshRenderer::draw(*object2);
-		}
+			PROFILE_ZONE("Scene");
+			GpuZone gpuZone(*gpuProfiler, "Scene");
+
+			glEnable(GL_DEPTH_TEST);
+			glEnable(GL_CULL_FACE);
+
+			mainShader->use();
+			if (wireframeMode)
+				glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+			else
+				glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+			mainShader->setMat4("projection", currentCamera->getProjectionMatrix());
+			mainShader->setMat4("view", currentCamera->getViewMatrix());
+
+			/* everything static goes out in one multi-draw per texture set */
+			sceneBatch.clear();
+			{
+				const auto model = glm::identity<glm::mat4>();
+				sceneBatch.add(*object, MeshRenderer::selectLod(*object, model, *currentCamera, fHeight, lodPixelError), model, { pumpkinTexture });
+			}
+			{
+				const auto model = glm::translate(glm::identity<glm::mat4>(), glm::vec3{ 0.0f, 1.5f, 0.0f });
+				sceneBatch.add(*object1, MeshRenderer::selectLod(*object1, model, *currentCamera, fHeight, lodPixelError), model, { vegetableTexture });
+			}
+			{
+				const auto model = glm::translate(glm::identity<glm::mat4>(), glm::vec3{ 0.0f, 3.2f, -3.0f });
+				sceneBatch.add(*object2, MeshRenderer::selectLod(*object2, model, *currentCamera, fHeight, lodPixelError), model);
+			}
 
-		for (const auto& inst : workspace->getDescendants()) {
-			if (inst->getClassName() == "Part") {
-				auto part = std::dynamic_pointer_cast<Part>(inst);
-				if (part) {
-					auto model = glm::identity<glm::mat4>();
-					model = glm::translate(model, part->position);
-					model = glm::rotate(model, glm::radians(part->orientation.y), glm::vec3{ 0.0f, 1.0f, 0.0f });
-					model = glm::scale(model, part->size);
-					mainShader->setMat4("model", model);
-					
-					mainShader->setInt("useTexture", 1);
-					mainShader->setInt("meshTexture", 0);
-					mainShader->setFloat2("uTile", 1.0f, 1.0f);
-					MeshRenderer::draw(*partMesh, std::vector<std::shared_ptr<ITexture>>{plasticStudsTexture});
-					mainShader->setInt("useTexture", 0);
+			const float interpolationAlpha = static_cast<float>(runService.getInterpolationAlpha());
+			for (const auto& inst : workspace->getDescendants()) {
+				if (inst->getClassName() == "Part") {
+					auto part = std::dynamic_pointer_cast<Part>(inst);
+					if (part) {
+						const auto interpolated = physicsWorld.getInterpolatedModelMatrix(part.get(), interpolationAlpha);
+						const glm::mat4 model = interpolated ? *interpolated : part->getModelMatrix();
+						sceneBatch.add(*partMesh, MeshRenderer::selectLod(*partMesh, model, *currentCamera, fHeight, lodPixelError), model, { plasticStudsTexture });
+					}
 				}
 			}
+
+			mainShader->setInt("meshTexture", 0);
+			mainShader->setFloat2("uTile", 1.0f, 1.0f);
+			sceneBatch.draw([&mainShader](const IndirectBatch::Textures& textures) {
+				mainShader->setInt("useTexture", textures.empty() ? 0 : 1);
+				MeshRenderer::bindTextures(textures);
+			});
+			mainShader->setInt("useTexture", 0);
 		}
 
 		if (showUi) {
+			PROFILE_ZONE("ImGui");
+			GpuZone gpuZone(*gpuProfiler, "ImGui");
+
 			ImGui_ImplOpenGL3_NewFrame();
 			ImGui_ImplGlfw_NewFrame();
 			ImGui::NewFrame();
@@ -429,26 +579,86 @@ int main()
 			if (ImGui::Button("Wireframe Mode")) {
 				wireframeMode = !wireframeMode;
 			}
+			/* a streamed session only holds part of the place, saving it would drop the rest */
+			ImGui::BeginDisabled(streamingController != nullptr);
+			if (ImGui::Button("Save Place")) {
+				PlaceSerializer::serialize(datamodel, PLACE_FILENAME, saveStreamed ? STREAMING_REGION_SIZE : 0.0f);
+			}
+			ImGui::SameLine();
+			ImGui::Checkbox("Streamed", &saveStreamed);
+			ImGui::EndDisabled();
+			ImGui::SameLine();
+			ImGui::Checkbox("Profiler", &showProfiler);
+			ImGui::SliderFloat("LOD Pixel Error", &lodPixelError, 0.0f, 8.0f, "%.1f px");
 			ImGui::Separator();
 			ImGui::Text("FPS: %.2f", 1.0f/deltaTime );
 			ImGui::Separator();
 			ImGui::Text("Camera Position: (%.2f, %.2f, %.2f)", currentCamera->position.x, currentCamera->position.y, currentCamera->position.z);
 			ImGui::Text("Camera Rotation: (%.2f, %.2f, %.2f)", currentCamera->rotation.x, currentCamera->rotation.y, currentCamera->rotation.z);
+			if (streamingController) {
+				ImGui::Text("Streaming Regions: %zu/%zu (%zu pending)", streamingController->getLoadedRegionCount(), streamingController->getRegionCount(), streamingController->getPendingRegionCount());
+				ImGui::Text("Streaming Memory: %.2f MB", streamingController->getMemoryUsage() / (1024.0 * 1024.0));
+			}
+
+			const auto& resourceStats = resourceManager.getStats();
+			ImGui::Text("Resources: %u meshes, %u textures, %.1f MB GPU, %zu evicted%s", resourceManager.meshManager.count(), resourceManager.texture2DManager.count() + resourceManager.textureCubeMapManager.count(), resourceStats.gpuBytes / (1024.0 * 1024.0), static_cast<size_t>(resourceStats.evictedCount), resourceStats.overBudget ? " (over budget)" : "");
+			ImGui::Text("Indexed Parts: %zu", spatialIndex.size());
+			const auto& runStats = runService.getStats();
+			ImGui::Text("Simulation: %d steps, %.2f ms (%.2f s dropped)", runStats.stepsLastFrame, runStats.simulationMilliseconds, runStats.droppedSeconds);
+			const auto& runtimeStats = scriptRuntime.getStats();
+			ImGui::Text("Scripts: %zu actors, %.2f ms serial, %.2f ms parallel", runtimeStats.actorCount, runtimeStats.serialMilliseconds, runtimeStats.parallelMilliseconds);
+			for (const auto& context : scriptRuntime.getContexts()) {
+				const auto& schedulerStats = context->getScheduler().getStats();
+				ImGui::Text(" %s: %zu resumed, %zu ready, %zu waiting", context->getActor() ? context->getActor()->name.c_str() : "Main", schedulerStats.resumedLastStep, schedulerStats.readyCount + schedulerStats.parallelReadyCount, schedulerStats.waitingCount);
+				for (const auto& scriptStats : context->getScheduler().getScriptStats()) {
+					ImGui::Text("  %s: %.2f ms (%.1f ms total)", scriptStats.name.c_str(), scriptStats.frameMilliseconds, scriptStats.totalMilliseconds);
+				}
+			}
+			const auto& physicsStats = physicsWorld.getStats();
+			ImGui::Text("Physics: %zu/%zu awake, %zu contacts, %zu islands, %.2f ms", physicsStats.awakeBodyCount, physicsStats.bodyCount, physicsStats.contactCount, physicsStats.islandCount, physicsStats.stepMilliseconds);
+			if (selectedPart) {
+				ImGui::Text("Selected: %s (%.2f, %.2f, %.2f)", selectedPart->name.c_str(), selectedPart->position.x, selectedPart->position.y, selectedPart->position.z);
+			}
+
+			if (ImGui::CollapsingHeader("Stats")) {
+				if (ImGui::Button("Dump Stats")) stats.writeJson(STATS_FILENAME);
+				const auto snapshot = stats.snapshot();
+				for (const auto& counter : snapshot.counters) {
+					ImGui::Text("%s: %lld (%lld total)", counter.name.c_str(), static_cast<long long>(counter.lastFrame), static_cast<long long>(counter.total));
+				}
+				for (const auto& gauge : snapshot.gauges) {
+					ImGui::Text("%s: %lld (peak %lld)", gauge.name.c_str(), static_cast<long long>(gauge.value), static_cast<long long>(gauge.peak));
+				}
+				for (const auto& histogram : snapshot.histograms) {
+					ImGui::Text("%s: mean %.2f, p50 %.2f, p95 %.2f, p99 %.2f, max %.2f", histogram.name.c_str(), histogram.mean, histogram.p50, histogram.p95, histogram.p99, histogram.max);
+				}
+			}
 
 			ImGui::Text("@ Explorer");
 			DrawInstanceTree(datamodel);
 
 			ImGui::End();
 
+			if (showProfiler) profilerWindow.draw();
+
 			ImGui::Render();
 			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 		}
 
-		glfwSwapBuffers(window);
+		{
+			PROFILE_ZONE("Swap");
+			glfwSwapBuffers(window);
+		}
 		glfwPollEvents();
+		resourceManager.enforceBudgets();
+		/* evictions leave holes in the shared mesh buffers, closed here while nothing is being drawn */
+		MeshArena::defragmentAll();
+		profiler.endFrame();
+		stats.endFrame();
 	}
 
 	/* DEINIT */
+	gpuProfiler.reset();
 	ImGui_ImplOpenGL3_Shutdown();
 	ImGui_ImplGlfw_Shutdown();
 	ImGui::DestroyContext();
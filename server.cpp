@@ -0,0 +1,144 @@
+/* STD DEPENDENCIES */
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <print>
+#include <string>
+#include <thread>
+
+/* INSTANCES */
+#include <Instance/Instance.h>
+#include <Instance/DataModel.h>
+
+/* PLACE SERIALIZER */
+#include <PlaceSerializer/PlaceDeserializer.h>
+
+/* SIMULATION */
+#include <Physics/PhysicsWorld.h>
+#include <Runtime/RunService.h>
+#include <Scripting/ScriptRuntime.h>
+#include <Profiling/StatsRegistry.h>
+
+/* CONSTANTS */
+#define PLACE_FILENAME "./resources/place.elplace"
+#define TICK_RATE 60.0
+#define STATS_INTERVAL 5.0
+
+/*
+ * Headless server: loads a place and steps its DataModel at a fixed tick rate until SIGINT /
+ * SIGTERM, or for a set number of simulated seconds. With a stats file the StatsRegistry is written
+ * there every stats interval and on exit.
+ *   GameEngineServer [place] [tick rate] [seconds] [stats file]
+ */
+
+static std::atomic<bool> running{ true };
+
+static void stopRunning(int) {
+	running = false;
+}
+
+/* the server owns the whole place, regions are loaded up front instead of streamed */
+static size_t loadAllRegions(const std::string& filename, const PlaceDocument& document) {
+	size_t instanceCount = 0;
+	for (const auto& region : document.regions) {
+		auto contents = PlaceDeserializer::deserializeRegion(filename, region);
+		for (auto& [root, parentReferent] : contents.roots) {
+			if (parentReferent < 0 || static_cast<size_t>(parentReferent) >= document.referents.size()) continue;
+			if (auto parent = document.referents[parentReferent].lock()) root->setParent(parent);
+		}
+		instanceCount += contents.instanceCount;
+	}
+	return instanceCount;
+}
+
+int main(int argc, char** argv) {
+	const std::string placeFilename = argc > 1 ? argv[1] : PLACE_FILENAME;
+	const double tickRate = argc > 2 ? std::atof(argv[2]) : TICK_RATE;
+	const double runSeconds = argc > 3 ? std::atof(argv[3]) : 0.0;
+	const std::string statsFilename = argc > 4 ? argv[4] : "";
+	if (tickRate <= 0.0) {
+		std::println("Tick rate must be positive");
+		return EXIT_FAILURE;
+	}
+	if (!std::filesystem::exists(placeFilename)) {
+		std::println("Place not found: {}", placeFilename);
+		return EXIT_FAILURE;
+	}
+
+	std::signal(SIGINT, stopRunning);
+	std::signal(SIGTERM, stopRunning);
+
+	auto datamodel = DataModel::getInstance();
+	datamodel->name = "Game";
+
+	const auto document = PlaceDeserializer::load(placeFilename, datamodel);
+	const size_t streamedCount = loadAllRegions(placeFilename, document);
+	const auto workspace = datamodel->findFirstChild("Workspace");
+	if (!workspace) {
+		std::println("Place has no Workspace: {}", placeFilename);
+		return EXIT_FAILURE;
+	}
+	std::println("Loaded {} ({} regions, {} streamed instances)", placeFilename, document.regions.size(), streamedCount);
+
+	PhysicsWorld physicsWorld;
+	physicsWorld.attach(workspace);
+
+	RunService::Settings runSettings;
+	runSettings.fixedDeltaTime = 1.0 / tickRate;
+	RunService runService(runSettings);
+	runService.bindSimulation([&physicsWorld](double dt) {
+		physicsWorld.step(static_cast<float>(dt));
+	});
+
+	ScriptRuntime scriptRuntime(datamodel);
+	scriptRuntime.start();
+	EventConnection schedulerConnection = runService.heartbeat.connect([&scriptRuntime, &runService](double) {
+		scriptRuntime.step(runService.getTime());
+	});
+
+	using Clock = std::chrono::steady_clock;
+	const auto tickPeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / tickRate));
+	auto lastTick = Clock::now();
+	auto nextTick = lastTick + tickPeriod;
+	double nextStatsTime = STATS_INTERVAL;
+	StatsRegistry& stats = StatsRegistry::getInstance();
+	auto& tickMilliseconds = stats.histogram("Tick/Milliseconds");
+	auto writeStats = [&stats, &statsFilename]() {
+		if (!statsFilename.empty() && !stats.writeJson(statsFilename)) std::println("Cannot write stats to {}", statsFilename);
+	};
+
+	std::println("Running at {} Hz", tickRate);
+	while (running) {
+		std::this_thread::sleep_until(nextTick);
+		const auto now = Clock::now();
+		runService.update(std::chrono::duration<double>(now - lastTick).count());
+		lastTick = now;
+		tickMilliseconds.record(std::chrono::duration<double, std::milli>(Clock::now() - now).count());
+		stats.endFrame();
+
+		/* a late tick is not made up with a burst, RunService already caught the simulation up */
+		nextTick += tickPeriod;
+		if (nextTick < now) nextTick = now + tickPeriod;
+
+		const double time = runService.getTime();
+		if (time >= nextStatsTime) {
+			nextStatsTime += STATS_INTERVAL;
+			const auto& runStats = runService.getStats();
+			const auto& physicsStats = physicsWorld.getStats();
+			const auto& scriptStats = scriptRuntime.getStats();
+			std::println("[{:.0f}s] {} steps, {:.2f}s dropped | physics {}/{} awake, {:.2f} ms | scripts {:.2f} ms serial, {:.2f} ms parallel",
+				time, runStats.stepCount, runStats.droppedSeconds,
+				physicsStats.awakeBodyCount, physicsStats.bodyCount, physicsStats.stepMilliseconds,
+				scriptStats.serialMilliseconds, scriptStats.parallelMilliseconds);
+			writeStats();
+		}
+		if (runSeconds > 0.0 && time >= runSeconds) break;
+	}
+
+	writeStats();
+	std::println("Stopped after {:.2f}s simulated", runService.getTime());
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,197 @@
+#include <Asset/AssetArchive.h>
+#include <Util/Hash.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <unordered_map>
+#include <utility>
+
+using namespace AssetArchiveFormat;
+
+namespace {
+	uint64_t alignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+AssetArchive& AssetArchive::getInstance() {
+	static AssetArchive instance;
+	return instance;
+}
+
+std::string AssetArchive::normalizePath(std::string_view path) {
+	std::string generic(path);
+	std::replace(generic.begin(), generic.end(), '\\', '/');
+	std::string normal = std::filesystem::path(generic).lexically_normal().generic_string();
+	while (normal.starts_with("./")) normal.erase(0, 2);
+	return normal;
+}
+
+AssetId AssetArchive::getId(std::string_view path) {
+	return Hash::fnv1a(normalizePath(path));
+}
+
+AssetType AssetArchive::getType(std::string_view path) {
+	std::string extension = std::filesystem::path(path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	if (extension == ".glb" || extension == ".emesh") return AssetType::Mesh;
+	if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp") return AssetType::Texture;
+	return AssetType::Unknown;
+}
+
+bool AssetArchive::mount(const std::string& filename) {
+	unmount();
+	auto fail = [this, &filename](const char* reason) {
+		std::println("Cannot mount asset archive {}: {}", filename, reason);
+		unmount();
+		return false;
+	};
+
+	if (!m_file.open(filename)) return fail("cannot open file");
+	const auto bytes = m_file.getBytes();
+
+	Header header{};
+	if (bytes.size() < sizeof(header)) return fail("truncated header");
+	std::memcpy(&header, bytes.data(), sizeof(header));
+	if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) return fail("bad magic");
+	if (header.version != version) return fail("unsupported version");
+
+	const uint64_t tocSize = static_cast<uint64_t>(header.entryCount) * sizeof(TocEntry);
+	if (header.tocOffset % alignof(TocEntry) != 0 || header.tocOffset > bytes.size() || tocSize > bytes.size() - header.tocOffset) return fail("table of contents out of range");
+	if (header.stringsOffset > bytes.size() || header.stringsSize > bytes.size() - header.stringsOffset) return fail("strings out of range");
+
+	m_toc = { reinterpret_cast<const TocEntry*>(bytes.data() + header.tocOffset), header.entryCount };
+	m_strings = { reinterpret_cast<const char*>(bytes.data() + header.stringsOffset), static_cast<size_t>(header.stringsSize) };
+	for (size_t i = 0; i < m_toc.size(); ++i) {
+		const auto& entry = m_toc[i];
+		if (entry.offset > bytes.size() || entry.size > bytes.size() - entry.offset) return fail("entry out of range");
+		if (entry.pathOffset >= m_strings.size()) return fail("entry path out of range");
+		if (i > 0 && m_toc[i - 1].id >= entry.id) return fail("table of contents not sorted");
+	}
+	if (!m_strings.empty() && m_strings.back() != '\0') return fail("strings not terminated");
+
+	std::println("Mounted asset archive {} ({} entries)", filename, m_toc.size());
+	return true;
+}
+
+void AssetArchive::unmount() {
+	m_toc = {};
+	m_strings = {};
+	m_file.close();
+}
+
+AssetArchive::Entry AssetArchive::getEntry(size_t index) const {
+	const auto& entry = m_toc[index];
+	return {
+		entry.id,
+		entry.contentHash,
+		entry.type,
+		std::string_view(m_strings.data() + entry.pathOffset),
+		m_file.getBytes().subspan(static_cast<size_t>(entry.offset), static_cast<size_t>(entry.size)),
+	};
+}
+
+std::optional<AssetArchive::Entry> AssetArchive::find(AssetId id) const {
+	auto it = std::lower_bound(m_toc.begin(), m_toc.end(), id, [](const TocEntry& entry, AssetId wanted) { return entry.id < wanted; });
+	if (it == m_toc.end() || it->id != id) return std::nullopt;
+	return getEntry(static_cast<size_t>(it - m_toc.begin()));
+}
+
+void AssetArchiveWriter::add(std::string path, std::vector<uint8_t> bytes) {
+	path = AssetArchive::normalizePath(path);
+	auto it = std::find_if(m_assets.begin(), m_assets.end(), [&path](const Asset& asset) { return asset.path == path; });
+	if (it != m_assets.end()) it->bytes = std::move(bytes);
+	else m_assets.push_back({ std::move(path), std::move(bytes) });
+}
+
+bool AssetArchiveWriter::write(const std::string& filename) const {
+	std::vector<TocEntry> toc;
+	toc.reserve(m_assets.size());
+	std::string strings;
+	std::vector<const Asset*> blobs;
+	/* content hash -> blobs holding it, the bytes are compared so a hash collision can't merge two assets */
+	std::unordered_map<uint64_t, std::vector<size_t>> blobsByHash;
+	std::vector<size_t> blobOfEntry;
+
+	for (const auto& asset : m_assets) {
+		TocEntry entry{};
+		entry.id = AssetArchive::getId(asset.path);
+		entry.contentHash = Hash::fnv1a(asset.bytes.data(), asset.bytes.size());
+		entry.size = asset.bytes.size();
+		entry.type = AssetArchive::getType(asset.path);
+		entry.pathOffset = static_cast<uint32_t>(strings.size());
+		strings += asset.path;
+		strings += '\0';
+
+		auto& sameHash = blobsByHash[entry.contentHash];
+		auto blob = std::find_if(sameHash.begin(), sameHash.end(), [&](size_t index) { return blobs[index]->bytes == asset.bytes; });
+		if (blob != sameHash.end()) {
+			blobOfEntry.push_back(*blob);
+		}
+		else {
+			sameHash.push_back(blobs.size());
+			blobOfEntry.push_back(blobs.size());
+			blobs.push_back(&asset);
+		}
+		toc.push_back(entry);
+	}
+
+	for (size_t i = 1; i < toc.size(); ++i) {
+		for (size_t j = 0; j < i; ++j) {
+			if (toc[i].id == toc[j].id) {
+				std::println("Asset id collision between {} and {}", m_assets[j].path, m_assets[i].path);
+				return false;
+			}
+		}
+	}
+
+	std::vector<uint64_t> blobOffsets;
+	uint64_t offset = alignUp(sizeof(Header), alignment);
+	for (const auto* blob : blobs) {
+		blobOffsets.push_back(offset);
+		offset = alignUp(offset + blob->bytes.size(), alignment);
+	}
+	for (size_t i = 0; i < toc.size(); ++i) toc[i].offset = blobOffsets[blobOfEntry[i]];
+	std::sort(toc.begin(), toc.end(), [](const TocEntry& a, const TocEntry& b) { return a.id < b.id; });
+
+	Header header{};
+	std::memcpy(header.magic, magic, sizeof(magic));
+	header.version = version;
+	header.entryCount = static_cast<uint32_t>(toc.size());
+	header.tocOffset = offset;
+	header.stringsOffset = offset + toc.size() * sizeof(TocEntry);
+	header.stringsSize = strings.size();
+	header.alignment = alignment;
+
+	const auto temporary = filename + ".tmp";
+	{
+		std::ofstream file{ temporary, std::ios::binary | std::ios::trunc };
+		if (!file.is_open()) return false;
+		auto padTo = [&file](uint64_t position) {
+			static const char zeros[alignment] = {};
+			const auto current = static_cast<uint64_t>(file.tellp());
+			if (position > current) file.write(zeros, static_cast<std::streamsize>(position - current));
+		};
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (size_t i = 0; i < blobs.size(); ++i) {
+			padTo(blobOffsets[i]);
+			file.write(reinterpret_cast<const char*>(blobs[i]->bytes.data()), static_cast<std::streamsize>(blobs[i]->bytes.size()));
+		}
+		padTo(header.tocOffset);
+		file.write(reinterpret_cast<const char*>(toc.data()), static_cast<std::streamsize>(toc.size() * sizeof(TocEntry)));
+		file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+		if (!file.good()) return false;
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporary, filename, error);
+	if (error) {
+		std::filesystem::remove(temporary, error);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,32 @@
+#include <Instance/BasePart.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+glm::mat3 BasePart::orientationToMatrix(const glm::vec3& orientation) {
+	glm::mat4 mat = glm::identity<glm::mat4>();
+	mat = glm::rotate(mat, glm::radians(orientation.y), glm::vec3{ 0.0f, 1.0f, 0.0f });
+	mat = glm::rotate(mat, glm::radians(orientation.x), glm::vec3{ 1.0f, 0.0f, 0.0f });
+	mat = glm::rotate(mat, glm::radians(orientation.z), glm::vec3{ 0.0f, 0.0f, 1.0f });
+	return glm::mat3(mat);
+}
+
+glm::mat3 BasePart::getRotationMatrix() const {
+	return orientationToMatrix(orientation);
+}
+
+glm::mat4 BasePart::getModelMatrix() const {
+	glm::mat4 model = glm::mat4(getRotationMatrix());
+	model[3] = glm::vec4(position, 1.0f);
+	return glm::scale(model, size);
+}
+
+void BasePart::getBounds(glm::vec3& outMin, glm::vec3& outMax) const {
+	const glm::mat3 rotation = getRotationMatrix();
+	const glm::vec3 halfSize = size * 0.5f;
+	glm::vec3 extent{ 0.0f };
+	for (int axis = 0; axis < 3; ++axis) {
+		extent += glm::abs(rotation[axis]) * halfSize[axis];
+	}
+	outMin = position - extent;
+	outMax = position + extent;
+}
@@ -1,13 +1,33 @@
 #include <Instance/Instance.h>
+#include <Instance/InstanceFactory.h>
 #include <Event/Event.h>
+#include <Profiling/StatsRegistry.h>
 #include <memory>
 #include <string>
 #include <optional>
 #include <mutex>
 #include <algorithm>
+#include <stdexcept>
 #include <typeinfo>
 #include <vector>
 
+namespace {
+    StatsRegistry::Gauge& liveInstances() {
+        static auto& gauge = StatsRegistry::getInstance().gauge("Instance/Live");
+        return gauge;
+    }
+}
+
+Instance::Instance() {
+    static auto& created = StatsRegistry::getInstance().counter("Instance/Created");
+    created.add();
+    liveInstances().add(1);
+}
+
+Instance::~Instance() {
+    liveInstances().sub(1);
+}
+
 InstancePtr Instance::findFirstChild(const std::string& name) {
     std::lock_guard<std::mutex> lock(m_mutexChildren);
     for (const auto& c : m_children) {
@@ -81,17 +101,57 @@ std::vector<InstancePtr> Instance::getChildren() const {
     return m_children;
 }
 
-void Instance::setParent(const InstancePtr& newParent) {
-    if (newParent == nullptr) {
-        parent = newParent;
-        return;
+static void fireDescendantEvent(Event<InstancePtr> Instance::* event, InstancePtr ancestor, const std::vector<InstancePtr>& subtree) {
+    while (ancestor) {
+        for (const auto& inst : subtree) {
+            try { (ancestor.get()->*event).fire(inst); }
+            catch (...) {}
+        }
+        ancestor = ancestor->parent.lock();
+    }
+}
+
+static std::vector<InstancePtr> collectSubtree(const InstancePtr& self) {
+    std::vector<InstancePtr> subtree{ self };
+    if (!self->getChildren().empty()) {
+        auto descendants = self->getDescendants();
+        subtree.insert(subtree.end(), descendants.begin(), descendants.end());
+    }
+    return subtree;
+}
+
+bool Instance::isAncestorOf(const Instance* descendant) const {
+    InstancePtr cur;
+    while (descendant) {
+        if (descendant == this) return true;
+        cur = descendant->parent.lock();
+        descendant = cur.get();
     }
+    return false;
+}
+
+void Instance::setParent(const InstancePtr& newParent) {
     InstancePtr oldParent = parent.lock();
 
     if (oldParent == newParent) {
         return;
     }
+    // a cycle would never reach a root, so the ancestor walks below wouldn't end
+    if (isAncestorOf(newParent.get())) {
+        throw std::runtime_error("Attempt to set parent of " + name + " to " + newParent->name + " would result in circular reference");
+    }
 
+    const auto subtree = collectSubtree(shared_from_this());
+    if (oldParent) {
+        fireDescendantEvent(&Instance::descendantRemoving, oldParent, subtree);
+    }
+    setParentLocked(oldParent, newParent);
+    if (newParent) {
+        fireDescendantEvent(&Instance::descendantAdded, newParent, subtree);
+    }
+}
+
+void Instance::setParentLocked(const InstancePtr& oldParent, const InstancePtr& newParent) {
     std::vector<std::mutex*> mutexPtrs;
     mutexPtrs.push_back(&m_mutexChildren);
     if (oldParent) mutexPtrs.push_back(&oldParent->m_mutexChildren);
@@ -118,16 +178,10 @@ void Instance::setParent(const InstancePtr& newParent) {
     }
 
     if (newParent) {
-        auto& newChildren = newParent->m_children;
-        bool found = false;
-        for (const auto& c : newChildren) {
-            if (c.get() == this) { found = true; break; }
-        }
-        if (!found) {
-            newChildren.push_back(shared_from_this());
-            try { newParent->childAdded.fire(); }
-            catch (...) {}
-        }
+        // parent is only assigned alongside the children list, so this can't already be a child
+        newParent->m_children.push_back(shared_from_this());
+        try { newParent->childAdded.fire(); }
+        catch (...) {}
         parent = newParent;
     }
     else {
@@ -148,6 +202,9 @@ void Instance::destroy() {
 
     InstancePtr par = parent.lock();
     if (par) {
+        try { fireDescendantEvent(&Instance::descendantRemoving, par, { shared_from_this() }); }
+        catch (const std::bad_weak_ptr&) {}
+
         std::mutex* a = &m_mutexChildren;
         std::mutex* b = &par->m_mutexChildren;
         if (a == b) {
@@ -204,6 +261,10 @@ InstancePtr Instance::clone() const {
 }
 
 std::string Instance::getClassName() {
+    if (const auto registered = InstanceFactory::getInstance().getClassName(*this)) {
+        return *registered;
+    }
+
     std::string rawName = typeid(*this).name();
 
     const std::string classPrefix = "class ";
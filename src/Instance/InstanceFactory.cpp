@@ -0,0 +1,48 @@
+#include <Instance/InstanceFactory.h>
+#include <Instance/Instance.h>
+#include <Instance/DataModel.h>
+#include <Instance/BasePart.h>
+#include <Instance/Part.h>
+#include <Instance/Script.h>
+#include <Instance/Actor.h>
+#include <memory>
+#include <string>
+
+InstanceFactory& InstanceFactory::getInstance() {
+	static InstanceFactory instance;
+	return instance;
+}
+
+InstanceFactory::InstanceFactory() {
+	registerClass<Instance>("Instance");
+	registerClass<DataModel>("DataModel");
+	registerClass<BasePart>("BasePart");
+	registerClass<Part>("Part");
+	registerClass<Script>("Script");
+	registerClass<Actor>("Actor");
+}
+
+void InstanceFactory::registerClass(const std::string& className, const std::type_info& type, Creator creator) {
+	m_creators[className] = std::move(creator);
+	m_classNames[std::type_index(type)] = className;
+}
+
+InstancePtr InstanceFactory::create(const std::string& className) const {
+	auto it = m_creators.find(className);
+	if (it == m_creators.end()) {
+		return nullptr;
+	}
+	return it->second();
+}
+
+bool InstanceFactory::isRegistered(const std::string& className) const {
+	return m_creators.contains(className);
+}
+
+const std::string* InstanceFactory::getClassName(const Instance& instance) const {
+	auto it = m_classNames.find(std::type_index(typeid(instance)));
+	if (it == m_classNames.end()) {
+		return nullptr;
+	}
+	return &it->second;
+}
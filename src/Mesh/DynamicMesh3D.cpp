@@ -1,66 +1,226 @@
 #include <Mesh/DynamicMesh3D.h>
+#include <Profiling/StatsRegistry.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 #include <glad/glad.h>
 
-DynamicMesh3D::DynamicMesh3D() : m_vao(0), m_vbo(0), m_ebo(0), m_indexCount(0) {}
+namespace {
+	/* per region, so small meshes that grow a little don't reallocate right away */
+	constexpr size_t minimumVertexCapacity = 256;
+	constexpr size_t minimumIndexCapacity = 1024;
+	constexpr GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
 
-DynamicMesh3D::DynamicMesh3D(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-	m_indexCount = static_cast<GLsizei>(indices.size());
-	constexpr GLsizei vertexSize = sizeof(Vertex);
+	StatsRegistry::Gauge& bufferBytes() {
+		static auto& gauge = StatsRegistry::getInstance().gauge("GPU/BufferBytes");
+		return gauge;
+	}
 
-	glGenVertexArrays(1, &m_vao);
-	glBindVertexArray(m_vao);
+	GLuint createMappedBuffer(size_t byteSize, uint8_t*& mapped) {
+		GLuint buffer = 0;
+		glCreateBuffers(1, &buffer);
+		glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(byteSize), nullptr, mapFlags);
+		mapped = static_cast<uint8_t*>(glMapNamedBufferRange(buffer, 0, static_cast<GLsizeiptr>(byteSize), mapFlags));
+		if (!mapped) throw std::runtime_error("DynamicMesh3D: cannot map buffer");
+		return buffer;
+	}
 
-	glGenBuffers(1, &m_vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_DYNAMIC_DRAW);
-
-	glGenBuffers(1, &m_ebo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_DYNAMIC_DRAW);
-
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, vertexSize, reinterpret_cast<void*>(offsetof(Vertex, position)));
-	glEnableVertexAttribArray(0);
-	
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, vertexSize, reinterpret_cast<void*>(offsetof(Vertex, normal)));
-	glEnableVertexAttribArray(1);
-	
-	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, vertexSize, reinterpret_cast<void*>(offsetof(Vertex, vertexColor)));
-	glEnableVertexAttribArray(2);
-	
-	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, vertexSize, reinterpret_cast<void*>(offsetof(Vertex, textureCoords)));
-	glEnableVertexAttribArray(3);
+	void waitFence(GLsync& fence) {
+		static auto& stalls = StatsRegistry::getInstance().counter("Render/StreamStalls");
+		if (!fence) return;
+		GLenum status = glClientWaitSync(fence, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED) {
+			stalls.add();
+			do {
+				status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+			} while (status == GL_TIMEOUT_EXPIRED);
+		}
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
 
-	glBindVertexArray(0);
+DynamicMesh3D::DynamicMesh3D(const VertexLayout& layout) : m_layout(layout) {
+	glCreateVertexArrays(1, &m_vao);
+	m_layout.apply(m_vao);
 }
 
-GLuint DynamicMesh3D::getVAO() const {
-	return m_vao;
+DynamicMesh3D::DynamicMesh3D(std::span<const Vertex> vertices, std::span<const uint32_t> indices, const VertexLayout& layout) : DynamicMesh3D(layout) {
+	updateVBO(vertices);
+	updateEBO(indices);
 }
+
 DynamicMesh3D::~DynamicMesh3D() {
+	releaseBuffers();
 	if (m_vao) glDeleteVertexArrays(1, &m_vao);
-	if (m_vbo) glDeleteBuffers(1, &m_vbo);
-	if (m_ebo) glDeleteBuffers(1, &m_ebo);
 
 	m_vao = 0;
-	m_vbo = 0;
-	m_ebo = 0;
 	m_indexCount = 0;
 }
+
+GLuint DynamicMesh3D::getVAO() const {
+	return m_vao;
+}
+
 GLsizei DynamicMesh3D::getIndicesCount() const {
 	return m_indexCount;
 }
 
-void DynamicMesh3D::updateVBO(const std::vector<Vertex>& vertices) const
-{
-	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+GLenum DynamicMesh3D::getIndexType() const {
+	return m_indexType;
+}
+
+GLint DynamicMesh3D::getBaseVertex() const {
+	return static_cast<GLint>(m_region * m_vertexCapacity);
+}
+
+GLuint DynamicMesh3D::getFirstIndex() const {
+	return static_cast<GLuint>(m_region * m_indexCapacity / VertexLayout::getIndexSize(m_indexType));
+}
+
+void DynamicMesh3D::onDrawn() const {
+	m_inFlight = true;
+}
+
+void DynamicMesh3D::updateVBO(std::span<const Vertex> vertices) {
+	m_vertexCount = 0;
+	updateVBO(0, vertices);
+}
+
+void DynamicMesh3D::updateEBO(std::span<const uint32_t> indices) {
+	m_indices.clear();
+	updateEBO(0, indices);
 }
 
-void DynamicMesh3D::updateEBO(const std::vector<unsigned int>& indices) const
-{
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-}
\ No newline at end of file
+void DynamicMesh3D::updateVBO(size_t first, std::span<const Vertex> vertices) {
+	if (first > m_vertexCount) throw std::runtime_error("DynamicMesh3D: vertices written past the end");
+	beginWrite();
+
+	const size_t stride = static_cast<size_t>(m_layout.getStride());
+	const size_t end = first + vertices.size();
+	m_vertexCount = std::max(m_vertexCount, end);
+	m_vertexData.resize(m_vertexCount * stride);
+	if (m_layout.isFull()) {
+		if (!vertices.empty()) std::memcpy(m_vertexData.data() + first * stride, vertices.data(), vertices.size() * stride);
+	}
+	else {
+		const auto packed = m_layout.pack(vertices);
+		std::copy(packed.begin(), packed.end(), m_vertexData.begin() + first * stride);
+	}
+	markDirty(first, end, 0, 0);
+
+	const GLenum indexType = VertexLayout::getIndexType(m_vertexCount);
+	if (indexType != m_indexType) {
+		m_indexType = indexType;
+		markDirty(0, 0, 0, m_indices.size());
+	}
+	reserve();
+	flush();
+}
+
+void DynamicMesh3D::updateEBO(size_t first, std::span<const uint32_t> indices) {
+	if (first > m_indices.size()) throw std::runtime_error("DynamicMesh3D: indices written past the end");
+	beginWrite();
+
+	const size_t end = first + indices.size();
+	m_indices.resize(std::max(m_indices.size(), end));
+	std::copy(indices.begin(), indices.end(), m_indices.begin() + first);
+	m_indexCount = static_cast<GLsizei>(m_indices.size());
+	markDirty(0, 0, first, end);
+	reserve();
+	flush();
+}
+
+void DynamicMesh3D::beginWrite() {
+	if (!m_inFlight) return;
+	/* everything reading the current region was submitted before this fence */
+	m_regions[m_region].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_region = (m_region + 1) % regionCount;
+	waitFence(m_regions[m_region].fence);
+	m_inFlight = false;
+}
+
+void DynamicMesh3D::markDirty(size_t vertexBegin, size_t vertexEnd, size_t indexBegin, size_t indexEnd) {
+	for (auto& region : m_regions) {
+		if (vertexBegin < vertexEnd) {
+			if (region.vertexBegin < region.vertexEnd) {
+				region.vertexBegin = std::min(region.vertexBegin, vertexBegin);
+				region.vertexEnd = std::max(region.vertexEnd, vertexEnd);
+			}
+			else {
+				region.vertexBegin = vertexBegin;
+				region.vertexEnd = vertexEnd;
+			}
+		}
+		if (indexBegin < indexEnd) {
+			if (region.indexBegin < region.indexEnd) {
+				region.indexBegin = std::min(region.indexBegin, indexBegin);
+				region.indexEnd = std::max(region.indexEnd, indexEnd);
+			}
+			else {
+				region.indexBegin = indexBegin;
+				region.indexEnd = indexEnd;
+			}
+		}
+	}
+}
+
+void DynamicMesh3D::reserve() {
+	const size_t stride = static_cast<size_t>(m_layout.getStride());
+	const size_t indexBytes = m_indices.size() * VertexLayout::getIndexSize(m_indexType);
+	if (m_vbo && m_vertexCount <= m_vertexCapacity && indexBytes <= m_indexCapacity) return;
+
+	/* the old buffers may still be read, deleting them is deferred by GL until they aren't */
+	const size_t vertexCapacity = std::max({ m_vertexCount, m_vertexCapacity * 2, minimumVertexCapacity });
+	const size_t indexCapacity = (std::max({ indexBytes, m_indexCapacity * 2, minimumIndexCapacity }) + 3) / 4 * 4;
+	releaseBuffers();
+	m_vertexCapacity = vertexCapacity;
+	m_indexCapacity = indexCapacity;
+	m_vbo = createMappedBuffer(m_vertexCapacity * stride * regionCount, m_mappedVertices);
+	m_ebo = createMappedBuffer(m_indexCapacity * regionCount, m_mappedIndices);
+	bufferBytes().add(static_cast<int64_t>((m_vertexCapacity * stride + m_indexCapacity) * regionCount));
+
+	glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, m_layout.getStride());
+	glVertexArrayElementBuffer(m_vao, m_ebo);
+
+	m_region = 0;
+	m_inFlight = false;
+	markDirty(0, m_vertexCount, 0, m_indices.size());
+}
+
+void DynamicMesh3D::flush() {
+	auto& region = m_regions[m_region];
+	const size_t stride = static_cast<size_t>(m_layout.getStride());
+	const size_t vertexEnd = std::min(region.vertexEnd, m_vertexCount);
+	if (region.vertexBegin < vertexEnd) {
+		uint8_t* out = m_mappedVertices + (m_region * m_vertexCapacity + region.vertexBegin) * stride;
+		std::memcpy(out, m_vertexData.data() + region.vertexBegin * stride, (vertexEnd - region.vertexBegin) * stride);
+	}
+	const size_t indexEnd = std::min(region.indexEnd, m_indices.size());
+	if (region.indexBegin < indexEnd) {
+		const size_t indexSize = static_cast<size_t>(VertexLayout::getIndexSize(m_indexType));
+		const auto packed = VertexLayout::packIndices(std::span<const uint32_t>(m_indices).subspan(region.indexBegin, indexEnd - region.indexBegin), m_indexType);
+		std::memcpy(m_mappedIndices + m_region * m_indexCapacity + region.indexBegin * indexSize, packed.data(), packed.size());
+	}
+	region.vertexBegin = region.vertexEnd = 0;
+	region.indexBegin = region.indexEnd = 0;
+}
+
+void DynamicMesh3D::releaseBuffers() {
+	for (auto& region : m_regions) {
+		if (region.fence) glDeleteSync(region.fence);
+		region.fence = nullptr;
+	}
+	if (m_vbo) {
+		bufferBytes().sub(static_cast<int64_t>((m_vertexCapacity * m_layout.getStride() + m_indexCapacity) * regionCount));
+		glDeleteBuffers(1, &m_vbo);
+	}
+	if (m_ebo) glDeleteBuffers(1, &m_ebo);
+
+	m_vbo = 0;
+	m_ebo = 0;
+	m_mappedVertices = nullptr;
+	m_mappedIndices = nullptr;
+}
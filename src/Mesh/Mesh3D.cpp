@@ -1,53 +1,93 @@
 #include <Mesh/Mesh3D.h>
+#include <algorithm>
+#include <limits>
 #include <vector>
 
+Mesh3D::Mesh3D(std::span<const Vertex> vertices, std::span<const uint32_t> indices, std::span<const MeshLod> lods, const VertexLayout& layout)
+	: m_lods(lods.begin(), lods.end()) {
+	m_indexCount = static_cast<GLsizei>(m_lods.empty() ? indices.size() : m_lods.front().indexCount);
 
-Mesh3D::Mesh3D(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-	m_indexCount = static_cast<GLsizei>(indices.size());
-	constexpr GLsizei vertexSize = sizeof(Vertex);
+	if (!vertices.empty()) {
+		glm::vec3 boundsMin(std::numeric_limits<float>::max()), boundsMax(std::numeric_limits<float>::lowest());
+		for (const auto& vertex : vertices) {
+			boundsMin = glm::min(boundsMin, vertex.position);
+			boundsMax = glm::max(boundsMax, vertex.position);
+		}
+		setBounds(boundsMin, boundsMax);
+	}
 
-	glGenVertexArrays(1, &m_vao);
-	glGenBuffers(1, &m_vbo);
-	glGenBuffers(1, &m_ebo);
+	m_indexType = VertexLayout::getIndexType(vertices.size());
+	const size_t vertexBytes = vertices.size() * layout.getStride();
+	const size_t indexBytes = indices.size() * VertexLayout::getIndexSize(m_indexType);
 
-	glBindVertexArray(m_vao);
-
-	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, vertexSize, reinterpret_cast<void*>(offsetof(Vertex, position)));
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, vertexSize, reinterpret_cast<void*>(offsetof(Vertex, normal)));
-	glEnableVertexAttribArray(1);
+	/* the full layout and 32-bit indices upload straight from the caller's memory */
+	std::vector<uint8_t> packedVertices, packedIndices;
+	std::span<const uint8_t> vertexData(reinterpret_cast<const uint8_t*>(vertices.data()), vertexBytes);
+	std::span<const uint8_t> indexData(reinterpret_cast<const uint8_t*>(indices.data()), indexBytes);
+	if (!layout.isFull()) {
+		packedVertices = layout.pack(vertices);
+		vertexData = packedVertices;
+	}
+	if (m_indexType != GL_UNSIGNED_INT) {
+		packedIndices = VertexLayout::packIndices(indices, m_indexType);
+		indexData = packedIndices;
+	}
+	upload(layout, vertexData, indexData);
+}
 
-	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, vertexSize, reinterpret_cast<void*>(offsetof(Vertex, vertexColor)));
-	glEnableVertexAttribArray(2);
+Mesh3D::Mesh3D(const CookedMeshView& cooked)
+	: m_lods(cooked.lods.begin(), cooked.lods.end()) {
+	m_indexCount = static_cast<GLsizei>(m_lods.empty() ? cooked.indexCount : m_lods.front().indexCount);
+	if (cooked.vertexCount > 0) setBounds(cooked.boundsMin, cooked.boundsMax);
+	m_indexType = cooked.indexType;
+	upload(cooked.layout, cooked.vertices, cooked.indices);
+}
 
-	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, vertexSize, reinterpret_cast<void*>(offsetof(Vertex, textureCoords)));
-	glEnableVertexAttribArray(3);
+void Mesh3D::setBounds(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+	/* the sphere around the AABB, loose but cheap and only used to pick levels of detail */
+	m_boundingSphere = glm::vec4((boundsMin + boundsMax) * 0.5f, glm::length(boundsMax - boundsMin) * 0.5f);
+}
 
-	glBindVertexArray(0);
+void Mesh3D::upload(const VertexLayout& layout, std::span<const uint8_t> vertexData, std::span<const uint8_t> indexData) {
+	m_byteSize = vertexData.size() + indexData.size();
+	m_arena = &MeshArena::get(layout, m_indexType);
+	m_handle = m_arena->allocate(vertexData, indexData);
 }
 
 Mesh3D::~Mesh3D() {
-	if (m_vao) glDeleteVertexArrays(1, &m_vao);
-	if (m_vbo) glDeleteBuffers(1, &m_vbo);
-	if (m_ebo) glDeleteBuffers(1, &m_ebo);
-
-	m_vao = 0;
-	m_vbo = 0;
-	m_ebo = 0;
+	m_arena->free(m_handle);
 	m_indexCount = 0;
 }
 
 GLuint Mesh3D::getVAO() const {
-	return m_vao;
+	return m_arena->getVAO();
 }
 
 GLsizei Mesh3D::getIndicesCount() const {
 	return m_indexCount;
+}
+
+GLenum Mesh3D::getIndexType() const {
+	return m_indexType;
+}
+
+GLint Mesh3D::getBaseVertex() const {
+	return m_arena->getAllocation(m_handle).baseVertex;
+}
+
+GLuint Mesh3D::getFirstIndex() const {
+	return m_arena->getAllocation(m_handle).firstIndex;
+}
+
+size_t Mesh3D::getLodCount() const {
+	return std::max<size_t>(m_lods.size(), 1);
+}
+
+MeshLod Mesh3D::getLod(size_t level) const {
+	if (m_lods.empty()) return { 0, static_cast<uint32_t>(m_indexCount), 0.0f };
+	return m_lods[std::min(level, m_lods.size() - 1)];
+}
+
+glm::vec4 Mesh3D::getBoundingSphere() const {
+	return m_boundingSphere;
 }
\ No newline at end of file
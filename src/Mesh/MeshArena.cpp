@@ -0,0 +1,177 @@
+#include <Mesh/MeshArena.h>
+#include <Profiling/StatsRegistry.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	/* in elements, so small scenes don't grow the buffers several times at startup */
+	constexpr size_t minimumCapacity = 16 * 1024;
+
+	/* what defragment() keeps: the live ranges plus a quarter, so the next few loads don't grow it straight back */
+	size_t compactedCapacity(const RangeAllocator& ranges) {
+		const size_t used = ranges.getUsed();
+		return std::min(ranges.getCapacity(), std::max(used + used / 4, minimumCapacity));
+	}
+
+	StatsRegistry::Gauge& bufferBytes() {
+		static auto& gauge = StatsRegistry::getInstance().gauge("GPU/BufferBytes");
+		return gauge;
+	}
+}
+
+std::vector<MeshArena*>& MeshArena::getArenas() {
+	static auto* arenas = new std::vector<MeshArena*>();
+	return *arenas;
+}
+
+MeshArena& MeshArena::get(const VertexLayout& layout, GLenum indexType) {
+	auto& arenas = getArenas();
+	for (auto* arena : arenas) {
+		if (arena->m_indexType == indexType && arena->m_layout == layout) return *arena;
+	}
+	arenas.push_back(new MeshArena(layout, indexType));
+	return *arenas.back();
+}
+
+void MeshArena::defragmentAll(float threshold) {
+	for (auto* arena : getArenas()) {
+		if (arena->getFragmentation() > threshold) arena->defragment();
+	}
+}
+
+MeshArena::MeshArena(const VertexLayout& layout, GLenum indexType) : m_layout(layout), m_indexType(indexType) {
+	glCreateVertexArrays(1, &m_vao);
+	m_layout.apply(m_vao);
+}
+
+MeshArena::Handle MeshArena::allocate(std::span<const uint8_t> vertices, std::span<const uint8_t> indices) {
+	const size_t stride = static_cast<size_t>(m_layout.getStride());
+	const size_t indexSize = static_cast<size_t>(VertexLayout::getIndexSize(m_indexType));
+	const size_t vertexCount = vertices.size() / stride;
+	const size_t indexCount = indices.size() / indexSize;
+
+	Handle handle = invalid;
+	if (!m_freeSlots.empty()) {
+		handle = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else {
+		handle = static_cast<Handle>(m_slots.size());
+		m_slots.emplace_back();
+	}
+	auto& slot = m_slots[handle];
+	slot.live = true;
+
+	const GLuint previousVbo = m_vbo, previousEbo = m_ebo;
+	slot.vertexRange = claim(m_vertices, m_vbo, stride, vertexCount);
+	slot.indexRange = claim(m_indices, m_ebo, indexSize, indexCount);
+	slot.allocation.baseVertex = static_cast<GLint>(m_vertices.get(slot.vertexRange).offset);
+	slot.allocation.firstIndex = static_cast<GLuint>(m_indices.get(slot.indexRange).offset);
+	slot.allocation.vertexCount = static_cast<GLuint>(vertexCount);
+	slot.allocation.indexCount = static_cast<GLuint>(indexCount);
+
+	/* a grown buffer is a new object, the vertex array has to point at it */
+	if (m_vbo != previousVbo || m_ebo != previousEbo) bindBuffers();
+
+	upload(m_vbo, slot.allocation.baseVertex * stride, vertices.first(vertexCount * stride));
+	upload(m_ebo, slot.allocation.firstIndex * indexSize, indices.first(indexCount * indexSize));
+	return handle;
+}
+
+void MeshArena::free(Handle handle) {
+	if (handle == invalid || !m_slots[handle].live) return;
+	auto& slot = m_slots[handle];
+	m_vertices.free(slot.vertexRange);
+	m_indices.free(slot.indexRange);
+	slot = Slot();
+	m_freeSlots.push_back(handle);
+}
+
+float MeshArena::getFragmentation() const {
+	auto fragmentation = [](const RangeAllocator& ranges) {
+		if (ranges.getCapacity() == 0) return 0.0f;
+		const size_t free = ranges.getCapacity() - ranges.getUsed();
+		return static_cast<float>(free - ranges.getLargestFree()) / static_cast<float>(ranges.getCapacity());
+	};
+	return std::max(fragmentation(m_vertices), fragmentation(m_indices));
+}
+
+void MeshArena::defragment() {
+	static auto& defragmentations = StatsRegistry::getInstance().counter("GPU/ArenaDefragmentations");
+	if (!m_vbo || !m_ebo) return;
+
+	const size_t stride = static_cast<size_t>(m_layout.getStride());
+	const size_t indexSize = static_cast<size_t>(VertexLayout::getIndexSize(m_indexType));
+	const size_t previousBytes = getGpuByteSize();
+	const size_t vertexCapacity = compactedCapacity(m_vertices);
+	const size_t indexCapacity = compactedCapacity(m_indices);
+	const GLuint vbo = createBuffer(vertexCapacity, stride);
+	const GLuint ebo = createBuffer(indexCapacity, indexSize);
+	m_vertices.reset(vertexCapacity);
+	m_indices.reset(indexCapacity);
+
+	/* an empty allocator hands ranges out back to back, so reallocating in slot order packs them */
+	auto move = [](RangeAllocator& ranges, GLuint from, GLuint to, size_t elementSize, size_t offset, size_t count, RangeAllocator::Handle& range) {
+		range = ranges.allocate(count);
+		const size_t moved = ranges.get(range).offset;
+		if (count > 0) glCopyNamedBufferSubData(from, to, static_cast<GLintptr>(offset * elementSize), static_cast<GLintptr>(moved * elementSize), static_cast<GLsizeiptr>(count * elementSize));
+		return moved;
+	};
+	for (auto& slot : m_slots) {
+		if (!slot.live) continue;
+		auto& allocation = slot.allocation;
+		allocation.baseVertex = static_cast<GLint>(move(m_vertices, m_vbo, vbo, stride, static_cast<size_t>(allocation.baseVertex), allocation.vertexCount, slot.vertexRange));
+		allocation.firstIndex = static_cast<GLuint>(move(m_indices, m_ebo, ebo, indexSize, allocation.firstIndex, allocation.indexCount, slot.indexRange));
+	}
+
+	glDeleteBuffers(1, &m_vbo);
+	glDeleteBuffers(1, &m_ebo);
+	m_vbo = vbo;
+	m_ebo = ebo;
+	bindBuffers();
+	bufferBytes().add(static_cast<int64_t>(getGpuByteSize()) - static_cast<int64_t>(previousBytes));
+	defragmentations.add();
+}
+
+size_t MeshArena::getGpuByteSize() const {
+	return m_vertices.getCapacity() * m_layout.getStride() + m_indices.getCapacity() * VertexLayout::getIndexSize(m_indexType);
+}
+
+RangeAllocator::Handle MeshArena::claim(RangeAllocator& ranges, GLuint& buffer, size_t elementSize, size_t count) {
+	RangeAllocator::Handle range = ranges.allocate(count);
+	if (range != RangeAllocator::invalid) return range;
+
+	const size_t capacity = ranges.getCapacity();
+	const size_t grown = std::max({ capacity * 2, capacity + std::max<size_t>(count, 1), minimumCapacity });
+	const GLuint resized = createBuffer(grown, elementSize);
+	if (buffer) {
+		glCopyNamedBufferSubData(buffer, resized, 0, 0, static_cast<GLsizeiptr>(capacity * elementSize));
+		glDeleteBuffers(1, &buffer);
+	}
+	buffer = resized;
+	bufferBytes().add(static_cast<int64_t>((grown - capacity) * elementSize));
+
+	ranges.grow(grown);
+	range = ranges.allocate(count);
+	if (range == RangeAllocator::invalid) throw std::runtime_error("MeshArena: cannot allocate after growing");
+	return range;
+}
+
+GLuint MeshArena::createBuffer(size_t capacity, size_t elementSize) {
+	/* immutable size, growing replaces the buffer anyway; contents are still written with glNamedBufferSubData */
+	GLuint buffer = 0;
+	glCreateBuffers(1, &buffer);
+	glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(capacity * elementSize), nullptr, GL_DYNAMIC_STORAGE_BIT);
+	return buffer;
+}
+
+void MeshArena::upload(GLuint buffer, size_t offset, std::span<const uint8_t> bytes) {
+	if (bytes.empty()) return;
+	glNamedBufferSubData(buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes.size()), bytes.data());
+}
+
+void MeshArena::bindBuffers() {
+	glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, m_layout.getStride());
+	glVertexArrayElementBuffer(m_vao, m_ebo);
+}
@@ -0,0 +1,233 @@
+#include <Mesh/MeshOptimizer.h>
+#include <Util/Hash.h>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <glm/glm.hpp>
+
+namespace {
+	constexpr uint32_t unused = ~0u;
+
+	bool indicesInRange(std::span<const uint32_t> indices, size_t vertexCount) {
+		return std::all_of(indices.begin(), indices.end(), [vertexCount](uint32_t index) { return index < vertexCount; });
+	}
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount) {
+	CacheStats stats;
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0 || vertexCount == 0 || !indicesInRange(indices, vertexCount)) return stats;
+
+	/* a vertex is cached while fewer than cacheSize misses happened since its own */
+	std::vector<uint32_t> missTime(vertexCount, 0);
+	uint32_t misses = 0;
+	for (size_t i = 0; i < triangleCount * 3; ++i) {
+		const uint32_t vertex = indices[i];
+		if (missTime[vertex] == 0 || misses + 1 - missTime[vertex] > cacheSize) missTime[vertex] = ++misses;
+	}
+	stats.acmr = static_cast<float>(misses) / static_cast<float>(triangleCount);
+	stats.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+	return stats;
+}
+
+MeshOptimizer::Report MeshOptimizer::optimize(MeshData& mesh) {
+	/* reordering invalidates coarser levels, only the full mesh is kept; regenerate them afterwards */
+	if (!mesh.lods.empty()) {
+		const auto finest = mesh.lods.front();
+		mesh.indices = std::vector<uint32_t>(mesh.indices.begin() + finest.firstIndex, mesh.indices.begin() + finest.firstIndex + finest.indexCount);
+		mesh.lods.clear();
+	}
+
+	Report report;
+	report.verticesBefore = mesh.vertices.size();
+	report.triangleCount = mesh.indices.size() / 3;
+	report.before = analyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+	if (indicesInRange(mesh.indices, mesh.vertices.size())) {
+		mesh.indices.resize(report.triangleCount * 3);
+		weldVertices(mesh);
+		mesh.indices = optimizeOverdraw(mesh.indices, mesh.vertices);
+		optimizeVertexFetch(mesh);
+	}
+
+	report.verticesAfter = mesh.vertices.size();
+	report.after = analyzeVertexCache(mesh.indices, mesh.vertices.size());
+	return report;
+}
+
+void MeshOptimizer::weldVertices(MeshData& mesh) {
+	/* exact bitwise matches only, nearly equal vertices may differ on purpose (hard edges, UV seams) */
+	const auto& vertices = mesh.vertices;
+	auto hash = [&vertices](uint32_t index) { return static_cast<size_t>(Hash::fnv1aValue(vertices[index])); };
+	auto equal = [&vertices](uint32_t a, uint32_t b) { return std::memcmp(&vertices[a], &vertices[b], sizeof(MeshVertex)) == 0; };
+	std::unordered_map<uint32_t, uint32_t, decltype(hash), decltype(equal)> firstOf(vertices.size(), hash, equal);
+
+	std::vector<uint32_t> remap(vertices.size());
+	std::vector<MeshVertex> welded;
+	welded.reserve(vertices.size());
+	for (uint32_t i = 0; i < vertices.size(); ++i) {
+		auto [it, inserted] = firstOf.try_emplace(i, static_cast<uint32_t>(welded.size()));
+		if (inserted) welded.push_back(vertices[i]);
+		remap[i] = it->second;
+	}
+	if (welded.size() == vertices.size()) return;
+
+	for (auto& index : mesh.indices) index = remap[index];
+	mesh.vertices = std::move(welded);
+}
+
+std::vector<uint32_t> MeshOptimizer::optimizeVertexCache(std::span<const uint32_t> indices, size_t vertexCount) {
+	return tipsify(indices, vertexCount, nullptr);
+}
+
+std::vector<uint32_t> MeshOptimizer::tipsify(std::span<const uint32_t> indices, size_t vertexCount, std::vector<uint32_t>* clusterStarts) {
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0 || !indicesInRange(indices.first(triangleCount * 3), vertexCount)) return { indices.begin(), indices.end() };
+
+	/* the triangles around each vertex, as offsets into one array */
+	std::vector<uint32_t> liveCount(vertexCount, 0);
+	for (size_t i = 0; i < triangleCount * 3; ++i) ++liveCount[indices[i]];
+	std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+	std::partial_sum(liveCount.begin(), liveCount.end(), adjacencyOffset.begin() + 1);
+	std::vector<uint32_t> adjacency(triangleCount * 3);
+	{
+		std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i) adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	std::vector<uint32_t> cacheTime(vertexCount, 0);
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<uint32_t> deadEnds;
+	std::vector<uint32_t> candidates;
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3);
+
+	uint32_t timestamp = cacheSize + 1;
+	uint32_t cursor = 1;
+	uint32_t fanning = 0;
+	if (clusterStarts) clusterStarts->assign(1, 0);
+
+	/* the next vertex with live triangles from the dead-end stack, else in input order */
+	auto skipDeadEnd = [&]() -> uint32_t {
+		while (!deadEnds.empty()) {
+			const uint32_t vertex = deadEnds.back();
+			deadEnds.pop_back();
+			if (liveCount[vertex] > 0) return vertex;
+		}
+		while (cursor < vertexCount) {
+			if (liveCount[cursor] > 0) return cursor++;
+			++cursor;
+		}
+		return unused;
+	};
+
+	while (fanning != unused) {
+		candidates.clear();
+		for (uint32_t a = adjacencyOffset[fanning]; a < adjacencyOffset[fanning + 1]; ++a) {
+			const uint32_t triangle = adjacency[a];
+			if (emitted[triangle]) continue;
+			for (uint32_t corner = 0; corner < 3; ++corner) {
+				const uint32_t vertex = indices[triangle * 3 + corner];
+				output.push_back(vertex);
+				deadEnds.push_back(vertex);
+				candidates.push_back(vertex);
+				--liveCount[vertex];
+				if (timestamp - cacheTime[vertex] > cacheSize) cacheTime[vertex] = timestamp++;
+			}
+			emitted[triangle] = true;
+		}
+
+		/* prefer the candidate that stays in cache longest while its remaining fan is emitted */
+		uint32_t next = unused;
+		int64_t bestPriority = -1;
+		for (const uint32_t vertex : candidates) {
+			if (liveCount[vertex] == 0) continue;
+			int64_t priority = 0;
+			if (timestamp - cacheTime[vertex] + 2 * liveCount[vertex] <= cacheSize) priority = timestamp - cacheTime[vertex];
+			if (priority > bestPriority) {
+				bestPriority = priority;
+				next = vertex;
+			}
+		}
+		if (next == unused) {
+			next = skipDeadEnd();
+			if (clusterStarts && next != unused && output.size() / 3 != clusterStarts->back()) clusterStarts->push_back(static_cast<uint32_t>(output.size() / 3));
+		}
+		fanning = next;
+	}
+	return output;
+}
+
+std::vector<uint32_t> MeshOptimizer::optimizeOverdraw(std::span<const uint32_t> indices, std::span<const MeshVertex> vertices, float threshold) {
+	std::vector<uint32_t> clusterStarts;
+	std::vector<uint32_t> ordered = tipsify(indices, vertices.size(), &clusterStarts);
+	const size_t triangleCount = ordered.size() / 3;
+	if (clusterStarts.size() < 2 || !indicesInRange(ordered, vertices.size())) return ordered;
+	clusterStarts.push_back(static_cast<uint32_t>(triangleCount));
+
+	/* area weighted centroid and summed normal per cluster, and the centroid of the whole mesh */
+	struct Cluster {
+		uint32_t first = 0;
+		uint32_t last = 0;
+		float sortKey = 0.0f;
+	};
+	std::vector<Cluster> clusters;
+	std::vector<glm::vec3> centroids;
+	std::vector<glm::vec3> normals;
+	glm::vec3 meshCentroid(0.0f);
+	float meshArea = 0.0f;
+	for (size_t c = 0; c + 1 < clusterStarts.size(); ++c) {
+		glm::vec3 centroid(0.0f), normal(0.0f);
+		float area = 0.0f;
+		for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t) {
+			const glm::vec3& a = vertices[ordered[t * 3 + 0]].position;
+			const glm::vec3& b = vertices[ordered[t * 3 + 1]].position;
+			const glm::vec3& p = vertices[ordered[t * 3 + 2]].position;
+			const glm::vec3 cross = glm::cross(b - a, p - a);
+			const float triangleArea = glm::length(cross);
+			centroid += (a + b + p) * (triangleArea / 3.0f);
+			normal += cross;
+			area += triangleArea;
+		}
+		meshCentroid += centroid;
+		meshArea += area;
+		clusters.push_back({ clusterStarts[c], clusterStarts[c + 1], 0.0f });
+		centroids.push_back(area > 0.0f ? centroid / area : centroid);
+		normals.push_back(normal);
+	}
+	if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+	/* clusters facing away from the centre are likely in front of the rest, draw them first */
+	for (size_t c = 0; c < clusters.size(); ++c) {
+		const float length = glm::length(normals[c]);
+		clusters[c].sortKey = length > 0.0f ? glm::dot(centroids[c] - meshCentroid, normals[c] / length) : 0.0f;
+	}
+	std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+	std::vector<uint32_t> sorted;
+	sorted.reserve(ordered.size());
+	for (const auto& cluster : clusters) {
+		sorted.insert(sorted.end(), ordered.begin() + cluster.first * 3, ordered.begin() + cluster.last * 3);
+	}
+
+	const float tipsifyAcmr = analyzeVertexCache(ordered, vertices.size()).acmr;
+	const float sortedAcmr = analyzeVertexCache(sorted, vertices.size()).acmr;
+	return sortedAcmr <= tipsifyAcmr * threshold ? sorted : ordered;
+}
+
+void MeshOptimizer::optimizeVertexFetch(MeshData& mesh) {
+	std::vector<uint32_t> remap(mesh.vertices.size(), unused);
+	std::vector<MeshVertex> reordered;
+	reordered.reserve(mesh.vertices.size());
+	for (auto& index : mesh.indices) {
+		if (index >= remap.size()) continue;
+		if (remap[index] == unused) {
+			remap[index] = static_cast<uint32_t>(reordered.size());
+			reordered.push_back(mesh.vertices[index]);
+		}
+		index = remap[index];
+	}
+	mesh.vertices = std::move(reordered);
+}
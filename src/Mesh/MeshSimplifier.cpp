@@ -0,0 +1,337 @@
+#include <Mesh/MeshSimplifier.h>
+#include <Mesh/MeshOptimizer.h>
+#include <Util/Hash.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <glm/glm.hpp>
+
+namespace {
+	/* open borders are held in place by planes through them this many times heavier than the surface */
+	constexpr double borderWeight = 10.0;
+
+	/* sum of weighted squared distances to a set of planes, as a symmetric 4x4 */
+	struct Quadric {
+		double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+		double b0 = 0, b1 = 0, b2 = 0;
+		double c = 0;
+		double weight = 0;
+
+		void addPlane(const glm::dvec3& n, double d, double w) {
+			a00 += w * n.x * n.x; a01 += w * n.x * n.y; a02 += w * n.x * n.z;
+			a11 += w * n.y * n.y; a12 += w * n.y * n.z; a22 += w * n.z * n.z;
+			b0 += w * n.x * d; b1 += w * n.y * d; b2 += w * n.z * d;
+			c += w * d * d;
+			weight += w;
+		}
+
+		Quadric operator+(const Quadric& o) const {
+			Quadric q = *this;
+			q.a00 += o.a00; q.a01 += o.a01; q.a02 += o.a02; q.a11 += o.a11; q.a12 += o.a12; q.a22 += o.a22;
+			q.b0 += o.b0; q.b1 += o.b1; q.b2 += o.b2;
+			q.c += o.c;
+			q.weight += o.weight;
+			return q;
+		}
+
+		/* root mean squared distance from p to the planes */
+		double error(const glm::dvec3& p) const {
+			if (weight <= 0) return 0;
+			const double sum = a00 * p.x * p.x + 2 * a01 * p.x * p.y + 2 * a02 * p.x * p.z
+				+ a11 * p.y * p.y + 2 * a12 * p.y * p.z + a22 * p.z * p.z
+				+ 2 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+			return std::sqrt(std::max(sum, 0.0) / weight);
+		}
+	};
+
+	enum class Kind : uint8_t {
+		Manifold,
+		Border,
+		/* seams, non-manifold edges and border junctions never move */
+		Locked,
+	};
+
+	constexpr uint32_t none = ~0u;
+
+	/* the triangles around each of count items, as offsets into one array */
+	void buildAdjacency(std::span<const uint32_t> indices, size_t count, const uint32_t* remap, std::vector<uint32_t>& offsets, std::vector<uint32_t>& triangles) {
+		offsets.assign(count + 1, 0);
+		for (const uint32_t index : indices) ++offsets[(remap ? remap[index] : index) + 1];
+		std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+		triangles.resize(indices.size());
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); ++i) triangles[fill[remap ? remap[indices[i]] : indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	/* one simplification in progress, run() can be called again with a lower target to carry on */
+	class Simplification {
+	public:
+		Simplification(std::span<const uint32_t> indices, std::span<const MeshVertex> vertices, double maxError);
+
+		void run(size_t targetIndexCount);
+		const std::vector<uint32_t>& getIndices() const { return m_indices; }
+		float getError() const { return static_cast<float>(m_error); }
+	private:
+		glm::dvec3 positionOf(uint32_t vertex) const { return glm::dvec3(m_vertices[vertex].position); }
+		/* kinds and border neighbours from the current triangles, optionally adding the border planes */
+		void classify(bool addBorderPlanes);
+		bool canCollapse(uint32_t from, uint32_t to) const;
+
+		std::span<const MeshVertex> m_vertices;
+		double m_maxError = 0.0;
+		double m_error = 0.0;
+		std::vector<uint32_t> m_indices;
+
+		/* topology is by position, vertices that only differ in normal or UV are one corner */
+		std::vector<uint32_t> m_positionId;
+		std::vector<uint32_t> m_verticesAtPosition;
+		std::vector<Quadric> m_quadrics;
+		std::vector<Kind> m_kinds;
+		std::vector<std::array<uint32_t, 2>> m_borderNeighbors;
+
+		std::vector<uint32_t> m_positionAdjacencyOffset, m_positionAdjacency;
+		std::vector<uint32_t> m_adjacencyOffset, m_adjacency;
+		std::vector<uint32_t> m_collapseTo;
+		std::vector<bool> m_dirty;
+	};
+
+	Simplification::Simplification(std::span<const uint32_t> indices, std::span<const MeshVertex> vertices, double maxError)
+		: m_vertices(vertices), m_maxError(maxError), m_indices(indices.begin(), indices.begin() + indices.size() / 3 * 3) {
+		const size_t vertexCount = vertices.size();
+		if (!std::all_of(m_indices.begin(), m_indices.end(), [vertexCount](uint32_t index) { return index < vertexCount; })) {
+			m_maxError = -1.0;
+			return;
+		}
+
+		std::vector<bool> referenced(vertexCount, false);
+		for (const uint32_t index : m_indices) referenced[index] = true;
+		auto hash = [&vertices](uint32_t index) { return static_cast<size_t>(Hash::fnv1aValue(vertices[index].position)); };
+		auto equal = [&vertices](uint32_t a, uint32_t b) { return std::memcmp(&vertices[a].position, &vertices[b].position, sizeof(glm::vec3)) == 0; };
+		std::unordered_map<uint32_t, uint32_t, decltype(hash), decltype(equal)> positions(vertexCount, hash, equal);
+		m_positionId.assign(vertexCount, 0);
+		for (uint32_t i = 0; i < vertexCount; ++i) {
+			if (!referenced[i]) continue;
+			auto [it, inserted] = positions.try_emplace(i, static_cast<uint32_t>(m_verticesAtPosition.size()));
+			if (inserted) m_verticesAtPosition.push_back(0);
+			m_positionId[i] = it->second;
+			++m_verticesAtPosition[it->second];
+		}
+
+		/* area weighted planes of the surface around each position */
+		m_quadrics.resize(m_verticesAtPosition.size());
+		for (size_t t = 0; t < m_indices.size(); t += 3) {
+			const glm::dvec3 p0 = positionOf(m_indices[t]), p1 = positionOf(m_indices[t + 1]), p2 = positionOf(m_indices[t + 2]);
+			glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+			const double length = glm::length(normal);
+			if (length == 0.0) continue;
+			normal /= length;
+			for (uint32_t corner = 0; corner < 3; ++corner) m_quadrics[m_positionId[m_indices[t + corner]]].addPlane(normal, -glm::dot(normal, p0), length * 0.5);
+		}
+		classify(true);
+	}
+
+	void Simplification::classify(bool addBorderPlanes) {
+		const size_t positionCount = m_verticesAtPosition.size();
+		buildAdjacency(m_indices, positionCount, m_positionId.data(), m_positionAdjacencyOffset, m_positionAdjacency);
+		m_kinds.assign(positionCount, Kind::Manifold);
+		m_borderNeighbors.assign(positionCount, { none, none });
+
+		/* an edge is shared by as many triangles as there are entries for it in either end's neighbours */
+		std::vector<std::pair<uint32_t, uint32_t>> neighbors;
+		for (uint32_t a = 0; a < positionCount; ++a) {
+			if (m_verticesAtPosition[a] > 1) m_kinds[a] = Kind::Locked;
+			neighbors.clear();
+			for (uint32_t i = m_positionAdjacencyOffset[a]; i < m_positionAdjacencyOffset[a + 1]; ++i) {
+				const uint32_t triangle = m_positionAdjacency[i];
+				for (uint32_t corner = 0; corner < 3; ++corner) {
+					const uint32_t b = m_positionId[m_indices[triangle * 3 + corner]];
+					if (b != a) neighbors.push_back({ b, triangle });
+				}
+			}
+			std::sort(neighbors.begin(), neighbors.end());
+
+			uint32_t borderCount = 0;
+			for (size_t i = 0; i < neighbors.size();) {
+				size_t end = i + 1;
+				while (end < neighbors.size() && neighbors[end].first == neighbors[i].first) ++end;
+				const uint32_t b = neighbors[i].first;
+				if (end - i > 2) {
+					m_kinds[a] = Kind::Locked;
+				}
+				else if (end - i == 1) {
+					if (borderCount < 2) m_borderNeighbors[a][borderCount] = b;
+					++borderCount;
+					if (addBorderPlanes && a < b) {
+						/* a plane through the border edge, perpendicular to its triangle */
+						const uint32_t* corners = &m_indices[neighbors[i].second * 3];
+						const glm::dvec3 p0 = positionOf(corners[0]), p1 = positionOf(corners[1]), p2 = positionOf(corners[2]);
+						const glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+						glm::dvec3 pa(0.0), pb(0.0);
+						for (uint32_t corner = 0; corner < 3; ++corner) {
+							if (m_positionId[corners[corner]] == a) pa = positionOf(corners[corner]);
+							if (m_positionId[corners[corner]] == b) pb = positionOf(corners[corner]);
+						}
+						const glm::dvec3 edge = pb - pa;
+						const glm::dvec3 borderNormal = glm::cross(edge, normal);
+						const double length = glm::length(borderNormal);
+						if (length > 0.0) {
+							const glm::dvec3 n = borderNormal / length;
+							m_quadrics[a].addPlane(n, -glm::dot(n, pa), borderWeight * glm::dot(edge, edge));
+							m_quadrics[b].addPlane(n, -glm::dot(n, pa), borderWeight * glm::dot(edge, edge));
+						}
+					}
+				}
+				i = end;
+			}
+			if (m_kinds[a] != Kind::Locked && borderCount > 0) m_kinds[a] = borderCount == 2 ? Kind::Border : Kind::Locked;
+		}
+	}
+
+	bool Simplification::canCollapse(uint32_t from, uint32_t to) const {
+		const uint32_t a = m_positionId[from], b = m_positionId[to];
+		if (a == b || m_kinds[a] == Kind::Locked) return false;
+		if (m_kinds[a] == Kind::Manifold) return true;
+		/* border vertices only slide along the border */
+		return m_kinds[b] != Kind::Manifold && (m_borderNeighbors[a][0] == b || m_borderNeighbors[a][1] == b);
+	}
+
+	void Simplification::run(size_t targetIndexCount) {
+		if (m_maxError < 0.0) return;
+
+		struct Collapse {
+			uint32_t from;
+			uint32_t to;
+			double error;
+		};
+		std::vector<Collapse> collapses;
+
+		/* each pass collapses the cheapest edges whose neighbourhoods don't overlap, then rebuilds */
+		bool first = true;
+		while (m_indices.size() > targetIndexCount) {
+			if (!first) classify(false);
+			first = false;
+			buildAdjacency(m_indices, m_vertices.size(), nullptr, m_adjacencyOffset, m_adjacency);
+
+			/* interior edges come up once per side, only the side with the lower position id is kept */
+			collapses.clear();
+			for (size_t t = 0; t < m_indices.size(); t += 3) {
+				for (uint32_t e = 0; e < 3; ++e) {
+					const uint32_t u = m_indices[t + e], v = m_indices[t + (e + 1) % 3];
+					const uint32_t a = m_positionId[u], b = m_positionId[v];
+					const bool border = m_borderNeighbors[a][0] == b || m_borderNeighbors[a][1] == b;
+					if (a > b && !border) continue;
+
+					const Quadric combined = m_quadrics[a] + m_quadrics[b];
+					Collapse best{ 0, 0, std::numeric_limits<double>::max() };
+					if (canCollapse(u, v)) best = { u, v, combined.error(positionOf(v)) };
+					if (canCollapse(v, u)) {
+						const double cost = combined.error(positionOf(u));
+						if (cost < best.error) best = { v, u, cost };
+					}
+					if (best.error <= m_maxError) collapses.push_back(best);
+				}
+			}
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+			m_collapseTo.resize(m_vertices.size());
+			std::iota(m_collapseTo.begin(), m_collapseTo.end(), 0u);
+			m_dirty.assign(m_vertices.size(), false);
+			const size_t wanted = (m_indices.size() - targetIndexCount + 2) / 3;
+			size_t removed = 0;
+			for (const auto& collapse : collapses) {
+				if (removed >= wanted) break;
+				if (m_dirty[collapse.from] || m_dirty[collapse.to]) continue;
+
+				/* reject collapses that flip or flatten a surviving triangle */
+				const glm::dvec3 target = positionOf(collapse.to);
+				uint32_t removes = 0;
+				bool flips = false;
+				for (uint32_t i = m_adjacencyOffset[collapse.from]; i < m_adjacencyOffset[collapse.from + 1] && !flips; ++i) {
+					const uint32_t* corners = &m_indices[m_adjacency[i] * 3];
+					if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to) {
+						++removes;
+						continue;
+					}
+					glm::dvec3 before[3], after[3];
+					for (uint32_t c = 0; c < 3; ++c) {
+						before[c] = positionOf(corners[c]);
+						after[c] = corners[c] == collapse.from ? target : before[c];
+					}
+					const glm::dvec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+					const glm::dvec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+					flips = glm::dot(normalBefore, normalAfter) <= 0.0;
+				}
+				if (flips) continue;
+
+				m_collapseTo[collapse.from] = collapse.to;
+				m_quadrics[m_positionId[collapse.to]] = m_quadrics[m_positionId[collapse.to]] + m_quadrics[m_positionId[collapse.from]];
+				m_error = std::max(m_error, collapse.error);
+				removed += removes;
+				for (uint32_t i = m_adjacencyOffset[collapse.from]; i < m_adjacencyOffset[collapse.from + 1]; ++i) {
+					const uint32_t* corners = &m_indices[m_adjacency[i] * 3];
+					m_dirty[corners[0]] = m_dirty[corners[1]] = m_dirty[corners[2]] = true;
+				}
+			}
+			if (removed == 0) break;
+
+			size_t kept = 0;
+			for (size_t t = 0; t < m_indices.size(); t += 3) {
+				const uint32_t a = m_collapseTo[m_indices[t]], b = m_collapseTo[m_indices[t + 1]], c = m_collapseTo[m_indices[t + 2]];
+				if (a == b || b == c || a == c) continue;
+				m_indices[kept++] = a;
+				m_indices[kept++] = b;
+				m_indices[kept++] = c;
+			}
+			m_indices.resize(kept);
+		}
+	}
+}
+
+std::vector<uint32_t> MeshSimplifier::simplify(std::span<const uint32_t> indices, std::span<const MeshVertex> vertices, size_t targetIndexCount, float maxError, float* error) {
+	Simplification simplification(indices, vertices, maxError);
+	simplification.run(targetIndexCount);
+	if (error) *error = simplification.getError();
+	return simplification.getIndices();
+}
+
+
+void MeshSimplifier::generateLods(MeshData& mesh, const LodSettings& settings) {
+	if (!mesh.lods.empty()) {
+		const auto& finest = mesh.lods.front();
+		mesh.indices = std::vector<uint32_t>(mesh.indices.begin() + finest.firstIndex, mesh.indices.begin() + finest.firstIndex + finest.indexCount);
+		mesh.lods.clear();
+	}
+	const std::vector<uint32_t> full = mesh.indices;
+	if (full.size() / 3 < settings.minTriangles * 2 || mesh.vertices.empty()) return;
+
+	glm::vec3 boundsMin(std::numeric_limits<float>::max()), boundsMax(std::numeric_limits<float>::lowest());
+	for (const auto& vertex : mesh.vertices) {
+		boundsMin = glm::min(boundsMin, vertex.position);
+		boundsMax = glm::max(boundsMax, vertex.position);
+	}
+	const float maxError = settings.maxError * glm::length(boundsMax - boundsMin) * 0.5f;
+
+	/* one simplification carried on level after level, so each level's error is measured against the full mesh */
+	Simplification simplification(full, mesh.vertices, maxError);
+	mesh.lods.push_back({ 0, static_cast<uint32_t>(full.size()), 0.0f });
+	size_t previousCount = full.size();
+	for (uint32_t level = 1; level <= settings.maxLevels; ++level) {
+		const size_t target = static_cast<size_t>(static_cast<float>(previousCount / 3) * settings.reduction) * 3;
+		if (target / 3 < settings.minTriangles) break;
+
+		simplification.run(target);
+		/* stalled on the error limit or locked vertices, coarser levels wouldn't get any further */
+		if (simplification.getIndices().size() > previousCount * 9 / 10) break;
+
+		const auto indices = MeshOptimizer::optimizeVertexCache(simplification.getIndices(), mesh.vertices.size());
+		mesh.lods.push_back({ static_cast<uint32_t>(mesh.indices.size()), static_cast<uint32_t>(indices.size()), simplification.getError() });
+		mesh.indices.insert(mesh.indices.end(), indices.begin(), indices.end());
+		previousCount = indices.size();
+	}
+	if (mesh.lods.size() == 1) mesh.lods.clear();
+}
@@ -0,0 +1,129 @@
+#include <Mesh/VertexLayout.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <glm/gtc/packing.hpp>
+
+namespace {
+	/* GL size, type and normalisation of a format holding count components */
+	VertexLayout::Attribute describe(GLuint location, VertexLayout::Format format, GLint count) {
+		VertexLayout::Attribute attribute;
+		attribute.location = location;
+		attribute.format = format;
+		switch (format) {
+		case VertexLayout::Format::Float:
+			attribute.size = count;
+			attribute.type = GL_FLOAT;
+			break;
+		case VertexLayout::Format::Half:
+			attribute.size = count;
+			attribute.type = GL_HALF_FLOAT;
+			break;
+		case VertexLayout::Format::Snorm10:
+			/* packed formats must be read as four components, the shader ignores the 2-bit w */
+			attribute.size = 4;
+			attribute.type = GL_INT_2_10_10_10_REV;
+			attribute.normalized = GL_TRUE;
+			break;
+		case VertexLayout::Format::Unorm8:
+			attribute.size = 4;
+			attribute.type = GL_UNSIGNED_BYTE;
+			attribute.normalized = GL_TRUE;
+			break;
+		}
+		return attribute;
+	}
+
+	GLuint getByteSize(const VertexLayout::Attribute& attribute) {
+		switch (attribute.format) {
+		case VertexLayout::Format::Float: return 4 * attribute.size;
+		case VertexLayout::Format::Half: return (2 * attribute.size + 3) / 4 * 4;
+		default: return 4;
+		}
+	}
+
+	void write(uint8_t* out, const VertexLayout::Attribute& attribute, glm::vec4 value) {
+		switch (attribute.format) {
+		case VertexLayout::Format::Float:
+			std::memcpy(out, &value, 4 * attribute.size);
+			break;
+		case VertexLayout::Format::Half:
+			for (GLint i = 0; i < attribute.size; ++i) {
+				const uint16_t half = glm::packHalf1x16(value[i]);
+				std::memcpy(out + 2 * i, &half, sizeof(half));
+			}
+			break;
+		case VertexLayout::Format::Snorm10: {
+			const uint32_t packed = glm::packSnorm3x10_1x2(glm::vec4(glm::clamp(glm::vec3(value), -1.0f, 1.0f), 0.0f));
+			std::memcpy(out, &packed, sizeof(packed));
+			break;
+		}
+		case VertexLayout::Format::Unorm8: {
+			const uint32_t packed = glm::packUnorm4x8(glm::clamp(value, 0.0f, 1.0f));
+			std::memcpy(out, &packed, sizeof(packed));
+			break;
+		}
+		}
+	}
+}
+
+VertexLayout::VertexLayout(Format position, Format normal, Format vertexColor, Format textureCoords) {
+	m_attributes = {
+		describe(0, position, 3),
+		describe(1, normal, 3),
+		describe(2, vertexColor, 3),
+		describe(3, textureCoords, 2),
+	};
+	for (auto& attribute : m_attributes) {
+		attribute.offset = static_cast<GLuint>(m_stride);
+		m_stride += static_cast<GLsizei>(getByteSize(attribute));
+	}
+}
+
+const VertexLayout& VertexLayout::full() {
+	static const VertexLayout layout(Format::Float, Format::Float, Format::Float, Format::Float);
+	return layout;
+}
+
+const VertexLayout& VertexLayout::quantized() {
+	static const VertexLayout layout(Format::Float, Format::Snorm10, Format::Unorm8, Format::Half);
+	return layout;
+}
+
+bool VertexLayout::isFull() const {
+	return std::all_of(m_attributes.begin(), m_attributes.end(), [](const Attribute& attribute) { return attribute.format == Format::Float; })
+		&& m_stride == sizeof(MeshVertex);
+}
+
+bool VertexLayout::operator==(const VertexLayout& other) const {
+	return std::equal(m_attributes.begin(), m_attributes.end(), other.m_attributes.begin(), [](const Attribute& a, const Attribute& b) { return a.format == b.format; });
+}
+
+std::vector<uint8_t> VertexLayout::pack(std::span<const MeshVertex> vertices) const {
+	std::vector<uint8_t> bytes(vertices.size() * m_stride, 0);
+	uint8_t* out = bytes.data();
+	for (const auto& vertex : vertices) {
+		write(out + m_attributes[0].offset, m_attributes[0], glm::vec4(vertex.position, 1.0f));
+		write(out + m_attributes[1].offset, m_attributes[1], glm::vec4(vertex.normal, 0.0f));
+		write(out + m_attributes[2].offset, m_attributes[2], glm::vec4(vertex.vertexColor, 1.0f));
+		write(out + m_attributes[3].offset, m_attributes[3], glm::vec4(vertex.textureCoords, 0.0f, 0.0f));
+		out += m_stride;
+	}
+	return bytes;
+}
+
+GLenum VertexLayout::getIndexType(size_t vertexCount) {
+	return vertexCount <= static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+std::vector<uint8_t> VertexLayout::packIndices(std::span<const uint32_t> indices, GLenum indexType) {
+	std::vector<uint8_t> bytes(indices.size() * getIndexSize(indexType));
+	if (indexType == GL_UNSIGNED_SHORT) {
+		auto* out = reinterpret_cast<uint16_t*>(bytes.data());
+		for (size_t i = 0; i < indices.size(); ++i) out[i] = static_cast<uint16_t>(indices[i]);
+	}
+	else if (!indices.empty()) {
+		std::memcpy(bytes.data(), indices.data(), bytes.size());
+	}
+	return bytes;
+}
@@ -0,0 +1,73 @@
+#include <MeshDeserializer/CookedMeshDeserializer.h>
+#include <MeshDeserializer/CookedMeshFormat.h>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace CookedMeshFormat;
+
+namespace {
+	bool readHeader(std::span<const uint8_t> bytes, Header& header) {
+		if (bytes.size() < sizeof(header)) return false;
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		return std::memcmp(header.magic, magic, sizeof(magic)) == 0;
+	}
+
+	bool isCurrentHeader(const Header& header) {
+		return header.version == version;
+	}
+}
+
+CookedMeshView CookedMeshDeserializer::view(std::span<const uint8_t> bytes) {
+	Header header{};
+	if (bytes.size() < sizeof(header)) throw std::runtime_error("Cooked mesh: truncated header");
+	if (!readHeader(bytes, header)) throw std::runtime_error("Cooked mesh: bad magic");
+	if (!isCurrentHeader(header)) throw std::runtime_error("Cooked mesh: stale version, recook it");
+	for (const auto format : header.vertexFormats) {
+		if (format > static_cast<uint8_t>(VertexLayout::Format::Unorm8)) throw std::runtime_error("Cooked mesh: unknown vertex format");
+	}
+	const VertexLayout layout(static_cast<VertexLayout::Format>(header.vertexFormats[0]), static_cast<VertexLayout::Format>(header.vertexFormats[1]),
+		static_cast<VertexLayout::Format>(header.vertexFormats[2]), static_cast<VertexLayout::Format>(header.vertexFormats[3]));
+	if (header.vertexStride != static_cast<uint32_t>(layout.getStride())) throw std::runtime_error("Cooked mesh: vertex stride doesn't match its formats");
+	if (header.indexSize != 2 && header.indexSize != 4) throw std::runtime_error("Cooked mesh: bad index size");
+	if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(MeshLod) != 0) throw std::runtime_error("Cooked mesh: misaligned data");
+
+	const uint64_t size = bytes.size();
+	if (header.vertexOffset % 4 != 0 || header.vertexOffset > size || header.vertexCount > (size - header.vertexOffset) / header.vertexStride) {
+		throw std::runtime_error("Cooked mesh: vertices out of range");
+	}
+	if (header.indexOffset % header.indexSize != 0 || header.indexOffset > size || header.indexCount > (size - header.indexOffset) / header.indexSize) {
+		throw std::runtime_error("Cooked mesh: indices out of range");
+	}
+	if (header.lodOffset % alignof(MeshLod) != 0 || header.lodOffset > size || header.lodCount > (size - header.lodOffset) / sizeof(MeshLod)) {
+		throw std::runtime_error("Cooked mesh: levels of detail out of range");
+	}
+
+	CookedMeshView view;
+	view.layout = layout;
+	view.vertexCount = static_cast<size_t>(header.vertexCount);
+	view.vertices = bytes.subspan(static_cast<size_t>(header.vertexOffset), view.vertexCount * header.vertexStride);
+	view.indexType = header.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	view.indexCount = static_cast<size_t>(header.indexCount);
+	view.indices = bytes.subspan(static_cast<size_t>(header.indexOffset), view.indexCount * header.indexSize);
+	view.lods = { reinterpret_cast<const MeshLod*>(bytes.data() + header.lodOffset), static_cast<size_t>(header.lodCount) };
+	for (const auto& lod : view.lods) {
+		if (lod.firstIndex > view.indexCount || lod.indexCount > view.indexCount - lod.firstIndex) throw std::runtime_error("Cooked mesh: level of detail out of range");
+	}
+	view.boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+	view.boundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+	return view;
+}
+
+bool CookedMeshDeserializer::isCurrent(std::span<const uint8_t> bytes) {
+	Header header{};
+	return readHeader(bytes, header) && isCurrentHeader(header);
+}
+
+bool CookedMeshDeserializer::isCurrent(const std::string& filename) {
+	std::ifstream file{ filename, std::ios::binary };
+	uint8_t bytes[sizeof(Header)];
+	if (!file.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) return false;
+	return isCurrent(std::span<const uint8_t>(bytes, sizeof(bytes)));
+}
@@ -0,0 +1,61 @@
+#include <MeshDeserializer/CookedMeshSerializer.h>
+#include <MeshDeserializer/CookedMeshFormat.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace CookedMeshFormat;
+
+namespace {
+	uint64_t alignUp(uint64_t value) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+std::vector<uint8_t> CookedMeshSerializer::serialize(const MeshData& data, const VertexLayout& layout) {
+	const auto indexType = VertexLayout::getIndexType(data.vertices.size());
+	const auto vertices = layout.pack(data.vertices);
+	const auto indices = VertexLayout::packIndices(data.indices, indexType);
+
+	Header header{};
+	std::memcpy(header.magic, magic, sizeof(magic));
+	header.version = version;
+	header.vertexStride = static_cast<uint32_t>(layout.getStride());
+	for (size_t i = 0; i < layout.getAttributes().size(); ++i) header.vertexFormats[i] = static_cast<uint8_t>(layout.getAttributes()[i].format);
+	header.indexSize = static_cast<uint32_t>(VertexLayout::getIndexSize(indexType));
+	header.vertexCount = data.vertices.size();
+	header.indexCount = data.indices.size();
+	header.vertexOffset = alignUp(sizeof(Header));
+	header.indexOffset = alignUp(header.vertexOffset + vertices.size());
+	header.lodCount = static_cast<uint32_t>(data.lods.size());
+	header.lodOffset = alignUp(header.indexOffset + indices.size());
+
+	glm::vec3 boundsMin(std::numeric_limits<float>::max());
+	glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+	for (const auto& vertex : data.vertices) {
+		boundsMin = glm::min(boundsMin, vertex.position);
+		boundsMax = glm::max(boundsMax, vertex.position);
+	}
+	if (data.vertices.empty()) boundsMin = boundsMax = glm::vec3(0.0f);
+	std::memcpy(header.boundsMin, &boundsMin, sizeof(header.boundsMin));
+	std::memcpy(header.boundsMax, &boundsMax, sizeof(header.boundsMax));
+
+	std::vector<uint8_t> bytes(header.lodOffset + data.lods.size() * sizeof(MeshLod), 0);
+	std::memcpy(bytes.data(), &header, sizeof(header));
+	if (!vertices.empty()) std::memcpy(bytes.data() + header.vertexOffset, vertices.data(), vertices.size());
+	if (!indices.empty()) std::memcpy(bytes.data() + header.indexOffset, indices.data(), indices.size());
+	if (!data.lods.empty()) std::memcpy(bytes.data() + header.lodOffset, data.lods.data(), data.lods.size() * sizeof(MeshLod));
+	return bytes;
+}
+
+void CookedMeshSerializer::serialize(const MeshData& data, const std::string& filename, const VertexLayout& layout) {
+	const auto bytes = serialize(data, layout);
+	std::ofstream file{ filename, std::ios::binary | std::ios::trunc };
+	if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+	file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	if (!file.good()) throw std::runtime_error("Cannot write file: " + filename);
+}
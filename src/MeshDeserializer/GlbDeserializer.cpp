@@ -1,6 +1,6 @@
 // GlbDeserializer.cpp
 #include <MeshDeserializer/GlbDeserializer.h>
-#include <Mesh/Mesh3D.h>
+#include <Mesh/MeshData.h>
 #include <memory>
 #include <string>
 #include <fstream>
@@ -17,6 +17,7 @@
 #include <cstring>
 #include <cstdint>
 #include <algorithm>
+#include <span>
 
 using json = nlohmann::json;
 
@@ -53,7 +54,7 @@ static float normalizeUnsigned(uint64_t v, int bits) {
 }
 
 // Read accessor as array of floats (count * numComponents floats)
-static std::vector<float> readAccessorAsFloatArray(const json& doc, const std::vector<uint8_t>& binData, int accessorIndex) {
+static std::vector<float> readAccessorAsFloatArray(const json& doc, std::span<const uint8_t> binData, int accessorIndex) {
 	const auto& accessor = doc.at("accessors").at(accessorIndex);
 	size_t count = accessor.at("count").get<size_t>();
 	int componentType = accessor.at("componentType").get<int>();
@@ -142,7 +143,7 @@ static std::vector<float> readAccessorAsFloatArray(const json& doc, const std::v
 }
 
 // Read indices accessor -> vector<uint32_t>
-static std::vector<uint32_t> readIndices(const json& doc, const std::vector<uint8_t>& binData, int accessorIndex) {
+static std::vector<uint32_t> readIndices(const json& doc, std::span<const uint8_t> binData, int accessorIndex) {
 	const auto& accessor = doc.at("accessors").at(accessorIndex);
 	size_t count = accessor.at("count").get<size_t>();
 	int componentType = accessor.at("componentType").get<int>();
@@ -238,18 +239,32 @@ static void traverseNodesComputeWorld(const json& doc, int nodeIndex, const glm:
 	}
 }
 
-std::pair<std::vector<Mesh3D::Vertex>, std::vector<uint32_t>> GlbDeserializer::deserialize(const std::string& filename) {
-	std::ifstream file{ filename, std::ios::binary };
-	std::println("-- glb file deserializer (merge everything into one mesh) --");
-
+MeshData GlbDeserializer::deserialize(const std::string& filename) {
+	std::ifstream file{ filename, std::ios::binary | std::ios::ate };
 	if (!file.is_open()) {
 		throw std::runtime_error("Cannot open file: " + filename);
 	}
+	std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	if (!file) throw std::runtime_error("Failed to read file: " + filename);
+
+	return deserialize(bytes);
+}
+
+MeshData GlbDeserializer::deserialize(std::span<const uint8_t> bytes) {
+	std::println("-- glb file deserializer (merge everything into one mesh) --");
+
+	size_t cursor = 0;
+	auto read = [&bytes, &cursor](void* destination, size_t size, const char* what) {
+		if (cursor + size > bytes.size()) throw std::runtime_error(std::string("Failed to read ") + what);
+		std::memcpy(destination, bytes.data() + cursor, size);
+		cursor += size;
+	};
 
 	char magic[5] = { 0 };
-	file.read(magic, 4);
+	read(magic, 4, "magic");
 	std::println("magic {}", magic);
-	if (!file) throw std::runtime_error("Failed to read magic");
 
 	if (std::memcmp(magic, "glTF", 4)) {
 		throw std::runtime_error("File is not glb (bad magic)");
@@ -257,9 +272,8 @@ std::pair<std::vector<Mesh3D::Vertex>, std::vector<uint32_t>> GlbDeserializer::d
 
 	uint32_t version = 0;
 	uint32_t totalLength = 0;
-	file.read(reinterpret_cast<char*>(&version), sizeof(version));
-	file.read(reinterpret_cast<char*>(&totalLength), sizeof(totalLength));
-	if (!file) throw std::runtime_error("Failed to read header fields");
+	read(&version, sizeof(version), "header fields");
+	read(&totalLength, sizeof(totalLength), "header fields");
 
 	if (version != 2) {
 		throw std::runtime_error("Version isn't supported: " + std::to_string(version));
@@ -269,31 +283,27 @@ std::pair<std::vector<Mesh3D::Vertex>, std::vector<uint32_t>> GlbDeserializer::d
 	std::println("total length {}", totalLength);
 
 	json jsonDoc;
-	std::vector<uint8_t> binData;
-	uint32_t bytesRead = 12;
+	/* the BIN chunk is read in place, bytes must outlive the parse */
+	std::span<const uint8_t> binData;
+	const size_t end = std::min<size_t>(totalLength, bytes.size());
 
-	while (bytesRead < totalLength && file) {
+	while (cursor + 8 <= end) {
 		uint32_t chunkLength = 0;
-		file.read(reinterpret_cast<char*>(&chunkLength), sizeof(chunkLength));
-		if (!file) throw std::runtime_error("Failed to read chunkLength");
+		read(&chunkLength, sizeof(chunkLength), "chunkLength");
 		char chunkType[5] = { 0 };
-		file.read(chunkType, 4);
-		if (!file) throw std::runtime_error("Failed to read chunkType");
+		read(chunkType, 4, "chunkType");
 
-		bytesRead += 8;
 		std::println("chunk type '{}' length {}", std::string(chunkType, 4), chunkLength);
 
-		std::vector<char> chunkData(chunkLength);
-		file.read(chunkData.data(), chunkLength);
-		if (!file) throw std::runtime_error("Failed to read chunk data");
-		bytesRead += chunkLength;
+		if (cursor + chunkLength > bytes.size()) throw std::runtime_error("Failed to read chunk data");
+		const auto chunkData = bytes.subspan(cursor, chunkLength);
+		cursor += chunkLength;
 
 		if (!memcmp(chunkType, "JSON", 4)) {
-			std::string s(chunkData.begin(), chunkData.end());
-			jsonDoc = json::parse(s);
+			jsonDoc = json::parse(chunkData.begin(), chunkData.end());
 		}
 		else if (!memcmp(chunkType, "BIN", 4) || !memcmp(chunkType, "BIN\0", 4)) {
-			binData.assign(reinterpret_cast<uint8_t*>(chunkData.data()), reinterpret_cast<uint8_t*>(chunkData.data()) + chunkLength);
+			binData = chunkData;
 		}
 	}
 
@@ -323,7 +333,7 @@ std::pair<std::vector<Mesh3D::Vertex>, std::vector<uint32_t>> GlbDeserializer::d
 		}
 	}
 
-	std::vector<Mesh3D::Vertex> vertices;
+	std::vector<MeshVertex> vertices;
 	std::vector<uint32_t> indices;
 	vertices.reserve(1024);
 	indices.reserve(1024);
@@ -384,7 +394,7 @@ std::pair<std::vector<Mesh3D::Vertex>, std::vector<uint32_t>> GlbDeserializer::d
 
 				// append vertices (transform positions, normals, colors, texcoords)
 				for (size_t v = 0; v < vertexCount; ++v) {
-					Mesh3D::Vertex mv;
+					MeshVertex mv;
 					glm::vec4 pos4(positions[v * 3 + 0], positions[v * 3 + 1], positions[v * 3 + 2], 1.0f);
 					glm::vec4 wp = world * pos4;
 					mv.position = glm::vec3(wp.x, wp.y, wp.z);
@@ -494,7 +504,7 @@ std::pair<std::vector<Mesh3D::Vertex>, std::vector<uint32_t>> GlbDeserializer::d
 				size_t vertexCount = positions.size() / 3;
 
 				for (size_t v = 0; v < vertexCount; ++v) {
-					Mesh3D::Vertex mv;
+					MeshVertex mv;
 					glm::vec4 pos4(positions[v * 3 + 0], positions[v * 3 + 1], positions[v * 3 + 2], 1.0f);
 					glm::vec4 wp = world * pos4;
 					mv.position = glm::vec3(wp.x, wp.y, wp.z);
@@ -558,5 +568,5 @@ std::pair<std::vector<Mesh3D::Vertex>, std::vector<uint32_t>> GlbDeserializer::d
 		}
 	}
 
-	return { std::move(vertices), std::move(indices) };
+	return { std::move(vertices), std::move(indices), {} };
 }
@@ -0,0 +1,202 @@
+#include <Physics/BoxCollision.h>
+#include <Spatial/Obb.h>
+#include <glm/glm.hpp>
+#include <cmath>
+#include <limits>
+
+namespace {
+	struct Polygon {
+		glm::vec3 vertices[ContactManifold::maxPoints];
+		int count = 0;
+	};
+
+	/* Sutherland-Hodgman, keeps the part of the polygon where dot(normal, p) <= offset */
+	void clipPolygon(const Polygon& in, const glm::vec3& normal, float offset, Polygon& out) {
+		out.count = 0;
+		if (in.count == 0) return;
+
+		auto push = [&out](const glm::vec3& v) {
+			if (out.count < ContactManifold::maxPoints) out.vertices[out.count++] = v;
+		};
+
+		glm::vec3 a = in.vertices[in.count - 1];
+		float distanceA = glm::dot(normal, a) - offset;
+		for (int i = 0; i < in.count; ++i) {
+			const glm::vec3 b = in.vertices[i];
+			const float distanceB = glm::dot(normal, b) - offset;
+			if (distanceA <= 0.0f && distanceB <= 0.0f) {
+				push(b);
+			}
+			else if (distanceA <= 0.0f) {
+				push(a + (b - a) * (distanceA / (distanceA - distanceB)));
+			}
+			else if (distanceB <= 0.0f) {
+				push(a + (b - a) * (distanceA / (distanceA - distanceB)));
+				push(b);
+			}
+			a = b;
+			distanceA = distanceB;
+		}
+	}
+
+	float projectRadius(const Obb& box, const glm::vec3& axis) {
+		return box.halfExtents.x * std::abs(glm::dot(box.axes[0], axis))
+			+ box.halfExtents.y * std::abs(glm::dot(box.axes[1], axis))
+			+ box.halfExtents.z * std::abs(glm::dot(box.axes[2], axis));
+	}
+
+	/* normal points out of the reference box towards the incident box */
+	void clipFaces(const Obb& reference, int axis, const glm::vec3& normal, const Obb& incident, float margin, ContactManifold& out, bool flip) {
+		/* incident face is the one most anti-parallel to the reference normal */
+		int incidentAxis = 0;
+		float best = -1.0f;
+		for (int i = 0; i < 3; ++i) {
+			const float d = std::abs(glm::dot(incident.axes[i], normal));
+			if (d > best) {
+				best = d;
+				incidentAxis = i;
+			}
+		}
+		const float incidentSign = glm::dot(incident.axes[incidentAxis], normal) > 0.0f ? -1.0f : 1.0f;
+		const glm::vec3 faceCenter = incident.center + incident.axes[incidentAxis] * (incidentSign * incident.halfExtents[incidentAxis]);
+		const int u = (incidentAxis + 1) % 3, w = (incidentAxis + 2) % 3;
+		const glm::vec3 du = incident.axes[u] * incident.halfExtents[u];
+		const glm::vec3 dw = incident.axes[w] * incident.halfExtents[w];
+
+		Polygon polygon;
+		polygon.vertices[0] = faceCenter + du + dw;
+		polygon.vertices[1] = faceCenter - du + dw;
+		polygon.vertices[2] = faceCenter - du - dw;
+		polygon.vertices[3] = faceCenter + du - dw;
+		polygon.count = 4;
+
+		/* clip against the four side planes of the reference face */
+		Polygon clipped;
+		for (int side = 1; side <= 2; ++side) {
+			const int sideAxis = (axis + side) % 3;
+			const glm::vec3& sideNormal = reference.axes[sideAxis];
+			const float centerOffset = glm::dot(sideNormal, reference.center);
+			const float extent = reference.halfExtents[sideAxis];
+			clipPolygon(polygon, sideNormal, centerOffset + extent, clipped);
+			clipPolygon(clipped, -sideNormal, -centerOffset + extent, polygon);
+		}
+
+		const float faceOffset = glm::dot(normal, reference.center) + reference.halfExtents[axis];
+		out.normal = flip ? -normal : normal;
+		out.pointCount = 0;
+		for (int i = 0; i < polygon.count; ++i) {
+			const glm::vec3& point = polygon.vertices[i];
+			const float separation = glm::dot(normal, point) - faceOffset;
+			if (separation > margin) continue;
+			/* clipping along coincident edges emits the same vertex twice, which would skew the impulses */
+			const glm::vec3 position = point - normal * (separation * 0.5f);
+			bool duplicate = false;
+			for (int j = 0; j < out.pointCount && !duplicate; ++j) {
+				const glm::vec3 offset = out.points[j].position - position;
+				duplicate = glm::dot(offset, offset) < 1e-6f;
+			}
+			/* halfway between the incident point and the reference face */
+			if (!duplicate) out.points[out.pointCount++] = { position, -separation };
+		}
+	}
+
+	/* the edge of box parallel to box.axes[axis] that is furthest along direction */
+	glm::vec3 supportEdge(const Obb& box, int axis, const glm::vec3& direction) {
+		glm::vec3 point = box.center;
+		for (int i = 0; i < 3; ++i) {
+			if (i == axis) continue;
+			const float sign = glm::dot(box.axes[i], direction) >= 0.0f ? 1.0f : -1.0f;
+			point += box.axes[i] * (sign * box.halfExtents[i]);
+		}
+		return point;
+	}
+}
+
+bool collideBoxes(const Obb& a, const Obb& b, float margin, ContactManifold& out) {
+	out.pointCount = 0;
+	const glm::vec3 d = b.center - a.center;
+
+	float faceSeparationA = -std::numeric_limits<float>::max();
+	int faceAxisA = 0;
+	for (int i = 0; i < 3; ++i) {
+		const float separation = std::abs(glm::dot(d, a.axes[i])) - a.halfExtents[i] - projectRadius(b, a.axes[i]);
+		if (separation > margin) return false;
+		if (separation > faceSeparationA) {
+			faceSeparationA = separation;
+			faceAxisA = i;
+		}
+	}
+
+	float faceSeparationB = -std::numeric_limits<float>::max();
+	int faceAxisB = 0;
+	for (int i = 0; i < 3; ++i) {
+		const float separation = std::abs(glm::dot(d, b.axes[i])) - b.halfExtents[i] - projectRadius(a, b.axes[i]);
+		if (separation > margin) return false;
+		if (separation > faceSeparationB) {
+			faceSeparationB = separation;
+			faceAxisB = i;
+		}
+	}
+
+	float edgeSeparation = -std::numeric_limits<float>::max();
+	int edgeAxisA = -1, edgeAxisB = -1;
+	glm::vec3 edgeNormal{ 0.0f };
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			glm::vec3 axis = glm::cross(a.axes[i], b.axes[j]);
+			const float length = glm::length(axis);
+			/* parallel edges are already covered by the face axes */
+			if (length < 1e-4f) continue;
+			axis /= length;
+			const float separation = std::abs(glm::dot(d, axis)) - projectRadius(a, axis) - projectRadius(b, axis);
+			if (separation > margin) return false;
+			if (separation > edgeSeparation) {
+				edgeSeparation = separation;
+				edgeAxisA = i;
+				edgeAxisB = j;
+				edgeNormal = glm::dot(d, axis) < 0.0f ? -axis : axis;
+			}
+		}
+	}
+
+	/* prefer face contacts unless an edge axis is clearly better, keeps manifolds stable between frames */
+	constexpr float relativeTolerance = 0.95f;
+	constexpr float absoluteTolerance = 0.01f;
+
+	bool useFaceB = faceSeparationB > relativeTolerance * faceSeparationA + absoluteTolerance;
+	const float faceSeparation = useFaceB ? faceSeparationB : faceSeparationA;
+
+	if (edgeAxisA >= 0 && edgeSeparation > relativeTolerance * faceSeparation + absoluteTolerance) {
+		const glm::vec3 pointA = supportEdge(a, edgeAxisA, edgeNormal);
+		const glm::vec3 pointB = supportEdge(b, edgeAxisB, -edgeNormal);
+		const glm::vec3& directionA = a.axes[edgeAxisA];
+		const glm::vec3& directionB = b.axes[edgeAxisB];
+
+		/* closest points between the two edge lines, clamped to the edges */
+		const glm::vec3 r = pointA - pointB;
+		const float dotAB = glm::dot(directionA, directionB);
+		const float dotAR = glm::dot(directionA, r);
+		const float dotBR = glm::dot(directionB, r);
+		const float denominator = 1.0f - dotAB * dotAB;
+		float s = denominator > 1e-6f ? (dotAB * dotBR - dotAR) / denominator : 0.0f;
+		s = glm::clamp(s, -a.halfExtents[edgeAxisA], a.halfExtents[edgeAxisA]);
+		float t = glm::clamp(dotAB * s + dotBR, -b.halfExtents[edgeAxisB], b.halfExtents[edgeAxisB]);
+
+		const glm::vec3 closestA = pointA + directionA * s;
+		const glm::vec3 closestB = pointB + directionB * t;
+		out.normal = edgeNormal;
+		out.points[0] = { (closestA + closestB) * 0.5f, -edgeSeparation };
+		out.pointCount = 1;
+		return true;
+	}
+
+	if (useFaceB) {
+		const glm::vec3 normal = glm::dot(d, b.axes[faceAxisB]) > 0.0f ? -b.axes[faceAxisB] : b.axes[faceAxisB];
+		clipFaces(b, faceAxisB, normal, a, margin, out, true);
+	}
+	else {
+		const glm::vec3 normal = glm::dot(d, a.axes[faceAxisA]) < 0.0f ? -a.axes[faceAxisA] : a.axes[faceAxisA];
+		clipFaces(a, faceAxisA, normal, b, margin, out, false);
+	}
+	return out.pointCount > 0;
+}
@@ -0,0 +1,650 @@
+#define GLM_ENABLE_EXPERIMENTAL
+#include <Physics/PhysicsWorld.h>
+#include <Profiling/Profiler.h>
+#include <Physics/BoxCollision.h>
+#include <Spatial/Obb.h>
+#include <Threading/ThreadPool.h>
+#include <Instance/BasePart.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/euler_angles.hpp>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace {
+	constexpr size_t chunkSize = 64;
+	constexpr uint32_t noIsland = std::numeric_limits<uint32_t>::max();
+	/* contact points closer than this (in A's local space) carry their impulses into the next step */
+	constexpr float contactMatchDistance = 0.1f;
+
+	/* fn(chunk, begin, end) over chunkSize slices of [0, count) */
+	void forEachChunk(bool multithreaded, size_t count, const std::function<void(size_t, size_t, size_t)>& fn) {
+		const size_t chunks = (count + chunkSize - 1) / chunkSize;
+		auto run = [&](size_t chunk) { fn(chunk, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize)); };
+		if (!multithreaded || chunks <= 1) {
+			for (size_t chunk = 0; chunk < chunks; ++chunk) run(chunk);
+			return;
+		}
+		ThreadPool::getInstance().parallelFor(chunks, run);
+	}
+
+	glm::vec3 getTangent(const glm::vec3& normal) {
+		/* 0.57735 = 1 / sqrt(3), at least one component is this large */
+		if (std::abs(normal.x) >= 0.57735f) return glm::normalize(glm::vec3{ normal.y, -normal.x, 0.0f });
+		return glm::normalize(glm::vec3{ 0.0f, normal.z, -normal.y });
+	}
+
+	glm::mat3 getInverseInertiaWorld(const glm::quat& rotation, const glm::vec3& inverseInertiaLocal) {
+		const glm::mat3 r = glm::mat3_cast(rotation);
+		return r * glm::mat3(
+			inverseInertiaLocal.x, 0.0f, 0.0f,
+			0.0f, inverseInertiaLocal.y, 0.0f,
+			0.0f, 0.0f, inverseInertiaLocal.z) * glm::transpose(r);
+	}
+}
+
+PhysicsWorld::PhysicsWorld() : PhysicsWorld(Settings{}) {}
+
+PhysicsWorld::PhysicsWorld(const Settings& settings) : m_settings(settings) {}
+
+void PhysicsWorld::attach(const InstancePtr& root) {
+	detach();
+	if (!root) return;
+
+	for (const auto& inst : root->getDescendants()) {
+		if (auto part = std::dynamic_pointer_cast<BasePart>(inst)) insert(part);
+	}
+	m_addedConnection = root->descendantAdded.connect([this](InstancePtr inst) {
+		if (auto part = std::dynamic_pointer_cast<BasePart>(inst)) insert(part);
+	});
+	m_removingConnection = root->descendantRemoving.connect([this](InstancePtr inst) {
+		if (auto part = dynamic_cast<BasePart*>(inst.get())) remove(part);
+	});
+}
+
+void PhysicsWorld::detach() {
+	m_addedConnection.disconnect();
+	m_removingConnection.disconnect();
+	m_tree.clear();
+	m_bodies.clear();
+	m_freeBodies.clear();
+	m_lookup.clear();
+	m_awakeBodies.clear();
+	m_contacts.clear();
+	m_previousContacts.clear();
+	m_stats = Stats{};
+}
+
+void PhysicsWorld::insert(const std::shared_ptr<BasePart>& part) {
+	if (!part || m_lookup.contains(part.get())) return;
+
+	uint32_t index;
+	if (!m_freeBodies.empty()) {
+		index = m_freeBodies.back();
+		m_freeBodies.pop_back();
+	}
+	else {
+		index = static_cast<uint32_t>(m_bodies.size());
+		m_bodies.emplace_back();
+	}
+
+	m_bodies[index].part = part;
+	loadBody(index);
+	m_lookup.emplace(part.get(), index);
+}
+
+void PhysicsWorld::remove(const BasePart* part) {
+	auto it = m_lookup.find(part);
+	if (it == m_lookup.end()) return;
+	const uint32_t index = it->second;
+
+	std::erase_if(m_contacts, [&](const Contact& contact) {
+		return contact.bodyA == index || contact.bodyB == index;
+	});
+
+	/*
+	 * whatever rested on the body has to notice it's gone; contacts only cover awake bodies, so
+	 * sleeping ones are found through the tree, the rest of their islands wake through contacts
+	 */
+	Body& body = m_bodies[index];
+	m_tree.query(body.sweptBounds, [this, index](int32_t proxyId) {
+		const uint32_t other = m_tree.getUserData(proxyId);
+		if (other != index) wakeBody(other);
+		return true;
+	});
+	if (body.proxyId != DynamicAabbTree::nullNode) m_tree.destroyProxy(body.proxyId);
+	body = Body{};
+	m_freeBodies.push_back(index);
+	m_lookup.erase(it);
+}
+
+Obb PhysicsWorld::getBox(const Body& body) const {
+	return { body.position, glm::mat3_cast(body.rotation), body.halfExtents };
+}
+
+void PhysicsWorld::wakeBody(uint32_t index) {
+	Body& body = m_bodies[index];
+	if (body.isStatic || body.awake) return;
+	body.awake = true;
+	body.sleepTime = 0.0f;
+}
+
+void PhysicsWorld::loadBody(uint32_t index) {
+	Body& body = m_bodies[index];
+	const BasePart& part = *body.part;
+
+	body.position = part.position;
+	body.rotation = glm::normalize(glm::quat_cast(part.getRotationMatrix()));
+	body.stepRotation = body.rotation;
+	body.deltaPosition = glm::vec3(0.0f);
+	body.halfExtents = part.size * 0.5f;
+	body.friction = part.friction;
+	body.elasticity = part.elasticity;
+	body.isStatic = part.anchored;
+	body.canCollide = part.canCollide;
+	body.sleepTime = 0.0f;
+
+	if (body.isStatic) {
+		body.velocity = glm::vec3(0.0f);
+		body.angularVelocity = glm::vec3(0.0f);
+		body.inverseMass = 0.0f;
+		body.inverseInertiaLocal = glm::vec3(0.0f);
+		body.awake = false;
+	}
+	else {
+		const glm::vec3 size = glm::max(part.size, glm::vec3(1e-3f));
+		const float mass = std::max(part.density, 1e-3f) * size.x * size.y * size.z;
+		const glm::vec3 squared = size * size;
+		body.velocity = part.velocity;
+		body.angularVelocity = part.angularVelocity;
+		body.inverseMass = 1.0f / mass;
+		body.inverseInertiaLocal = 12.0f / (mass * glm::vec3{ squared.y + squared.z, squared.x + squared.z, squared.x + squared.y });
+		body.awake = true;
+	}
+	body.inverseInertiaWorld = getInverseInertiaWorld(body.rotation, body.inverseInertiaLocal);
+	body.bounds = getBox(body).getBounds();
+	body.sweptBounds = { body.bounds.min - glm::vec3(m_settings.contactMargin), body.bounds.max + glm::vec3(m_settings.contactMargin) };
+
+	if (body.canCollide) {
+		if (body.proxyId == DynamicAabbTree::nullNode) body.proxyId = m_tree.createProxy(body.sweptBounds, index);
+		else m_tree.moveProxy(body.proxyId, body.sweptBounds);
+	}
+	else if (body.proxyId != DynamicAabbTree::nullNode) {
+		m_tree.destroyProxy(body.proxyId);
+		body.proxyId = DynamicAabbTree::nullNode;
+	}
+
+	body.syncedPosition = part.position;
+	body.syncedOrientation = part.orientation;
+	body.syncedSize = part.size;
+	body.syncedVelocity = part.velocity;
+	body.syncedAngularVelocity = part.angularVelocity;
+	body.syncedDensity = part.density;
+	body.syncedAnchored = part.anchored;
+	body.syncedCanCollide = part.canCollide;
+}
+
+void PhysicsWorld::syncFromParts() {
+	for (uint32_t index = 0; index < m_bodies.size(); ++index) {
+		Body& body = m_bodies[index];
+		if (!body.part) continue;
+		const BasePart& part = *body.part;
+
+		const bool changed = part.position != body.syncedPosition || part.orientation != body.syncedOrientation
+			|| part.size != body.syncedSize || part.velocity != body.syncedVelocity
+			|| part.angularVelocity != body.syncedAngularVelocity || part.density != body.syncedDensity
+			|| part.anchored != body.syncedAnchored || part.canCollide != body.syncedCanCollide;
+		if (!changed) {
+			body.friction = part.friction;
+			body.elasticity = part.elasticity;
+			continue;
+		}
+
+		const Aabb oldBounds = body.bounds;
+		loadBody(index);
+		/* wake anything touching the old or new placement */
+		m_tree.query(Aabb::merge(oldBounds, body.bounds), [this](int32_t proxyId) {
+			wakeBody(m_tree.getUserData(proxyId));
+			return true;
+		});
+	}
+
+	m_awakeBodies.clear();
+	for (uint32_t index = 0; index < m_bodies.size(); ++index) {
+		const Body& body = m_bodies[index];
+		if (body.part && !body.isStatic && body.awake) m_awakeBodies.push_back(index);
+	}
+}
+
+void PhysicsWorld::updateBroadPhase(float dt) {
+	const glm::vec3 margin(m_settings.contactMargin);
+	for (const uint32_t index : m_awakeBodies) {
+		Body& body = m_bodies[index];
+		const glm::vec3 displacement = body.velocity * dt;
+		body.sweptBounds = {
+			glm::min(body.bounds.min, body.bounds.min + displacement) - margin,
+			glm::max(body.bounds.max, body.bounds.max + displacement) + margin
+		};
+		if (body.proxyId != DynamicAabbTree::nullNode) m_tree.moveProxy(body.proxyId, body.sweptBounds, displacement);
+	}
+}
+
+void PhysicsWorld::findContacts(float dt) {
+	const size_t awakeCount = m_awakeBodies.size();
+	std::vector<std::vector<uint64_t>> chunkPairs((awakeCount + chunkSize - 1) / chunkSize);
+	forEachChunk(m_settings.multithreaded, awakeCount, [&](size_t chunk, size_t begin, size_t end) {
+		auto& pairs = chunkPairs[chunk];
+		for (size_t i = begin; i < end; ++i) {
+			const uint32_t index = m_awakeBodies[i];
+			const Body& body = m_bodies[index];
+			if (!body.canCollide) continue;
+
+			m_tree.query(body.sweptBounds, [&](int32_t proxyId) {
+				const uint32_t otherIndex = m_tree.getUserData(proxyId);
+				const Body& other = m_bodies[otherIndex];
+				/* pairs of awake bodies are reported by the lower index only */
+				if (otherIndex == index || (!other.isStatic && other.awake && otherIndex < index)) return true;
+				if (!body.sweptBounds.overlaps(other.sweptBounds)) return true;
+				const uint32_t a = std::min(index, otherIndex), b = std::max(index, otherIndex);
+				pairs.push_back((static_cast<uint64_t>(a) << 32) | b);
+				return true;
+			});
+		}
+	});
+
+	m_pairs.clear();
+	for (const auto& pairs : chunkPairs) m_pairs.insert(m_pairs.end(), pairs.begin(), pairs.end());
+	std::sort(m_pairs.begin(), m_pairs.end());
+
+	std::swap(m_previousContacts, m_contacts);
+	std::vector<Contact> candidates(m_pairs.size());
+	std::vector<uint8_t> touching(m_pairs.size(), 0);
+
+	forEachChunk(m_settings.multithreaded, m_pairs.size(), [&](size_t, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			const uint64_t key = m_pairs[i];
+			Contact& contact = candidates[i];
+			contact.bodyA = static_cast<uint32_t>(key >> 32);
+			contact.bodyB = static_cast<uint32_t>(key);
+			const Body& a = m_bodies[contact.bodyA];
+			const Body& b = m_bodies[contact.bodyB];
+
+			/* speculative margin grows with the closing motion so fast parts can't tunnel through thin ones */
+			const float margin = m_settings.contactMargin + glm::length(b.velocity - a.velocity) * dt;
+			ContactManifold manifold;
+			if (!collideBoxes(getBox(a), getBox(b), margin, manifold)) continue;
+			touching[i] = 1;
+
+			contact.normal = manifold.normal;
+			contact.tangents[0] = getTangent(manifold.normal);
+			contact.tangents[1] = glm::cross(manifold.normal, contact.tangents[0]);
+			contact.friction = std::sqrt(a.friction * b.friction);
+			contact.elasticity = std::max(a.elasticity, b.elasticity);
+			contact.pointCount = manifold.pointCount;
+
+			auto previous = std::lower_bound(m_previousContacts.begin(), m_previousContacts.end(), key,
+				[](const Contact& c, uint64_t k) { return c.getKey() < k; });
+			const bool hasPrevious = previous != m_previousContacts.end() && previous->getKey() == key;
+
+			const glm::quat inverseRotation = glm::conjugate(a.rotation);
+			for (int p = 0; p < manifold.pointCount; ++p) {
+				ContactConstraintPoint& point = contact.points[p];
+				point = ContactConstraintPoint{};
+				point.rA = manifold.points[p].position - a.position;
+				point.rB = manifold.points[p].position - b.position;
+				point.localPoint = inverseRotation * point.rA;
+				point.penetration = manifold.points[p].penetration;
+				if (!hasPrevious) continue;
+
+				for (int q = 0; q < previous->pointCount; ++q) {
+					const glm::vec3 offset = previous->points[q].localPoint - point.localPoint;
+					if (glm::dot(offset, offset) > contactMatchDistance * contactMatchDistance) continue;
+					point.normalImpulse = previous->points[q].normalImpulse;
+					point.tangentImpulse[0] = previous->points[q].tangentImpulse[0];
+					point.tangentImpulse[1] = previous->points[q].tangentImpulse[1];
+					break;
+				}
+			}
+		}
+	});
+
+	m_contacts.clear();
+	for (size_t i = 0; i < candidates.size(); ++i) {
+		if (touching[i]) m_contacts.push_back(candidates[i]);
+	}
+}
+
+void PhysicsWorld::buildIslands() {
+	/* awake bodies touching sleeping ones wake them, they join the island this step */
+	for (const Contact& contact : m_contacts) {
+		wakeBody(contact.bodyA);
+		wakeBody(contact.bodyB);
+	}
+	m_awakeBodies.clear();
+	for (uint32_t index = 0; index < m_bodies.size(); ++index) {
+		const Body& body = m_bodies[index];
+		if (body.part && !body.isStatic && body.awake) m_awakeBodies.push_back(index);
+	}
+
+	/* union-find over dynamic bodies, static bodies never join islands */
+	std::vector<uint32_t> parent(m_bodies.size());
+	for (const uint32_t index : m_awakeBodies) parent[index] = index;
+	auto find = [&parent](uint32_t index) {
+		while (parent[index] != index) {
+			parent[index] = parent[parent[index]];
+			index = parent[index];
+		}
+		return index;
+	};
+	for (const Contact& contact : m_contacts) {
+		if (m_bodies[contact.bodyA].isStatic || m_bodies[contact.bodyB].isStatic) continue;
+		const uint32_t rootA = find(contact.bodyA), rootB = find(contact.bodyB);
+		if (rootA < rootB) parent[rootB] = rootA;
+		else if (rootB < rootA) parent[rootA] = rootB;
+	}
+
+	/* number islands in order of their lowest body so the layout doesn't depend on anything else */
+	std::vector<uint32_t> islandOf(m_bodies.size(), noIsland);
+	std::vector<uint32_t> islandOfRoot(m_bodies.size(), noIsland);
+	uint32_t islandCount = 0;
+	for (const uint32_t index : m_awakeBodies) {
+		const uint32_t root = find(index);
+		if (islandOfRoot[root] == noIsland) islandOfRoot[root] = islandCount++;
+		islandOf[index] = islandOfRoot[root];
+	}
+
+	m_islandBodyOffsets.assign(islandCount + 1, 0);
+	m_islandContactOffsets.assign(islandCount + 1, 0);
+	for (const uint32_t index : m_awakeBodies) ++m_islandBodyOffsets[islandOf[index] + 1];
+	auto contactIsland = [&](const Contact& contact) {
+		return m_bodies[contact.bodyA].isStatic ? islandOf[contact.bodyB] : islandOf[contact.bodyA];
+	};
+	for (const Contact& contact : m_contacts) ++m_islandContactOffsets[contactIsland(contact) + 1];
+	for (uint32_t island = 0; island < islandCount; ++island) {
+		m_islandBodyOffsets[island + 1] += m_islandBodyOffsets[island];
+		m_islandContactOffsets[island + 1] += m_islandContactOffsets[island];
+	}
+
+	m_islandBodies.resize(m_awakeBodies.size());
+	m_islandContacts.resize(m_contacts.size());
+	std::vector<uint32_t> bodyCursor(m_islandBodyOffsets.begin(), m_islandBodyOffsets.end() - 1);
+	std::vector<uint32_t> contactCursor(m_islandContactOffsets.begin(), m_islandContactOffsets.end() - 1);
+	for (const uint32_t index : m_awakeBodies) m_islandBodies[bodyCursor[islandOf[index]]++] = index;
+	for (uint32_t i = 0; i < m_contacts.size(); ++i) m_islandContacts[contactCursor[contactIsland(m_contacts[i])]++] = i;
+}
+
+void PhysicsWorld::solveIsland(size_t island, float dt) {
+	const uint32_t* bodies = m_islandBodies.data() + m_islandBodyOffsets[island];
+	const size_t bodyCount = m_islandBodyOffsets[island + 1] - m_islandBodyOffsets[island];
+	const uint32_t* contacts = m_islandContacts.data() + m_islandContactOffsets[island];
+	const size_t contactCount = m_islandContactOffsets[island + 1] - m_islandContactOffsets[island];
+
+	const int substeps = std::max(m_settings.substeps, 1);
+	const float h = dt / static_cast<float>(substeps);
+	const float inverseH = 1.0f / h;
+
+	/* contacts act as damped springs at contactHertz, stiffer would only fight the substep rate */
+	const float omega = 2.0f * glm::pi<float>() * std::min(m_settings.contactHertz, 0.25f * inverseH);
+	const float a1 = 2.0f * m_settings.contactDampingRatio + h * omega;
+	const float a2 = h * omega * a1;
+	const float a3 = 1.0f / (1.0f + a2);
+	const float biasRate = omega / a1;
+	const float softMassScale = a2 * a3;
+	const float softImpulseScale = a3;
+
+	for (size_t i = 0; i < bodyCount; ++i) {
+		Body& body = m_bodies[bodies[i]];
+		body.deltaPosition = glm::vec3(0.0f);
+		body.stepRotation = body.rotation;
+	}
+
+	/* static bodies are shared between islands, only dynamic ones are ever written */
+	auto applyImpulse = [](Body& body, const glm::vec3& impulse, const glm::vec3& r) {
+		if (body.isStatic) return;
+		body.velocity += impulse * body.inverseMass;
+		body.angularVelocity += body.inverseInertiaWorld * glm::cross(r, impulse);
+	};
+	auto relativeVelocity = [](const Body& a, const Body& b, const ContactConstraintPoint& point) {
+		return b.velocity + glm::cross(b.angularVelocity, point.rB) - a.velocity - glm::cross(a.angularVelocity, point.rA);
+	};
+	auto effectiveMass = [](const Body& a, const Body& b, const ContactConstraintPoint& point, const glm::vec3& direction) {
+		const glm::vec3 rnA = glm::cross(point.rA, direction);
+		const glm::vec3 rnB = glm::cross(point.rB, direction);
+		const float k = a.inverseMass + b.inverseMass
+			+ glm::dot(rnA, a.inverseInertiaWorld * rnA) + glm::dot(rnB, b.inverseInertiaWorld * rnB);
+		return k > 0.0f ? 1.0f / k : 0.0f;
+	};
+
+	for (size_t c = 0; c < contactCount; ++c) {
+		Contact& contact = m_contacts[contacts[c]];
+		const Body& a = m_bodies[contact.bodyA];
+		const Body& b = m_bodies[contact.bodyB];
+		for (int p = 0; p < contact.pointCount; ++p) {
+			ContactConstraintPoint& point = contact.points[p];
+			point.normalMass = effectiveMass(a, b, point, contact.normal);
+			point.tangentMass[0] = effectiveMass(a, b, point, contact.tangents[0]);
+			point.tangentMass[1] = effectiveMass(a, b, point, contact.tangents[1]);
+			/* the separation at the step's start minus the anchors' offset, see currentSeparation */
+			point.adjustedSeparation = -point.penetration - glm::dot(point.rB - point.rA, contact.normal);
+			point.approachSpeed = glm::dot(relativeVelocity(a, b, point), contact.normal);
+			point.maxNormalImpulse = 0.0f;
+		}
+	}
+
+	/* the anchors stay fixed for the whole step, the separation follows the bodies' motion so far */
+	auto currentSeparation = [](const Body& a, const Body& b, const glm::quat& deltaA, const glm::quat& deltaB, const Contact& contact, const ContactConstraintPoint& point) {
+		const glm::vec3 d = (b.deltaPosition - a.deltaPosition) + (deltaB * point.rB - deltaA * point.rA);
+		return glm::dot(d, contact.normal) + point.adjustedSeparation;
+	};
+
+	/* useBias pushes overlapping points apart, the relax pass afterwards removes the velocity that added */
+	auto solveContacts = [&](bool useBias) {
+		for (size_t c = 0; c < contactCount; ++c) {
+			Contact& contact = m_contacts[contacts[c]];
+			Body& a = m_bodies[contact.bodyA];
+			Body& b = m_bodies[contact.bodyB];
+			const glm::quat deltaA = a.rotation * glm::conjugate(a.stepRotation);
+			const glm::quat deltaB = b.rotation * glm::conjugate(b.stepRotation);
+
+			for (int p = 0; p < contact.pointCount; ++p) {
+				ContactConstraintPoint& point = contact.points[p];
+				const float separation = currentSeparation(a, b, deltaA, deltaB, contact, point);
+
+				float bias = 0.0f, massScale = 1.0f, impulseScale = 0.0f;
+				if (separation > 0.0f) {
+					/* speculative, only stops the approach at the gap */
+					bias = separation * inverseH;
+				}
+				else if (useBias) {
+					bias = std::max(biasRate * separation, -m_settings.contactPushVelocity);
+					massScale = softMassScale;
+					impulseScale = softImpulseScale;
+				}
+
+				const float speed = glm::dot(relativeVelocity(a, b, point), contact.normal);
+				const float impulse = -point.normalMass * massScale * (speed + bias) - impulseScale * point.normalImpulse;
+				const float newImpulse = std::max(point.normalImpulse + impulse, 0.0f);
+				const glm::vec3 applied = contact.normal * (newImpulse - point.normalImpulse);
+				point.maxNormalImpulse = std::max(point.maxNormalImpulse, newImpulse - point.normalImpulse);
+				point.normalImpulse = newImpulse;
+				applyImpulse(a, -applied, point.rA);
+				applyImpulse(b, applied, point.rB);
+			}
+
+			for (int p = 0; p < contact.pointCount; ++p) {
+				ContactConstraintPoint& point = contact.points[p];
+				const float maxFriction = contact.friction * point.normalImpulse;
+				for (int t = 0; t < 2; ++t) {
+					const float speed = glm::dot(relativeVelocity(a, b, point), contact.tangents[t]);
+					const float oldImpulse = point.tangentImpulse[t];
+					point.tangentImpulse[t] = glm::clamp(oldImpulse - speed * point.tangentMass[t], -maxFriction, maxFriction);
+					const glm::vec3 impulse = contact.tangents[t] * (point.tangentImpulse[t] - oldImpulse);
+					applyImpulse(a, -impulse, point.rA);
+					applyImpulse(b, impulse, point.rB);
+				}
+			}
+		}
+	};
+
+	for (int substep = 0; substep < substeps; ++substep) {
+		for (size_t i = 0; i < bodyCount; ++i) {
+			m_bodies[bodies[i]].velocity += m_settings.gravity * h;
+		}
+
+		/* accumulated impulses are per substep, so every substep starts from them */
+		for (size_t c = 0; c < contactCount; ++c) {
+			const Contact& contact = m_contacts[contacts[c]];
+			Body& a = m_bodies[contact.bodyA];
+			Body& b = m_bodies[contact.bodyB];
+			for (int p = 0; p < contact.pointCount; ++p) {
+				const ContactConstraintPoint& point = contact.points[p];
+				const glm::vec3 impulse = contact.normal * point.normalImpulse
+					+ contact.tangents[0] * point.tangentImpulse[0] + contact.tangents[1] * point.tangentImpulse[1];
+				applyImpulse(a, -impulse, point.rA);
+				applyImpulse(b, impulse, point.rB);
+			}
+		}
+
+		solveContacts(true);
+
+		for (size_t i = 0; i < bodyCount; ++i) {
+			Body& body = m_bodies[bodies[i]];
+			body.position += body.velocity * h;
+			body.deltaPosition += body.velocity * h;
+			const glm::quat spin{ 0.0f, body.angularVelocity.x, body.angularVelocity.y, body.angularVelocity.z };
+			body.rotation = glm::normalize(body.rotation + spin * body.rotation * (0.5f * h));
+		}
+
+		solveContacts(false);
+	}
+
+	/* bounce once after the substeps, and only off points that were approaching fast and got pushed */
+	for (size_t c = 0; c < contactCount; ++c) {
+		Contact& contact = m_contacts[contacts[c]];
+		if (contact.elasticity <= 0.0f) continue;
+		Body& a = m_bodies[contact.bodyA];
+		Body& b = m_bodies[contact.bodyB];
+		for (int p = 0; p < contact.pointCount; ++p) {
+			ContactConstraintPoint& point = contact.points[p];
+			if (point.approachSpeed > -m_settings.restitutionThreshold || point.maxNormalImpulse == 0.0f) continue;
+
+			const float speed = glm::dot(relativeVelocity(a, b, point), contact.normal);
+			const float impulse = -point.normalMass * (speed + contact.elasticity * point.approachSpeed);
+			const float newImpulse = std::max(point.normalImpulse + impulse, 0.0f);
+			const glm::vec3 applied = contact.normal * (newImpulse - point.normalImpulse);
+			point.normalImpulse = newImpulse;
+			applyImpulse(a, -applied, point.rA);
+			applyImpulse(b, applied, point.rB);
+		}
+	}
+
+	const float linearTolerance = m_settings.sleepLinearVelocity * m_settings.sleepLinearVelocity;
+	const float angularTolerance = m_settings.sleepAngularVelocity * m_settings.sleepAngularVelocity;
+	float minSleepTime = std::numeric_limits<float>::max();
+	for (size_t i = 0; i < bodyCount; ++i) {
+		Body& body = m_bodies[bodies[i]];
+		body.inverseInertiaWorld = getInverseInertiaWorld(body.rotation, body.inverseInertiaLocal);
+		body.bounds = getBox(body).getBounds();
+
+		if (glm::dot(body.velocity, body.velocity) > linearTolerance || glm::dot(body.angularVelocity, body.angularVelocity) > angularTolerance) {
+			body.sleepTime = 0.0f;
+		}
+		else {
+			body.sleepTime += dt;
+		}
+		minSleepTime = std::min(minSleepTime, body.sleepTime);
+	}
+
+	/* islands sleep as a whole so a resting stack doesn't wake itself up piece by piece */
+	if (minSleepTime >= m_settings.timeToSleep) {
+		for (size_t i = 0; i < bodyCount; ++i) {
+			Body& body = m_bodies[bodies[i]];
+			body.awake = false;
+			body.velocity = glm::vec3(0.0f);
+			body.angularVelocity = glm::vec3(0.0f);
+			body.deltaPosition = glm::vec3(0.0f);
+			body.stepRotation = body.rotation;
+		}
+	}
+}
+
+std::optional<glm::mat4> PhysicsWorld::getInterpolatedModelMatrix(const BasePart* part, float alpha) const {
+	auto it = m_lookup.find(part);
+	if (it == m_lookup.end()) return std::nullopt;
+	const Body& body = m_bodies[it->second];
+
+	const glm::vec3 position = body.position - body.deltaPosition * (1.0f - alpha);
+	const glm::quat rotation = glm::slerp(body.stepRotation, body.rotation, alpha);
+	glm::mat4 model = glm::mat4_cast(rotation);
+	model[3] = glm::vec4(position, 1.0f);
+	return glm::scale(model, body.halfExtents * 2.0f);
+}
+
+void PhysicsWorld::writeToParts() {
+	forEachChunk(m_settings.multithreaded, m_islandBodies.size(), [&](size_t, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			Body& body = m_bodies[m_islandBodies[i]];
+			BasePart& part = *body.part;
+
+			float yaw, pitch, roll;
+			glm::extractEulerAngleYXZ(glm::mat4_cast(body.rotation), yaw, pitch, roll);
+			part.position = body.position;
+			part.orientation = glm::degrees(glm::vec3{ pitch, yaw, roll });
+			part.velocity = body.velocity;
+			part.angularVelocity = body.angularVelocity;
+
+			body.syncedPosition = part.position;
+			body.syncedOrientation = part.orientation;
+			body.syncedVelocity = part.velocity;
+			body.syncedAngularVelocity = part.angularVelocity;
+		}
+	});
+}
+
+void PhysicsWorld::step(float dt) {
+	if (dt <= 0.0f) return;
+	PROFILE_ZONE("Physics");
+	const auto start = std::chrono::steady_clock::now();
+
+	syncFromParts();
+	updateBroadPhase(dt);
+	findContacts(dt);
+	buildIslands();
+
+	const size_t islandCount = m_islandBodyOffsets.empty() ? 0 : m_islandBodyOffsets.size() - 1;
+	if (m_settings.multithreaded && islandCount > 1) {
+		ThreadPool::getInstance().parallelFor(islandCount, [this, dt](size_t island) {
+			PROFILE_ZONE("Solve Island");
+			solveIsland(island, dt);
+		});
+	}
+	else {
+		for (size_t island = 0; island < islandCount; ++island) solveIsland(island, dt);
+	}
+
+	writeToParts();
+
+	m_stats.bodyCount = m_lookup.size();
+	m_stats.awakeBodyCount = 0;
+	for (const uint32_t index : m_islandBodies) {
+		if (m_bodies[index].awake) ++m_stats.awakeBodyCount;
+	}
+	m_stats.contactCount = m_contacts.size();
+	m_stats.islandCount = islandCount;
+
+	/* destroying fires descendantRemoving, which calls back into remove() */
+	std::vector<std::shared_ptr<BasePart>> fallen;
+	for (const uint32_t index : m_islandBodies) {
+		if (m_bodies[index].position.y < m_settings.fallenPartsDestroyHeight) fallen.push_back(m_bodies[index].part);
+	}
+	for (const auto& part : fallen) part->destroy();
+
+	m_stats.stepMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
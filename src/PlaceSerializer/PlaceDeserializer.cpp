@@ -0,0 +1,275 @@
+#include <PlaceSerializer/PlaceDeserializer.h>
+#include <PlaceSerializer/PlaceFormat.h>
+#include <Instance/Instance.h>
+#include <Instance/InstanceFactory.h>
+#include <Instance/BasePart.h>
+#include <Instance/Script.h>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+using namespace PlaceFormat;
+
+namespace {
+	struct ClassInfo {
+		std::string className;
+		std::vector<InstancePtr> instances;
+		std::vector<BasePart*> parts;
+	};
+
+	struct ReadState {
+		std::vector<ClassInfo> classes;
+		/* class ids in the file are below this */
+		uint32_t classCount = 0;
+		std::vector<InstancePtr> byReferent;
+		InstancePtr root;
+		/* children whose parent lives in the place body (regions only) */
+		std::vector<std::pair<InstancePtr, int32_t>> external;
+	};
+}
+
+static void readColumn(ByteReader& reader, const std::vector<BasePart*>& parts, bool BasePart::* member) {
+	const auto* in = reader.take(parts.size());
+	for (size_t i = 0; i < parts.size(); ++i) parts[i]->*member = in[i] != 0;
+}
+
+static void readColumn(ByteReader& reader, const std::vector<BasePart*>& parts, float BasePart::* member) {
+	const auto* in = reader.take(parts.size() * sizeof(float));
+	for (size_t i = 0; i < parts.size(); ++i) std::memcpy(&(parts[i]->*member), in + i * sizeof(float), sizeof(float));
+}
+
+static void readColumn(ByteReader& reader, const std::vector<BasePart*>& parts, glm::vec3 BasePart::* member) {
+	for (int c = 0; c < 3; ++c) {
+		const auto* in = reader.take(parts.size() * sizeof(float));
+		for (size_t i = 0; i < parts.size(); ++i) std::memcpy(&(parts[i]->*member)[c], in + i * sizeof(float), sizeof(float));
+	}
+}
+
+static void readColumn(ByteReader& reader, const std::vector<BasePart*>& parts, glm::u8vec3 BasePart::* member) {
+	for (int c = 0; c < 3; ++c) {
+		const auto* in = reader.take(parts.size());
+		for (size_t i = 0; i < parts.size(); ++i) (parts[i]->*member)[c] = in[i];
+	}
+}
+
+static void readInstances(ByteReader& reader, ReadState& state) {
+	auto& classes = state.classes;
+	auto& byReferent = state.byReferent;
+	const auto classId = reader.read<uint32_t>();
+	auto className = reader.readString();
+	const auto count = reader.read<uint32_t>();
+
+	if (classId >= state.classCount) {
+		throw std::runtime_error("Place class id out of range: " + std::to_string(classId));
+	}
+	if (classId >= classes.size()) classes.resize(classId + 1);
+	auto& info = classes[classId];
+	info.className = std::move(className);
+	info.instances.reserve(count);
+
+	auto& factory = InstanceFactory::getInstance();
+	const auto* referents = reader.take(count * sizeof(int32_t));
+	for (uint32_t i = 0; i < count; ++i) {
+		int32_t referent;
+		std::memcpy(&referent, referents + i * sizeof(int32_t), sizeof(int32_t));
+		if (referent < 0 || static_cast<size_t>(referent) >= byReferent.size()) {
+			throw std::runtime_error("Place referent out of range: " + std::to_string(referent));
+		}
+
+		auto inst = factory.create(info.className);
+		if (!inst) inst = std::make_shared<Instance>();
+		if (auto part = dynamic_cast<BasePart*>(inst.get())) info.parts.push_back(part);
+
+		byReferent[referent] = inst;
+		info.instances.push_back(std::move(inst));
+	}
+	if (!info.parts.empty() && info.parts.size() != info.instances.size()) info.parts.clear();
+}
+
+static void readProperty(ByteReader& reader, std::vector<ClassInfo>& classes) {
+	const auto classId = reader.read<uint32_t>();
+	const auto propertyName = reader.readString();
+	const auto type = reader.read<PropertyType>();
+	if (classId >= classes.size()) throw std::runtime_error("Place property references unknown class");
+	auto& info = classes[classId];
+
+	if (propertyName == "Name" && type == PropertyType::String) {
+		for (auto& inst : info.instances) inst->name = reader.readString();
+		return;
+	}
+	if (propertyName == "Source" && type == PropertyType::String) {
+		for (auto& inst : info.instances) {
+			auto source = reader.readString();
+			if (auto script = dynamic_cast<Script*>(inst.get())) script->source = std::move(source);
+		}
+		return;
+	}
+	if (info.parts.empty()) return;
+
+	for (const auto& property : basePartProperties) {
+		if (propertyName != property.name) continue;
+		std::visit([&](auto member) {
+			using T = std::remove_cvref_t<decltype(info.parts.front()->*member)>;
+			if (propertyTypeOf<T>() == type) readColumn(reader, info.parts, member);
+		}, property.member);
+		return;
+	}
+}
+
+static void readParents(ByteReader& reader, ReadState& state) {
+	const auto& byReferent = state.byReferent;
+	const auto count = reader.read<uint32_t>();
+	const auto* children = reader.take(count * sizeof(int32_t));
+	const auto* parents = reader.take(count * sizeof(int32_t));
+
+	for (uint32_t i = 0; i < count; ++i) {
+		int32_t child, par;
+		std::memcpy(&child, children + i * sizeof(int32_t), sizeof(int32_t));
+		std::memcpy(&par, parents + i * sizeof(int32_t), sizeof(int32_t));
+		if (child < 0 || static_cast<size_t>(child) >= byReferent.size() || !byReferent[child]) {
+			throw std::runtime_error("Place parent chunk references unknown instance");
+		}
+
+		if (par == -1) {
+			if (!state.root) state.root = byReferent[child];
+			continue;
+		}
+		if (par < -1) {
+			state.external.emplace_back(byReferent[child], decodeBaseReferent(par));
+			continue;
+		}
+		if (static_cast<size_t>(par) >= byReferent.size() || !byReferent[par]) {
+			throw std::runtime_error("Place parent chunk references unknown parent");
+		}
+		if (par == child) {
+			throw std::runtime_error("Place parent chunk parents an instance to itself");
+		}
+		/* throws on longer cycles */
+		byReferent[child]->setParent(byReferent[par]);
+	}
+}
+
+static void readChunk(const ChunkHeader& chunk, ByteReader& reader, ReadState& state) {
+	if (!std::memcmp(chunk.type, chunkInstances, 4)) {
+		readInstances(reader, state);
+	}
+	else if (!std::memcmp(chunk.type, chunkProperty, 4)) {
+		readProperty(reader, state.classes);
+	}
+	else if (!std::memcmp(chunk.type, chunkParents, 4)) {
+		readParents(reader, state);
+	}
+}
+
+PlaceDocument PlaceDeserializer::open(const std::string& filename) {
+	std::ifstream file{ filename, std::ios::binary };
+	if (!file.is_open()) {
+		throw std::runtime_error("Cannot open file: " + filename);
+	}
+
+	Header header{};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file) throw std::runtime_error("Failed to read place header");
+	if (std::memcmp(header.magic, magic, sizeof(header.magic))) {
+		throw std::runtime_error("File is not a place (bad magic)");
+	}
+	if (header.version != version) {
+		throw std::runtime_error("Place version isn't supported: " + std::to_string(header.version));
+	}
+	if (header.classCount > header.instanceCount) {
+		throw std::runtime_error("Place has more classes than instances");
+	}
+
+	PlaceDocument document;
+	document.streamingRegionSize = header.streamingRegionSize;
+
+	ReadState state;
+	state.classCount = header.classCount;
+	state.classes.resize(header.classCount);
+	state.byReferent.resize(header.instanceCount);
+	std::vector<uint8_t> payload;
+
+	while (true) {
+		ChunkHeader chunk{};
+		file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk));
+		if (!file) throw std::runtime_error("Place is missing its END chunk");
+		if (!std::memcmp(chunk.type, chunkEnd, 4)) break;
+
+		if (!std::memcmp(chunk.type, chunkRegion, 4)) {
+			RegionHeader regionHeader{};
+			if (chunk.length < sizeof(regionHeader)) throw std::runtime_error("Place region chunk is truncated");
+			file.read(reinterpret_cast<char*>(&regionHeader), sizeof(regionHeader));
+
+			PlaceRegion region;
+			region.cell = glm::ivec3(regionHeader.x, regionHeader.y, regionHeader.z);
+			region.instanceCount = regionHeader.instanceCount;
+			region.offset = static_cast<uint64_t>(file.tellg());
+			region.size = chunk.length - static_cast<uint32_t>(sizeof(regionHeader));
+			document.regions.push_back(region);
+
+			file.seekg(region.size, std::ios::cur);
+			if (!file) throw std::runtime_error("Place region chunk is truncated");
+			continue;
+		}
+
+		payload.resize(chunk.length);
+		file.read(reinterpret_cast<char*>(payload.data()), chunk.length);
+		if (!file) throw std::runtime_error("Failed to read place chunk");
+		ByteReader reader(payload.data(), payload.size());
+		readChunk(chunk, reader, state);
+	}
+
+	if (!state.root) throw std::runtime_error("Place has no root instance");
+	document.root = state.root;
+	document.referents.assign(state.byReferent.begin(), state.byReferent.end());
+	return document;
+}
+
+InstancePtr PlaceDeserializer::deserialize(const std::string& filename) {
+	return open(filename).root;
+}
+
+PlaceDocument PlaceDeserializer::load(const std::string& filename, const InstancePtr& target) {
+	if (!target) throw std::runtime_error("PlaceDeserializer: target is null");
+	auto document = open(filename);
+	for (const auto& child : document.root->getChildren()) {
+		child->setParent(target);
+	}
+	/* the body root is replaced by target, so streamed children of the root land there */
+	if (!document.referents.empty()) document.referents[0] = target;
+	return document;
+}
+
+PlaceRegionContents PlaceDeserializer::deserializeRegion(const std::string& filename, const PlaceRegion& region) {
+	std::ifstream file{ filename, std::ios::binary };
+	if (!file.is_open()) {
+		throw std::runtime_error("Cannot open file: " + filename);
+	}
+
+	std::vector<uint8_t> payload(region.size);
+	file.seekg(static_cast<std::streamoff>(region.offset));
+	file.read(reinterpret_cast<char*>(payload.data()), region.size);
+	if (!file) throw std::runtime_error("Failed to read place region");
+
+	ReadState state;
+	/* every class in a region has at least one of its instances */
+	state.classCount = region.instanceCount;
+	state.byReferent.resize(region.instanceCount);
+	ByteReader reader(payload.data(), payload.size());
+
+	while (true) {
+		const auto chunk = reader.read<ChunkHeader>();
+		if (!std::memcmp(chunk.type, chunkEnd, 4)) break;
+		ByteReader chunkReader(reader.take(chunk.length), chunk.length);
+		readChunk(chunk, chunkReader, state);
+	}
+
+	PlaceRegionContents contents;
+	contents.roots = std::move(state.external);
+	contents.instanceCount = region.instanceCount;
+	return contents;
+}
@@ -0,0 +1,236 @@
+#include <PlaceSerializer/PlaceSerializer.h>
+#include <PlaceSerializer/PlaceFormat.h>
+#include <Instance/Instance.h>
+#include <Instance/BasePart.h>
+#include <Instance/Script.h>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+using namespace PlaceFormat;
+
+namespace {
+	struct ClassGroup {
+		std::string className;
+		std::vector<InstancePtr> instances;
+		std::vector<int32_t> referents;
+	};
+}
+
+template<typename T>
+static T* appendColumn(ByteWriter& writer, size_t count) {
+	const auto offset = writer.buffer.size();
+	writer.buffer.resize(offset + count * sizeof(T));
+	return reinterpret_cast<T*>(writer.buffer.data() + offset);
+}
+
+static void writeColumn(ByteWriter& writer, const std::vector<BasePart*>& parts, bool BasePart::* member) {
+	auto* out = appendColumn<uint8_t>(writer, parts.size());
+	for (size_t i = 0; i < parts.size(); ++i) out[i] = parts[i]->*member ? 1 : 0;
+}
+
+static void writeColumn(ByteWriter& writer, const std::vector<BasePart*>& parts, float BasePart::* member) {
+	/* columns follow variable-length strings, so they aren't aligned for float stores */
+	auto* out = appendColumn<uint8_t>(writer, parts.size() * sizeof(float));
+	for (size_t i = 0; i < parts.size(); ++i) std::memcpy(out + i * sizeof(float), &(parts[i]->*member), sizeof(float));
+}
+
+static void writeColumn(ByteWriter& writer, const std::vector<BasePart*>& parts, glm::vec3 BasePart::* member) {
+	for (int c = 0; c < 3; ++c) {
+		auto* out = appendColumn<uint8_t>(writer, parts.size() * sizeof(float));
+		for (size_t i = 0; i < parts.size(); ++i) std::memcpy(out + i * sizeof(float), &(parts[i]->*member)[c], sizeof(float));
+	}
+}
+
+static void writeColumn(ByteWriter& writer, const std::vector<BasePart*>& parts, glm::u8vec3 BasePart::* member) {
+	for (int c = 0; c < 3; ++c) {
+		auto* out = appendColumn<uint8_t>(writer, parts.size());
+		for (size_t i = 0; i < parts.size(); ++i) out[i] = (parts[i]->*member)[c];
+	}
+}
+
+static void writeChunk(std::ofstream& file, const char (&type)[4], const ByteWriter& payload) {
+	ChunkHeader header{};
+	std::memcpy(header.type, type, sizeof(header.type));
+	header.length = static_cast<uint32_t>(payload.buffer.size());
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(payload.buffer.data()), payload.buffer.size());
+	if (!file) throw std::runtime_error("Failed to write place chunk");
+}
+
+static void writeChunk(ByteWriter& out, const char (&type)[4], const ByteWriter& payload) {
+	ChunkHeader header{};
+	std::memcpy(header.type, type, sizeof(header.type));
+	header.length = static_cast<uint32_t>(payload.buffer.size());
+	out.write(header);
+	out.writeBytes(payload.buffer.data(), payload.buffer.size());
+}
+
+/* writes INST/PROP/PRNT/END for `ordered`, where ordered[i] has referent i */
+template<typename Sink>
+static uint32_t writeInstanceChunks(Sink& sink, const std::vector<InstancePtr>& ordered, const std::function<int32_t(const Instance&)>& parentReferent) {
+	std::vector<ClassGroup> groups;
+	std::unordered_map<std::string, uint32_t> classIds;
+
+	for (size_t i = 0; i < ordered.size(); ++i) {
+		const auto& inst = ordered[i];
+		const auto className = inst->getClassName();
+		auto [it, inserted] = classIds.try_emplace(className, static_cast<uint32_t>(groups.size()));
+		if (inserted) groups.push_back({ className, {}, {} });
+		groups[it->second].instances.push_back(inst);
+		groups[it->second].referents.push_back(static_cast<int32_t>(i));
+	}
+
+	for (uint32_t classId = 0; classId < groups.size(); ++classId) {
+		const auto& group = groups[classId];
+		const auto count = static_cast<uint32_t>(group.instances.size());
+
+		{
+			ByteWriter writer;
+			writer.write(classId);
+			writer.writeString(group.className);
+			writer.write(count);
+			writer.writeBytes(group.referents.data(), group.referents.size() * sizeof(int32_t));
+			writeChunk(sink, chunkInstances, writer);
+		}
+
+		{
+			ByteWriter writer;
+			writer.write(classId);
+			writer.writeString("Name");
+			writer.write(PropertyType::String);
+			for (const auto& inst : group.instances) writer.writeString(inst->name);
+			writeChunk(sink, chunkProperty, writer);
+		}
+
+		if (dynamic_cast<Script*>(group.instances.front().get())) {
+			ByteWriter writer;
+			writer.write(classId);
+			writer.writeString("Source");
+			writer.write(PropertyType::String);
+			for (const auto& inst : group.instances) writer.writeString(static_cast<Script*>(inst.get())->source);
+			writeChunk(sink, chunkProperty, writer);
+		}
+
+		if (!dynamic_cast<BasePart*>(group.instances.front().get())) continue;
+
+		std::vector<BasePart*> parts;
+		parts.reserve(count);
+		for (const auto& inst : group.instances) parts.push_back(static_cast<BasePart*>(inst.get()));
+
+		for (const auto& property : basePartProperties) {
+			ByteWriter writer;
+			writer.write(classId);
+			writer.writeString(property.name);
+			std::visit([&](auto member) {
+				using T = std::remove_cvref_t<decltype(parts.front()->*member)>;
+				writer.write(propertyTypeOf<T>());
+				writeColumn(writer, parts, member);
+			}, property.member);
+			writeChunk(sink, chunkProperty, writer);
+		}
+	}
+
+	{
+		ByteWriter writer;
+		const auto count = static_cast<uint32_t>(ordered.size());
+		writer.write(count);
+		auto* children = appendColumn<int32_t>(writer, count);
+		for (uint32_t i = 0; i < count; ++i) children[i] = static_cast<int32_t>(i);
+		auto* parents = appendColumn<int32_t>(writer, count);
+		for (uint32_t i = 0; i < count; ++i) parents[i] = parentReferent(*ordered[i]);
+		writeChunk(sink, chunkParents, writer);
+	}
+
+	writeChunk(sink, chunkEnd, ByteWriter{});
+	return static_cast<uint32_t>(groups.size());
+}
+
+/* splits the tree into the place body and per-cell streaming units (top-level BaseParts under Workspace) */
+static void collectInstances(const InstancePtr& inst, const Instance* workspace, bool insideWorkspace, float regionSize,
+	std::vector<InstancePtr>& base, std::map<std::tuple<int32_t, int32_t, int32_t>, std::vector<InstancePtr>>& regions) {
+	for (const auto& child : inst->getChildren()) {
+		if (regionSize > 0.0f && insideWorkspace) {
+			if (auto part = dynamic_cast<BasePart*>(child.get())) {
+				const auto cell = glm::ivec3(glm::floor(part->position / regionSize));
+				auto& region = regions[{ cell.x, cell.y, cell.z }];
+				region.push_back(child);
+				auto descendants = child->getDescendants();
+				region.insert(region.end(), descendants.begin(), descendants.end());
+				continue;
+			}
+		}
+		base.push_back(child);
+		collectInstances(child, workspace, insideWorkspace || child.get() == workspace, regionSize, base, regions);
+	}
+}
+
+void PlaceSerializer::serialize(const InstancePtr& root, const std::string& filename, float streamingRegionSize) {
+	if (!root) throw std::runtime_error("PlaceSerializer: root is null");
+
+	const auto workspace = root->findFirstChild("Workspace");
+	std::vector<InstancePtr> ordered;
+	std::map<std::tuple<int32_t, int32_t, int32_t>, std::vector<InstancePtr>> regions;
+	ordered.push_back(root);
+	collectInstances(root, workspace.get(), false, streamingRegionSize, ordered, regions);
+
+	std::unordered_map<const Instance*, int32_t> referents;
+	referents.reserve(ordered.size());
+	for (size_t i = 0; i < ordered.size(); ++i) {
+		referents[ordered[i].get()] = static_cast<int32_t>(i);
+	}
+	auto baseReferentOf = [&referents](const Instance& inst) -> int32_t {
+		auto par = inst.parent.lock();
+		if (!par) return -1;
+		auto it = referents.find(par.get());
+		return it != referents.end() ? it->second : -1;
+	};
+
+	std::ofstream file{ filename, std::ios::binary | std::ios::trunc };
+	if (!file.is_open()) {
+		throw std::runtime_error("Cannot open file: " + filename);
+	}
+
+	Header header{};
+	std::memcpy(header.magic, magic, sizeof(header.magic));
+	header.version = version;
+	header.instanceCount = static_cast<uint32_t>(ordered.size());
+	header.streamingRegionSize = streamingRegionSize;
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	for (const auto& [cell, instances] : regions) {
+		std::unordered_map<const Instance*, int32_t> localReferents;
+		localReferents.reserve(instances.size());
+		for (size_t i = 0; i < instances.size(); ++i) {
+			localReferents[instances[i].get()] = static_cast<int32_t>(i);
+		}
+
+		ByteWriter writer;
+		RegionHeader regionHeader{ std::get<0>(cell), std::get<1>(cell), std::get<2>(cell), static_cast<uint32_t>(instances.size()) };
+		writer.write(regionHeader);
+		writeInstanceChunks(writer, instances, [&](const Instance& inst) -> int32_t {
+			auto par = inst.parent.lock();
+			if (!par) return -1;
+			auto local = localReferents.find(par.get());
+			if (local != localReferents.end()) return local->second;
+			auto it = referents.find(par.get());
+			return it != referents.end() ? encodeBaseReferent(it->second) : -1;
+		});
+		writeChunk(file, chunkRegion, writer);
+	}
+
+	header.classCount = writeInstanceChunks(file, ordered, [&](const Instance& inst) -> int32_t {
+		return &inst == root.get() ? -1 : baseReferentOf(inst);
+	});
+
+	file.seekp(0);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	if (!file) throw std::runtime_error("Failed to write place header");
+}
@@ -0,0 +1,56 @@
+#include <Profiling/GpuProfiler.h>
+#include <Profiling/Profiler.h>
+
+GpuProfiler::GpuProfiler() {
+	for (auto& frame : m_frames) {
+		glGenQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+	}
+}
+
+GpuProfiler::~GpuProfiler() {
+	for (auto& frame : m_frames) {
+		glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+	}
+}
+
+void GpuProfiler::beginFrame() {
+	if (m_passActive) endPass();
+	m_current = (m_current + 1) % m_frames.size();
+
+	auto& frame = m_frames[m_current];
+	collect(frame);
+	frame.frameIndex = Profiler::getInstance().getFrameIndex();
+	frame.passCount = 0;
+}
+
+void GpuProfiler::collect(FrameQueries& frame) {
+	if (frame.passCount == 0) return;
+
+	/* frameLatency frames later the results are normally in, a frame that isn't is dropped rather than waited on */
+	GLint available = GL_FALSE;
+	glGetQueryObjectiv(frame.queries[frame.passCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) return;
+
+	auto& profiler = Profiler::getInstance();
+	for (size_t i = 0; i < frame.passCount; ++i) {
+		GLuint64 nanoseconds = 0;
+		glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &nanoseconds);
+		profiler.addGpuZone(frame.frameIndex, frame.names[i], nanoseconds);
+	}
+}
+
+bool GpuProfiler::beginPass(const char* name) {
+	auto& frame = m_frames[m_current];
+	if (m_passActive || frame.passCount == frame.queries.size() || !Profiler::getInstance().isEnabled()) return false;
+	frame.names[frame.passCount] = name;
+	glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.passCount]);
+	m_passActive = true;
+	return true;
+}
+
+void GpuProfiler::endPass() {
+	if (!m_passActive) return;
+	glEndQuery(GL_TIME_ELAPSED);
+	++m_frames[m_current].passCount;
+	m_passActive = false;
+}
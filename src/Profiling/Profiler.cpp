@@ -0,0 +1,157 @@
+#include <Profiling/Profiler.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace {
+	const auto epoch = std::chrono::steady_clock::now();
+
+	thread_local uint32_t zoneDepth = 0;
+}
+
+Profiler& Profiler::getInstance() {
+	/* never destroyed, pool workers may still record while other statics are torn down */
+	static Profiler* instance = new Profiler();
+	return *instance;
+}
+
+uint64_t Profiler::now() {
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer() {
+	thread_local ThreadBuffer* buffer = nullptr;
+	if (buffer) return *buffer;
+
+	/* buffers live as long as the profiler, a pool worker exiting doesn't free its track */
+	std::lock_guard<std::mutex> lk(m_threadsMutex);
+	auto created = std::make_unique<ThreadBuffer>();
+	created->index = static_cast<uint32_t>(m_threads.size());
+	created->name = "Thread " + std::to_string(created->index);
+	created->zones = std::make_unique<Zone[]>(threadCapacity);
+	buffer = created.get();
+	m_threads.push_back(std::move(created));
+	return *buffer;
+}
+
+void Profiler::setThreadName(std::string name) {
+	auto& buffer = getThreadBuffer();
+	std::lock_guard<std::mutex> lk(m_threadsMutex);
+	buffer.name = std::move(name);
+}
+
+void Profiler::record(const char* name, uint64_t startNanoseconds, uint64_t endNanoseconds, uint32_t depth) {
+	auto& buffer = getThreadBuffer();
+	const uint64_t write = buffer.writeIndex.load(std::memory_order_relaxed);
+	if (write - buffer.readIndex.load(std::memory_order_acquire) >= threadCapacity) {
+		buffer.droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	buffer.zones[write % threadCapacity] = { name, startNanoseconds, endNanoseconds, buffer.index, depth };
+	buffer.writeIndex.store(write + 1, std::memory_order_release);
+}
+
+void Profiler::beginFrame() {
+	m_frameStart = now();
+}
+
+void Profiler::endFrame() {
+	Frame frame;
+	frame.index = m_frameIndex++;
+	frame.startNanoseconds = m_frameStart;
+	frame.endNanoseconds = now();
+
+	{
+		/* only guards the thread list, recording threads never take it once registered */
+		std::lock_guard<std::mutex> lk(m_threadsMutex);
+		for (const auto& buffer : m_threads) {
+			const uint64_t read = buffer->readIndex.load(std::memory_order_relaxed);
+			const uint64_t write = buffer->writeIndex.load(std::memory_order_acquire);
+			if (!m_paused) {
+				for (uint64_t i = read; i < write; ++i) frame.zones.push_back(buffer->zones[i % threadCapacity]);
+			}
+			buffer->readIndex.store(write, std::memory_order_release);
+		}
+	}
+	if (m_paused) return;
+
+	std::sort(frame.zones.begin(), frame.zones.end(), [](const Zone& a, const Zone& b) {
+		if (a.threadIndex != b.threadIndex) return a.threadIndex < b.threadIndex;
+		return a.startNanoseconds < b.startNanoseconds;
+	});
+	m_frames.push_back(std::move(frame));
+	while (m_frames.size() > historySize) m_frames.pop_front();
+}
+
+void Profiler::addGpuZone(uint64_t frameIndex, const char* name, uint64_t nanoseconds) {
+	/* frames are in index order but skip the ones ended while paused, whose timings are dropped */
+	auto it = std::lower_bound(m_frames.begin(), m_frames.end(), frameIndex, [](const Frame& frame, uint64_t index) { return frame.index < index; });
+	if (it == m_frames.end() || it->index != frameIndex) return;
+	it->gpuZones.push_back({ name, nanoseconds });
+}
+
+std::vector<std::string> Profiler::getThreadNames() const {
+	std::lock_guard<std::mutex> lk(m_threadsMutex);
+	std::vector<std::string> names;
+	names.reserve(m_threads.size());
+	for (const auto& buffer : m_threads) names.push_back(buffer->name);
+	return names;
+}
+
+uint64_t Profiler::getDroppedZoneCount() const {
+	std::lock_guard<std::mutex> lk(m_threadsMutex);
+	uint64_t dropped = 0;
+	for (const auto& buffer : m_threads) dropped += buffer->droppedCount.load(std::memory_order_relaxed);
+	return dropped;
+}
+
+bool Profiler::exportChromeTrace(const std::string& filename) const {
+	/* complete ("X") events in microseconds; the GPU gets its own track, its passes laid end to end from the frame start */
+	const auto microseconds = [](uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; };
+	const auto threadNames = getThreadNames();
+	const uint32_t gpuTrack = static_cast<uint32_t>(threadNames.size());
+
+	nlohmann::json events = nlohmann::json::array();
+	for (uint32_t i = 0; i < threadNames.size(); ++i) {
+		events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", i }, { "args", { { "name", threadNames[i] } } } });
+	}
+	events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", gpuTrack }, { "args", { { "name", "GPU" } } } });
+
+	for (const auto& frame : m_frames) {
+		for (const auto& zone : frame.zones) {
+			events.push_back({
+				{ "name", zone.name }, { "ph", "X" }, { "pid", 0 }, { "tid", zone.threadIndex },
+				{ "ts", microseconds(zone.startNanoseconds) }, { "dur", microseconds(zone.endNanoseconds - zone.startNanoseconds) },
+			});
+		}
+		uint64_t gpuStart = frame.startNanoseconds;
+		for (const auto& zone : frame.gpuZones) {
+			events.push_back({
+				{ "name", zone.name }, { "ph", "X" }, { "pid", 0 }, { "tid", gpuTrack },
+				{ "ts", microseconds(gpuStart) }, { "dur", microseconds(zone.nanoseconds) },
+			});
+			gpuStart += zone.nanoseconds;
+		}
+	}
+
+	std::ofstream file{ filename, std::ios::trunc };
+	if (!file.is_open()) return false;
+	file << nlohmann::json{ { "traceEvents", events }, { "displayTimeUnit", "ms" } }.dump();
+	return file.good();
+}
+
+ProfileZone::ProfileZone(const char* name) : m_name(name) {
+	if (!Profiler::getInstance().isEnabled()) return;
+	m_active = true;
+	m_depth = zoneDepth++;
+	m_start = Profiler::now();
+}
+
+ProfileZone::~ProfileZone() {
+	if (!m_active) return;
+	--zoneDepth;
+	Profiler::getInstance().record(m_name, m_start, Profiler::now(), m_depth);
+}
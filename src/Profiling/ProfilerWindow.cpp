@@ -0,0 +1,176 @@
+#include <Profiling/ProfilerWindow.h>
+#include <Util/Hash.h>
+#include <imgui.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#define TRACE_FILENAME "./profile_trace.json"
+
+namespace {
+	constexpr float rowHeight = 18.0f;
+	constexpr float labelWidth = 80.0f;
+
+	float toMilliseconds(uint64_t nanoseconds) {
+		return static_cast<float>(nanoseconds) / 1'000'000.0f;
+	}
+
+	/* a stable colour per zone name, so a zone keeps its colour from frame to frame */
+	ImU32 getZoneColor(const char* name) {
+		const float hue = static_cast<float>(Hash::fnv1a(std::string_view(name)) % 360) / 360.0f;
+		return ImColor::HSV(hue, 0.45f, 0.75f);
+	}
+
+	const Profiler::Frame* findFrame(const std::deque<Profiler::Frame>& frames, uint64_t index) {
+		if (frames.empty() || index < frames.front().index || index > frames.back().index) return nullptr;
+		return &frames[index - frames.front().index];
+	}
+
+	/* one bar of the timeline, with its name when it fits and a tooltip on hover */
+	void drawBar(ImDrawList* drawList, ImVec2 min, ImVec2 max, const char* name, uint64_t nanoseconds) {
+		if (max.x - min.x < 1.0f) max.x = min.x + 1.0f;
+		drawList->AddRectFilled(min, max, getZoneColor(name));
+		drawList->AddRect(min, max, IM_COL32(0, 0, 0, 96));
+
+		char label[96];
+		std::snprintf(label, sizeof(label), "%s %.2f", name, toMilliseconds(nanoseconds));
+		if (ImGui::CalcTextSize(label).x + 4.0f < max.x - min.x) {
+			drawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32(0, 0, 0, 255), label);
+		}
+		if (ImGui::IsMouseHoveringRect(min, max)) ImGui::SetTooltip("%s: %.3f ms", name, toMilliseconds(nanoseconds));
+	}
+}
+
+ProfilerWindow::ProfilerWindow(Profiler& profiler) : m_profiler(profiler) {}
+
+void ProfilerWindow::draw() {
+	ImGui::Begin("Profiler");
+
+	bool paused = m_profiler.isPaused();
+	if (ImGui::Checkbox("Pause", &paused)) m_profiler.setPaused(paused);
+	ImGui::SameLine();
+	if (ImGui::Button("Export Chrome Trace")) {
+		m_exportStatus = m_profiler.exportChromeTrace(TRACE_FILENAME) ? "Wrote " TRACE_FILENAME : "Cannot write " TRACE_FILENAME;
+	}
+	if (!m_exportStatus.empty()) {
+		ImGui::SameLine();
+		ImGui::TextUnformatted(m_exportStatus.c_str());
+	}
+	if (const uint64_t dropped = m_profiler.getDroppedZoneCount()) ImGui::Text("Dropped zones: %llu", static_cast<unsigned long long>(dropped));
+
+	const auto& frames = m_profiler.getFrames();
+	if (frames.empty()) {
+		ImGui::TextUnformatted("No frames recorded");
+		ImGui::End();
+		return;
+	}
+	if (!paused || !findFrame(frames, m_selectedFrame)) m_selectedFrame = frames.back().index;
+
+	/* clicking a bar of the frame graph pauses on that frame */
+	std::vector<float> frameMilliseconds;
+	frameMilliseconds.reserve(frames.size());
+	for (const auto& frame : frames) frameMilliseconds.push_back(toMilliseconds(frame.endNanoseconds - frame.startNanoseconds));
+	const float slowest = *std::max_element(frameMilliseconds.begin(), frameMilliseconds.end());
+	ImGui::PlotHistogram("##frames", frameMilliseconds.data(), static_cast<int>(frameMilliseconds.size()), 0, nullptr, 0.0f, std::max(slowest, 16.7f), ImVec2(-1.0f, 60.0f));
+	if (ImGui::IsItemClicked()) {
+		const float fraction = (ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x) / ImGui::GetItemRectSize().x;
+		const auto offset = static_cast<size_t>(std::clamp(fraction, 0.0f, 0.999f) * static_cast<float>(frames.size()));
+		m_selectedFrame = frames[offset].index;
+		m_profiler.setPaused(true);
+	}
+
+	const auto& frame = *findFrame(frames, m_selectedFrame);
+	uint64_t gpuNanoseconds = 0;
+	for (const auto& zone : frame.gpuZones) gpuNanoseconds += zone.nanoseconds;
+	ImGui::Text("Frame %llu: %.2f ms CPU, %.2f ms GPU", static_cast<unsigned long long>(frame.index), toMilliseconds(frame.endNanoseconds - frame.startNanoseconds), toMilliseconds(gpuNanoseconds));
+
+	drawTimeline(frame);
+	drawHeaviestZones(frame);
+	ImGui::End();
+}
+
+void ProfilerWindow::drawTimeline(const Profiler::Frame& frame) {
+	const auto threadNames = m_profiler.getThreadNames();
+
+	/* rows per thread track: one per nesting depth, threads without zones this frame are left out */
+	std::vector<uint32_t> trackDepths(threadNames.size(), 0);
+	std::vector<bool> trackUsed(threadNames.size(), false);
+	for (const auto& zone : frame.zones) {
+		if (zone.threadIndex >= threadNames.size()) continue;
+		trackUsed[zone.threadIndex] = true;
+		trackDepths[zone.threadIndex] = std::max(trackDepths[zone.threadIndex], zone.depth + 1);
+	}
+	float height = frame.gpuZones.empty() ? 0.0f : rowHeight;
+	for (size_t i = 0; i < threadNames.size(); ++i) {
+		if (trackUsed[i]) height += trackDepths[i] * rowHeight;
+	}
+	if (height == 0.0f) return;
+
+	const ImVec2 origin = ImGui::GetCursorScreenPos();
+	const float width = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 1.0f);
+	ImGui::InvisibleButton("##timeline", ImVec2(labelWidth + width, height));
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+	const double frameNanoseconds = static_cast<double>(std::max<uint64_t>(frame.endNanoseconds - frame.startNanoseconds, 1));
+	auto toX = [&](uint64_t nanoseconds) {
+		const double offset = static_cast<double>(nanoseconds) - static_cast<double>(frame.startNanoseconds);
+		return origin.x + labelWidth + static_cast<float>(std::clamp(offset / frameNanoseconds, 0.0, 1.0)) * width;
+	};
+
+	float y = origin.y;
+	std::vector<float> trackTop(threadNames.size(), 0.0f);
+	for (size_t i = 0; i < threadNames.size(); ++i) {
+		if (!trackUsed[i]) continue;
+		trackTop[i] = y;
+		drawList->AddText(ImVec2(origin.x, y + 1.0f), ImGui::GetColorU32(ImGuiCol_Text), threadNames[i].c_str());
+		y += trackDepths[i] * rowHeight;
+		drawList->AddLine(ImVec2(origin.x, y), ImVec2(origin.x + labelWidth + width, y), ImGui::GetColorU32(ImGuiCol_Separator));
+	}
+	for (const auto& zone : frame.zones) {
+		if (zone.threadIndex >= threadNames.size()) continue;
+		const float top = trackTop[zone.threadIndex] + zone.depth * rowHeight;
+		drawBar(drawList, ImVec2(toX(zone.startNanoseconds), top), ImVec2(toX(zone.endNanoseconds), top + rowHeight - 1.0f), zone.name, zone.endNanoseconds - zone.startNanoseconds);
+	}
+
+	/* GPU passes only have durations, they're laid end to end from the frame start */
+	if (!frame.gpuZones.empty()) {
+		drawList->AddText(ImVec2(origin.x, y + 1.0f), ImGui::GetColorU32(ImGuiCol_Text), "GPU");
+		uint64_t start = frame.startNanoseconds;
+		for (const auto& zone : frame.gpuZones) {
+			drawBar(drawList, ImVec2(toX(start), y), ImVec2(toX(start + zone.nanoseconds), y + rowHeight - 1.0f), zone.name, zone.nanoseconds);
+			start += zone.nanoseconds;
+		}
+	}
+}
+
+void ProfilerWindow::drawHeaviestZones(const Profiler::Frame& frame) {
+	/* inclusive time summed per name across threads, nested zones count towards their parents too */
+	std::unordered_map<std::string_view, std::pair<uint64_t, uint32_t>> totals;
+	for (const auto& zone : frame.zones) {
+		auto& [nanoseconds, count] = totals[zone.name];
+		nanoseconds += zone.endNanoseconds - zone.startNanoseconds;
+		++count;
+	}
+	std::vector<std::pair<std::string_view, std::pair<uint64_t, uint32_t>>> sorted(totals.begin(), totals.end());
+	std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.first > b.second.first; });
+	if (sorted.size() > 12) sorted.resize(12);
+
+	if (!ImGui::BeginTable("##heaviest", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) return;
+	ImGui::TableSetupColumn("Zone");
+	ImGui::TableSetupColumn("ms");
+	ImGui::TableSetupColumn("calls");
+	ImGui::TableHeadersRow();
+	for (const auto& [name, total] : sorted) {
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(name.data(), name.data() + name.size());
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", toMilliseconds(total.first));
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", total.second);
+	}
+	ImGui::EndTable();
+}
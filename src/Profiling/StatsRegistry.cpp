@@ -0,0 +1,148 @@
+#include <Profiling/StatsRegistry.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <utility>
+
+void StatsRegistry::Gauge::set(int64_t value) {
+	m_value.store(value, std::memory_order_relaxed);
+	raisePeak(value);
+}
+
+void StatsRegistry::Gauge::add(int64_t amount) {
+	raisePeak(m_value.fetch_add(amount, std::memory_order_relaxed) + amount);
+}
+
+void StatsRegistry::Gauge::raisePeak(int64_t value) {
+	int64_t peak = m_peak.load(std::memory_order_relaxed);
+	while (value > peak && !m_peak.compare_exchange_weak(peak, value, std::memory_order_relaxed)) {}
+}
+
+StatsRegistry::Histogram::Histogram(std::vector<double> upperBounds) : m_upperBounds(std::move(upperBounds)) {
+	std::sort(m_upperBounds.begin(), m_upperBounds.end());
+	m_buckets = std::make_unique<std::atomic<uint64_t>[]>(m_upperBounds.size() + 1);
+}
+
+void StatsRegistry::Histogram::record(double value) {
+	const size_t bucket = std::lower_bound(m_upperBounds.begin(), m_upperBounds.end(), value) - m_upperBounds.begin();
+	m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_sum.fetch_add(value, std::memory_order_relaxed);
+
+	double max = m_max.load(std::memory_order_relaxed);
+	while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+}
+
+double StatsRegistry::Histogram::getMean() const {
+	const uint64_t count = getCount();
+	return count ? m_sum.load(std::memory_order_relaxed) / static_cast<double>(count) : 0.0;
+}
+
+double StatsRegistry::Histogram::getPercentile(double fraction) const {
+	const uint64_t count = getCount();
+	if (count == 0) return 0.0;
+
+	const auto wanted = static_cast<uint64_t>(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(count - 1)) + 1;
+	uint64_t seen = 0;
+	for (size_t i = 0; i < m_upperBounds.size(); ++i) {
+		seen += m_buckets[i].load(std::memory_order_relaxed);
+		if (seen >= wanted) return std::min(m_upperBounds[i], getMax());
+	}
+	return getMax();
+}
+
+StatsRegistry& StatsRegistry::getInstance() {
+	/* never destroyed, stats are still touched by other singletons' destructors at exit */
+	static StatsRegistry* instance = new StatsRegistry();
+	return *instance;
+}
+
+std::vector<double> StatsRegistry::exponentialBounds(double first, double factor, size_t count) {
+	std::vector<double> bounds;
+	bounds.reserve(count);
+	for (double bound = first; bounds.size() < count; bound *= factor) bounds.push_back(bound);
+	return bounds;
+}
+
+StatsRegistry::Counter& StatsRegistry::counter(const std::string& name) {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	auto& stat = m_counters[name];
+	if (!stat) stat = std::make_unique<Counter>();
+	return *stat;
+}
+
+StatsRegistry::Gauge& StatsRegistry::gauge(const std::string& name) {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	auto& stat = m_gauges[name];
+	if (!stat) stat = std::make_unique<Gauge>();
+	return *stat;
+}
+
+StatsRegistry::Histogram& StatsRegistry::histogram(const std::string& name, std::vector<double> upperBounds) {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	auto& stat = m_histograms[name];
+	if (!stat) stat = std::make_unique<Histogram>(std::move(upperBounds));
+	return *stat;
+}
+
+void StatsRegistry::endFrame() {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	for (auto& [name, counter] : m_counters) {
+		const int64_t frame = counter->m_current.exchange(0, std::memory_order_relaxed);
+		counter->m_lastFrame.store(frame, std::memory_order_relaxed);
+		counter->m_total.fetch_add(frame, std::memory_order_relaxed);
+	}
+	m_frameCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+StatsRegistry::Snapshot StatsRegistry::snapshot() const {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	Snapshot snapshot;
+	snapshot.frameCount = m_frameCount.load(std::memory_order_relaxed);
+	for (const auto& [name, counter] : m_counters) {
+		snapshot.counters.push_back({ name, counter->getLastFrame(), counter->getTotal() });
+	}
+	for (const auto& [name, gauge] : m_gauges) {
+		snapshot.gauges.push_back({ name, gauge->get(), gauge->getPeak() });
+	}
+	for (const auto& [name, histogram] : m_histograms) {
+		snapshot.histograms.push_back({
+			name, histogram->getCount(), histogram->getMean(),
+			histogram->getPercentile(0.5), histogram->getPercentile(0.95), histogram->getPercentile(0.99), histogram->getMax(),
+		});
+	}
+	return snapshot;
+}
+
+bool StatsRegistry::writeJson(const std::string& filename) const {
+	const Snapshot values = snapshot();
+
+	nlohmann::ordered_json counters = nlohmann::ordered_json::object();
+	for (const auto& counter : values.counters) {
+		counters[counter.name] = { { "lastFrame", counter.lastFrame }, { "total", counter.total } };
+	}
+	nlohmann::ordered_json gauges = nlohmann::ordered_json::object();
+	for (const auto& gauge : values.gauges) {
+		gauges[gauge.name] = { { "value", gauge.value }, { "peak", gauge.peak } };
+	}
+	nlohmann::ordered_json histograms = nlohmann::ordered_json::object();
+	for (const auto& histogram : values.histograms) {
+		histograms[histogram.name] = {
+			{ "count", histogram.count }, { "mean", histogram.mean },
+			{ "p50", histogram.p50 }, { "p95", histogram.p95 }, { "p99", histogram.p99 }, { "max", histogram.max },
+		};
+	}
+
+	const nlohmann::ordered_json document = {
+		{ "frameCount", values.frameCount },
+		{ "counters", counters },
+		{ "gauges", gauges },
+		{ "histograms", histograms },
+	};
+
+	std::ofstream file{ filename, std::ios::trunc };
+	if (!file.is_open()) return false;
+	file << document.dump(2) << '\n';
+	return file.good();
+}
@@ -0,0 +1,116 @@
+#include <Render/IndirectBatch.h>
+#include <Profiling/StatsRegistry.h>
+#include <Render/MeshRenderer.h>
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+IndirectBatch::IndirectBatch() = default;
+
+IndirectBatch::~IndirectBatch() {
+	if (m_commandBuffer) glDeleteBuffers(1, &m_commandBuffer);
+	if (m_instanceBuffer) glDeleteBuffers(1, &m_instanceBuffer);
+
+	m_commandBuffer = 0;
+	m_instanceBuffer = 0;
+}
+
+void IndirectBatch::add(const Mesh3D& mesh, size_t lod, const glm::mat4& model, const Textures& textures) {
+	auto textureSet = std::find(m_textureSets.begin(), m_textureSets.end(), textures);
+	if (textureSet == m_textureSets.end()) textureSet = m_textureSets.insert(m_textureSets.end(), textures);
+	m_items.push_back({ &mesh, static_cast<uint32_t>(lod), static_cast<uint32_t>(textureSet - m_textureSets.begin()), model });
+}
+
+void IndirectBatch::clear() {
+	m_items.clear();
+	m_textureSets.clear();
+}
+
+void IndirectBatch::draw(const std::function<void(const Textures&)>& bindTextures) {
+	static auto& drawCalls = StatsRegistry::getInstance().counter("Render/DrawCalls");
+	static auto& triangles = StatsRegistry::getInstance().counter("Render/Triangles");
+	static auto& vertexArrayBinds = StatsRegistry::getInstance().counter("Render/VertexArrayBinds");
+	static auto& indirectCommands = StatsRegistry::getInstance().counter("Render/IndirectCommands");
+	if (m_items.empty()) return;
+
+	/* grouped by what needs a separate call, then by mesh and level so repeats become instances */
+	std::vector<uint32_t> order(m_items.size());
+	std::iota(order.begin(), order.end(), 0u);
+	auto key = [this](uint32_t i) {
+		const auto& item = m_items[i];
+		return std::make_tuple(item.textureSet, &item.mesh->getArena(), item.mesh, item.lod);
+	};
+	std::stable_sort(order.begin(), order.end(), [&key](uint32_t a, uint32_t b) { return key(a) < key(b); });
+
+	m_commands.clear();
+	m_models.clear();
+	for (size_t i = 0; i < order.size(); ++i) {
+		const auto& item = m_items[order[i]];
+		if (i == 0 || key(order[i - 1]) != key(order[i])) {
+			const MeshLod level = item.mesh->getLod(item.lod);
+			Command command;
+			command.count = level.indexCount;
+			command.firstIndex = item.mesh->getFirstIndex() + level.firstIndex;
+			command.baseVertex = item.mesh->getBaseVertex();
+			command.baseInstance = static_cast<GLuint>(m_models.size());
+			m_commands.push_back(command);
+		}
+		++m_commands.back().instanceCount;
+		m_models.push_back(item.model);
+	}
+
+	upload(m_commandBuffer, m_commandCapacity, m_commands.data(), m_commands.size() * sizeof(Command));
+	upload(m_instanceBuffer, m_instanceCapacity, m_models.data(), m_models.size() * sizeof(glm::mat4));
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, instanceBinding, m_instanceBuffer);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+
+	/* one call per run of commands sharing a texture set and an arena */
+	size_t itemIndex = 0;
+	for (size_t c = 0; c < m_commands.size();) {
+		const auto& item = m_items[order[itemIndex]];
+		const uint32_t textureSet = item.textureSet;
+		const MeshArena& arena = item.mesh->getArena();
+
+		size_t end = c;
+		size_t endItem = itemIndex;
+		while (end < m_commands.size()) {
+			const auto& next = m_items[order[endItem]];
+			if (next.textureSet != textureSet || &next.mesh->getArena() != &arena) break;
+			endItem += m_commands[end].instanceCount;
+			++end;
+		}
+
+		const auto& textures = m_textureSets[textureSet];
+		if (bindTextures) {
+			bindTextures(textures);
+		}
+		else {
+			MeshRenderer::bindTextures(textures);
+		}
+		glBindVertexArray(arena.getVAO());
+		const uintptr_t offset = c * sizeof(Command);
+		glMultiDrawElementsIndirect(GL_TRIANGLES, arena.getIndexType(), reinterpret_cast<const void*>(offset), static_cast<GLsizei>(end - c), sizeof(Command));
+
+		drawCalls.add();
+		vertexArrayBinds.add();
+		indirectCommands.add(static_cast<int64_t>(end - c));
+		for (size_t i = c; i < end; ++i) triangles.add(static_cast<int64_t>(m_commands[i].count / 3) * m_commands[i].instanceCount);
+
+		c = end;
+		itemIndex = endItem;
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void IndirectBatch::upload(GLuint& buffer, size_t& capacity, const void* data, size_t bytes) {
+	/* immutable storage can't be resized, a larger buffer replaces it; GL keeps the old one until earlier draws are done */
+	if (bytes > capacity) {
+		if (buffer) glDeleteBuffers(1, &buffer);
+		capacity = std::max(bytes, capacity * 2);
+		glCreateBuffers(1, &buffer);
+		glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(capacity), nullptr, GL_DYNAMIC_STORAGE_BIT);
+	}
+	glNamedBufferSubData(buffer, 0, static_cast<GLsizeiptr>(bytes), data);
+}
@@ -1,24 +1,90 @@
 #include <Render/MeshRenderer.h>
 #include <Texture/ITexture.h>
 #include <Mesh/IMesh.h>
+#include <Mesh/VertexLayout.h>
 #include <Shader/Shader.h>
+#include <Profiling/StatsRegistry.h>
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
+#include <glm/glm.hpp>
 
 #include <iostream>
 
+namespace {
+	void countDraw(const IMesh& mesh, size_t lod = 0) {
+		static auto& drawCalls = StatsRegistry::getInstance().counter("Render/DrawCalls");
+		static auto& triangles = StatsRegistry::getInstance().counter("Render/Triangles");
+		static auto& vertexArrayBinds = StatsRegistry::getInstance().counter("Render/VertexArrayBinds");
+		drawCalls.add();
+		triangles.add(mesh.getLod(lod).indexCount / 3);
+		vertexArrayBinds.add();
+	}
+
+	void drawLod(const IMesh& mesh, size_t lod) {
+		const MeshLod level = mesh.getLod(lod);
+		const uintptr_t offset = static_cast<uintptr_t>(mesh.getFirstIndex() + level.firstIndex) * VertexLayout::getIndexSize(mesh.getIndexType());
+		glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(level.indexCount), mesh.getIndexType(), reinterpret_cast<void*>(offset), mesh.getBaseVertex());
+		mesh.onDrawn();
+	}
+}
+
 void MeshRenderer::draw(const IMesh& mesh) {
+	countDraw(mesh);
 	glBindVertexArray(mesh.getVAO());
-	glDrawElements(GL_TRIANGLES, mesh.getIndicesCount(), GL_UNSIGNED_INT, nullptr);
+	drawLod(mesh, 0);
 	glBindVertexArray(0);
 }
 
 
 void MeshRenderer::draw(const IMesh& mesh, const std::vector<std::shared_ptr<ITexture>>& textures) {
+	countDraw(mesh);
 	glBindVertexArray(mesh.getVAO());
-	for (int i = 0; i < textures.size(); i++) {
-		textures[i]->bind(i);
-	}
-	glDrawElements(GL_TRIANGLES, mesh.getIndicesCount(), GL_UNSIGNED_INT, nullptr);
+	bindTextures(textures);
+	drawLod(mesh, 0);
+	glBindVertexArray(0);
+}
+
+void MeshRenderer::draw(const IMesh& mesh, size_t lod) {
+	countDraw(mesh, lod);
+	glBindVertexArray(mesh.getVAO());
+	drawLod(mesh, lod);
+	glBindVertexArray(0);
+}
+
+void MeshRenderer::draw(const IMesh& mesh, const std::vector<std::shared_ptr<ITexture>>& textures, size_t lod) {
+	countDraw(mesh, lod);
+	glBindVertexArray(mesh.getVAO());
+	bindTextures(textures);
+	drawLod(mesh, lod);
 	glBindVertexArray(0);
+}
+
+void MeshRenderer::bindTextures(const std::vector<std::shared_ptr<ITexture>>& textures) {
+	static auto& textureBinds = StatsRegistry::getInstance().counter("Render/TextureBinds");
+	if (textures.empty()) return;
+
+	std::vector<GLuint> ids(textures.size());
+	for (size_t i = 0; i < textures.size(); i++) {
+		ids[i] = textures[i]->getId();
+	}
+	glBindTextures(0, static_cast<GLsizei>(ids.size()), ids.data());
+	textureBinds.add(static_cast<int64_t>(ids.size()));
+}
+
+size_t MeshRenderer::selectLod(const IMesh& mesh, const glm::mat4& model, const Camera3D& camera, float viewportHeight, float pixelError) {
+	const size_t lodCount = mesh.getLodCount();
+	if (lodCount <= 1) return 0;
+
+	/* errors are in mesh units, the largest axis scale is the worst case for them */
+	const glm::vec4 sphere = mesh.getBoundingSphere();
+	const float scale = std::max({ glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2])) });
+	const glm::vec3 center = glm::vec3(model * glm::vec4(glm::vec3(sphere), 1.0f));
+	const float distance = std::max(glm::length(center - camera.position) - sphere.w * scale, camera.nearPlaneZ);
+	const float pixelsPerUnit = viewportHeight / (2.0f * std::tan(glm::radians(camera.fieldOfView) * 0.5f) * distance);
+
+	size_t lod = 0;
+	while (lod + 1 < lodCount && mesh.getLod(lod + 1).error * scale * pixelsPerUnit <= pixelError) ++lod;
+	return lod;
 }
\ No newline at end of file
@@ -1,8 +1,17 @@
 #include <ResourceManager/Managers/MeshManager.h>
+#include <Asset/AssetArchive.h>
+#include <Profiling/StatsRegistry.h>
 #include <memory>
 #include <string>
+#include <utility>
 #include <Mesh/Mesh3D.h>
+#include <Mesh/MeshOptimizer.h>
+#include <Mesh/MeshSimplifier.h>
 #include <MeshDeserializer/GlbDeserializer.h>
+#include <MeshDeserializer/CookedMeshDeserializer.h>
+#include <Util/MappedFile.h>
+#include <filesystem>
+#include <stdexcept>
 #include <unordered_map>
 
 MeshManager& MeshManager::getInstance() {
@@ -11,18 +20,63 @@ MeshManager& MeshManager::getInstance() {
 }
 
 std::shared_ptr<Mesh3D> MeshManager::loadMeshFromFile(const std::string& filename) {
-	auto it = m_meshes.find(filename);
-	if (it != m_meshes.end()) {
-		return it->second;
+	static auto& loads = StatsRegistry::getInstance().counter("Resources/MeshLoads");
+	static auto& cacheHits = StatsRegistry::getInstance().counter("Resources/MeshCacheHits");
+	bool loaded = false;
+	std::shared_ptr<Mesh3D> mesh;
+	const auto& archive = AssetArchive::getInstance();
+	const std::string cookedFilename = getCookedFilename(filename);
+	/* a cooked mesh from an older build is skipped for its source rather than failing the load */
+	if (const auto entry = archive.find(cookedFilename); entry && CookedMeshDeserializer::isCurrent(entry->bytes)) {
+		mesh = m_cache.getOrLoad(ResourceCache<Mesh3D>::makeContentKey(entry->contentHash, "cooked"), [&entry, &loaded]() {
+			loaded = true;
+			return std::make_shared<Mesh3D>(CookedMeshDeserializer::view(entry->bytes));
+		});
 	}
+	else if (const auto entry = archive.find(filename)) {
+		mesh = m_cache.getOrLoad(ResourceCache<Mesh3D>::makeContentKey(entry->contentHash), [&entry, &loaded]() {
+			loaded = true;
+			auto data = GlbDeserializer::deserialize(entry->bytes);
+			MeshOptimizer::optimize(data);
+			MeshSimplifier::generateLods(data);
+			return std::make_shared<Mesh3D>(data);
+		});
+	}
+	else if (isCookedFileCurrent(filename, cookedFilename)) {
+		mesh = m_cache.getOrLoad(ResourceCache<Mesh3D>::makeKey(cookedFilename), [&cookedFilename, &loaded]() {
+			loaded = true;
+			MappedFile file;
+			if (!file.open(cookedFilename)) throw std::runtime_error("Cannot open file: " + cookedFilename);
+			return std::make_shared<Mesh3D>(CookedMeshDeserializer::view(file.getBytes()));
+		});
+	}
+	else {
+		mesh = m_cache.getOrLoad(ResourceCache<Mesh3D>::makeKey(filename), [&filename, &loaded]() {
+			loaded = true;
+			/* cooked meshes were optimized and simplified offline, uncooked ones pay for it here */
+			auto data = GlbDeserializer::deserialize(filename);
+			MeshOptimizer::optimize(data);
+			MeshSimplifier::generateLods(data);
+			return std::make_shared<Mesh3D>(data);
+		});
+	}
+	(loaded ? loads : cacheHits).add();
+	return mesh;
+}
 
-	const auto [vertices, indices] = GlbDeserializer::deserialize(filename);
-	auto mesh = std::make_shared<Mesh3D>(vertices, indices);
-	m_meshes[filename] = mesh;
+std::string MeshManager::getCookedFilename(const std::string& filename) {
+	return std::filesystem::path(filename).replace_extension(".emesh").string();
+}
 
-	return mesh;
+bool MeshManager::isCookedFileCurrent(const std::string& filename, const std::string& cookedFilename) {
+	std::error_code error;
+	const auto cookedTime = std::filesystem::last_write_time(cookedFilename, error);
+	if (error) return false;
+	/* a cooked file without its source is still usable, one older than its source or this build's format is stale */
+	const auto sourceTime = std::filesystem::last_write_time(filename, error);
+	return (error || cookedTime >= sourceTime) && CookedMeshDeserializer::isCurrent(cookedFilename);
 }
 
 uint32_t MeshManager::count() {
-	return m_meshes.size();
+	return static_cast<uint32_t>(m_cache.size());
 }
\ No newline at end of file
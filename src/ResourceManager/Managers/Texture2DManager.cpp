@@ -1,5 +1,8 @@
 #include <ResourceManager/Managers/Texture2DManager.h>
+#include <Asset/AssetArchive.h>
+#include <Profiling/StatsRegistry.h>
 #include <string>
+#include <utility>
 #include <unordered_map>
 #include <Texture/Texture2D.h>
 #include <memory>
@@ -10,17 +13,26 @@ Texture2DManager& Texture2DManager::getInstance() {
 }
 
 std::shared_ptr<Texture2D> Texture2DManager::loadTextureFromFile(const std::string& filename) {
-	auto it = m_textures.find(filename);
-	if (it != m_textures.end()) {
-		return it->second;
+	static auto& loads = StatsRegistry::getInstance().counter("Resources/TextureLoads");
+	static auto& cacheHits = StatsRegistry::getInstance().counter("Resources/TextureCacheHits");
+	bool loaded = false;
+	std::shared_ptr<Texture2D> tex;
+	if (const auto entry = AssetArchive::getInstance().find(filename)) {
+		tex = m_cache.getOrLoad(ResourceCache<Texture2D>::makeContentKey(entry->contentHash, "rgba8"), [&entry, &loaded]() {
+			loaded = true;
+			return std::make_shared<Texture2D>(entry->bytes);
+		});
 	}
-
-	auto tex = std::make_shared<Texture2D>(filename);
-	m_textures[filename] = tex;
-
+	else {
+		tex = m_cache.getOrLoad(ResourceCache<Texture2D>::makeKey(filename, "rgba8"), [&filename, &loaded]() {
+			loaded = true;
+			return std::make_shared<Texture2D>(filename);
+		});
+	}
+	(loaded ? loads : cacheHits).add();
 	return tex;
 }
 
 uint32_t Texture2DManager::count() {
-	return m_textures.size();
+	return static_cast<uint32_t>(m_cache.size());
 }
\ No newline at end of file
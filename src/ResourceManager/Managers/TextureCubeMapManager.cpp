@@ -1,6 +1,11 @@
 #include <ResourceManager/Managers/TextureCubeMapManager.h>
+#include <Asset/AssetArchive.h>
+#include <Profiling/StatsRegistry.h>
 #include <Texture/TextureCubeMap.h>
+#include <array>
+#include <optional>
 #include <string>
+#include <utility>
 
 TextureCubeMapManager& TextureCubeMapManager::getInstance()
 {
@@ -8,7 +13,7 @@ TextureCubeMapManager& TextureCubeMapManager::getInstance()
 	return instance;
 }
 
-std::shared_ptr<TextureCubeMap> TextureCubeMapManager::loadTexturesFromFile(const std::string& name,
+std::shared_ptr<TextureCubeMap> TextureCubeMapManager::loadTexturesFromFile(
 	const std::string& frontFilename,
 	const std::string& backFilename,
 	const std::string& leftFilename,
@@ -17,18 +22,40 @@ std::shared_ptr<TextureCubeMap> TextureCubeMapManager::loadTexturesFromFile(cons
 	const std::string& bottomFilename
 )
 {
-	auto it = m_cubeMaps.find(name);
-	if (it != m_cubeMaps.end()) {
-		return it->second;
+	static auto& loads = StatsRegistry::getInstance().counter("Resources/TextureLoads");
+	static auto& cacheHits = StatsRegistry::getInstance().counter("Resources/TextureCacheHits");
+	const std::string* const faces[6] = { &frontFilename, &backFilename, &leftFilename, &rightFilename, &topFilename, &bottomFilename };
+
+	/* from the archive only when every face is packed, otherwise all six come from loose files */
+	std::array<std::optional<AssetArchive::Entry>, 6> entries;
+	bool archived = true;
+	for (size_t i = 0; i < 6; ++i) {
+		entries[i] = AssetArchive::getInstance().find(*faces[i]);
+		archived = archived && entries[i].has_value();
 	}
 
-	auto tex = std::make_shared<TextureCubeMap>(frontFilename, backFilename, leftFilename, rightFilename, topFilename, bottomFilename);
-	m_cubeMaps[name] = tex;
+	/* keyed by the faces, the same six images are one cubemap whatever the caller calls it */
+	std::string key;
+	for (size_t i = 0; i < 6; ++i) {
+		key += archived ? ResourceCache<TextureCubeMap>::makeContentKey(entries[i]->contentHash) : ResourceCache<TextureCubeMap>::makeKey(*faces[i]);
+		key += ';';
+	}
 
+	bool loaded = false;
+	auto tex = m_cache.getOrLoad(key, [&]() {
+		loaded = true;
+		if (archived) {
+			std::array<std::span<const uint8_t>, 6> encodedFaces;
+			for (size_t i = 0; i < 6; ++i) encodedFaces[i] = entries[i]->bytes;
+			return std::make_shared<TextureCubeMap>(encodedFaces);
+		}
+		return std::make_shared<TextureCubeMap>(frontFilename, backFilename, leftFilename, rightFilename, topFilename, bottomFilename);
+	});
+	(loaded ? loads : cacheHits).add();
 	return tex;
 }
 
 uint32_t TextureCubeMapManager::count()
 {
-	return m_cubeMaps.size();
+	return static_cast<uint32_t>(m_cache.size());
 }
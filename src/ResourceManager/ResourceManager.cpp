@@ -1,6 +1,59 @@
 #include <ResourceManager/ResourceManager.h>
+#include <Profiling/StatsRegistry.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
 
 ResourceManager& ResourceManager::getInstance() {
 	static ResourceManager instance;
 	return instance;
-}
\ No newline at end of file
+}
+
+size_t ResourceManager::getGpuBytes() const {
+	return meshManager.getCache().getGpuBytes() + texture2DManager.getCache().getGpuBytes() + textureCubeMapManager.getCache().getGpuBytes();
+}
+
+size_t ResourceManager::getCpuBytes() const {
+	return meshManager.getCache().getCpuBytes() + texture2DManager.getCache().getCpuBytes() + textureCubeMapManager.getCache().getCpuBytes();
+}
+
+void ResourceManager::enforceBudgets() {
+	static auto& evictions = StatsRegistry::getInstance().counter("Resources/Evictions");
+
+	auto overBudget = [this]() {
+		return (m_settings.gpuBudgetBytes && getGpuBytes() > m_settings.gpuBudgetBytes)
+			|| (m_settings.cpuBudgetBytes && getCpuBytes() > m_settings.cpuBudgetBytes);
+	};
+
+	if (overBudget()) {
+		/* merge every manager's candidates into one least recently used order */
+		struct Candidate {
+			uint64_t lastUsed;
+			size_t gpuBytes;
+			std::function<bool()> evict;
+		};
+		std::vector<Candidate> candidates;
+		auto collect = [&candidates](auto& cache) {
+			for (auto& candidate : cache.getEvictionCandidates()) {
+				candidates.push_back({ candidate.lastUsed, candidate.gpuBytes, [&cache, key = std::move(candidate.key)]() { return cache.evict(key); } });
+			}
+		};
+		collect(meshManager.getCache());
+		collect(texture2DManager.getCache());
+		collect(textureCubeMapManager.getCache());
+		std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.lastUsed < b.lastUsed; });
+
+		for (const auto& candidate : candidates) {
+			if (!overBudget()) break;
+			if (!candidate.evict()) continue;
+			++m_stats.evictedCount;
+			m_stats.evictedGpuBytes += candidate.gpuBytes;
+			evictions.add();
+		}
+	}
+
+	m_stats.gpuBytes = getGpuBytes();
+	m_stats.cpuBytes = getCpuBytes();
+	m_stats.overBudget = overBudget();
+}
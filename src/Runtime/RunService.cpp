@@ -0,0 +1,57 @@
+#include <Runtime/RunService.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+RunService::RunService() : RunService(Settings{}) {}
+
+RunService::RunService(const Settings& settings) : m_settings(settings) {
+	if (m_settings.fixedDeltaTime <= 0.0) throw std::runtime_error("RunService fixedDeltaTime must be positive");
+	m_settings.maxStepsPerFrame = std::max(m_settings.maxStepsPerFrame, 1);
+}
+
+void RunService::bindSimulation(SimulateFn simulate) {
+	m_simulate = std::move(simulate);
+}
+
+int RunService::update(double frameDeltaTime) {
+	frameDeltaTime = std::max(frameDeltaTime, 0.0);
+	renderStepped.fire(frameDeltaTime);
+
+	const double step = m_settings.fixedDeltaTime;
+	m_accumulator += frameDeltaTime;
+
+	const auto start = std::chrono::steady_clock::now();
+	int steps = 0;
+	while (m_accumulator >= step && steps < m_settings.maxStepsPerFrame) {
+		stepped.fire(m_time, step);
+		if (m_simulate) m_simulate(step);
+		m_time += step;
+		m_accumulator -= step;
+		++steps;
+	}
+
+	/* keep less than a step so the interpolation alpha stays in range after a hitch */
+	if (m_accumulator >= step) {
+		const double dropped = m_accumulator - std::fmod(m_accumulator, step);
+		m_stats.droppedSeconds += dropped;
+		m_accumulator -= dropped;
+	}
+
+	m_stats.stepCount += steps;
+	m_stats.stepsLastFrame = steps;
+	m_stats.simulationMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	heartbeat.fire(frameDeltaTime);
+	return steps;
+}
+
+double RunService::getInterpolationAlpha() const {
+	return m_accumulator / m_settings.fixedDeltaTime;
+}
+
+double RunService::getTime() const {
+	return m_time;
+}
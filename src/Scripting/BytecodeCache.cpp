@@ -0,0 +1,175 @@
+#include <Scripting/BytecodeCache.h>
+#include <Util/Hash.h>
+#include <luacode.h>
+#include <Luau/Bytecode.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace {
+	constexpr char magic[4] = { 'E', 'L', 'B', 'C' };
+	/* bump when the entry layout or the way keys are built changes */
+	constexpr uint32_t version = 1;
+
+	struct EntryHeader {
+		char magic[4];
+		uint32_t version;
+		uint64_t key;
+		/* guards against key collisions together with the key */
+		uint64_t sourceSize;
+		uint64_t bytecodeSize;
+	};
+
+	/* length-prefixed so neighbouring fields can't run together, null hashes differently from "" */
+	uint64_t hashString(const char* text, uint64_t hash) {
+		if (!text) return Hash::fnv1aValue(uint64_t{ 0 }, hash);
+		const std::string_view view{ text };
+		hash = Hash::fnv1aValue(static_cast<uint64_t>(view.size() + 1), hash);
+		return Hash::fnv1a(view, hash);
+	}
+
+	uint64_t hashStringList(const char* const* list, uint64_t hash) {
+		uint64_t count = 0;
+		for (; list && list[count]; ++count) hash = hashString(list[count], hash);
+		return Hash::fnv1aValue(count, hash);
+	}
+
+	std::string compile(const std::string& source, const lua_CompileOptions& options) {
+		lua_CompileOptions compileOptions = options;
+		size_t size = 0;
+		std::unique_ptr<char, decltype(&std::free)> bytecode{ luau_compile(source.data(), source.size(), &compileOptions, &size), &std::free };
+		if (!bytecode) return {};
+		return std::string{ bytecode.get(), size };
+	}
+}
+
+BytecodeCache::BytecodeCache(std::filesystem::path directory) : m_directory(std::move(directory)) {}
+
+BytecodeCache& BytecodeCache::getInstance() {
+	static BytecodeCache instance{ "./cache/bytecode" };
+	return instance;
+}
+
+uint64_t BytecodeCache::getKey(const std::string& source, const lua_CompileOptions& options) {
+	uint64_t hash = Hash::fnv1aValue(version);
+	/* a Luau upgrade that changes the bytecode version misses instead of loading what it can't read */
+	hash = Hash::fnv1aValue(static_cast<int32_t>(LBC_VERSION_TARGET), hash);
+	hash = Hash::fnv1a(source, hash);
+	hash = Hash::fnv1aValue(options.optimizationLevel, hash);
+	hash = Hash::fnv1aValue(options.debugLevel, hash);
+	hash = Hash::fnv1aValue(options.typeInfoLevel, hash);
+	hash = Hash::fnv1aValue(options.coverageLevel, hash);
+	hash = hashString(options.vectorLib, hash);
+	hash = hashString(options.vectorCtor, hash);
+	hash = hashString(options.vectorType, hash);
+	hash = hashStringList(options.mutableGlobals, hash);
+	hash = hashStringList(options.userdataTypes, hash);
+	hash = hashStringList(options.librariesWithKnownMembers, hash);
+	hash = hashStringList(options.disabledBuiltins, hash);
+	/* the library member callbacks can't be hashed, options that set them must not share a cache directory */
+	return hash;
+}
+
+std::string BytecodeCache::getBytecode(const std::string& source, const lua_CompileOptions& options) {
+	const uint64_t key = getKey(source, options);
+
+	std::string bytecode;
+	if (read(key, source.size(), bytecode)) {
+		std::lock_guard lock(m_mutex);
+		++m_stats.hitCount;
+		return bytecode;
+	}
+
+	return compileAndStore(key, source, options);
+}
+
+std::string BytecodeCache::refresh(const std::string& source, const lua_CompileOptions& options) {
+	{
+		std::lock_guard lock(m_mutex);
+		++m_stats.refreshCount;
+	}
+	return compileAndStore(getKey(source, options), source, options);
+}
+
+std::string BytecodeCache::compileAndStore(uint64_t key, const std::string& source, const lua_CompileOptions& options) {
+	std::string bytecode = compile(source, options);
+	/* a leading 0 is luau_compile's encoding of a compile error */
+	const bool compiled = !bytecode.empty() && bytecode[0] != 0;
+	const bool written = !compiled || write(key, source.size(), bytecode);
+
+	std::lock_guard lock(m_mutex);
+	++m_stats.missCount;
+	if (!written) ++m_stats.writeFailureCount;
+	return bytecode;
+}
+
+BytecodeCache::Stats BytecodeCache::getStats() const {
+	std::lock_guard lock(m_mutex);
+	return m_stats;
+}
+
+std::filesystem::path BytecodeCache::getPath(uint64_t key) const {
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.luac", static_cast<unsigned long long>(key));
+	return m_directory / name;
+}
+
+bool BytecodeCache::read(uint64_t key, size_t sourceSize, std::string& bytecode) const {
+	std::ifstream file{ getPath(key), std::ios::binary };
+	if (!file.is_open()) return false;
+
+	EntryHeader header{};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file || std::memcmp(header.magic, magic, sizeof(magic)) || header.version != version) return false;
+	if (header.key != key || header.sourceSize != sourceSize || header.bytecodeSize == 0) return false;
+
+	bytecode.resize(header.bytecodeSize);
+	file.read(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+	return static_cast<bool>(file);
+}
+
+bool BytecodeCache::write(uint64_t key, size_t sourceSize, const std::string& bytecode) const {
+	std::error_code error;
+	std::filesystem::create_directories(m_directory, error);
+	if (error) return false;
+
+	/*
+	 * written aside and renamed so a reader never sees a partial entry; the temporary name is unique
+	 * to this write, other threads and processes sharing the directory may be writing the same key
+	 */
+	static const uint64_t processTag = (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+	static std::atomic<uint64_t> writeCount{ 0 };
+	char suffix[48];
+	std::snprintf(suffix, sizeof(suffix), ".%016llx.%llu.tmp", static_cast<unsigned long long>(processTag), static_cast<unsigned long long>(writeCount++));
+
+	const auto path = getPath(key);
+	auto temporaryPath = path;
+	temporaryPath += suffix;
+	{
+		std::ofstream file{ temporaryPath, std::ios::binary | std::ios::trunc };
+		if (!file.is_open()) return false;
+
+		EntryHeader header{};
+		std::memcpy(header.magic, magic, sizeof(magic));
+		header.version = version;
+		header.key = key;
+		header.sourceSize = sourceSize;
+		header.bytecodeSize = bytecode.size();
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+		if (!file) return false;
+	}
+
+	std::filesystem::rename(temporaryPath, path, error);
+	if (!error) return true;
+
+	std::filesystem::remove(temporaryPath, error);
+	return false;
+}
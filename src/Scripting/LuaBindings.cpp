@@ -0,0 +1,655 @@
+#include <Scripting/LuaBindings.h>
+#include <Scripting/ScriptContext.h>
+#include <Scripting/TaskScheduler.h>
+#include <Instance/Instance.h>
+#include <Instance/InstanceFactory.h>
+#include <Instance/BasePart.h>
+#include <Instance/Script.h>
+#include <lua.h>
+#include <lualib.h>
+#include <luacode.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace LuaBindings;
+
+namespace {
+	/* indexed by Atom */
+	constexpr std::string_view atomNames[] = {
+		"Name", "ClassName", "Parent", "ChildAdded", "ChildRemoved", "Destroying", "DescendantAdded", "DescendantRemoving",
+		"FindFirstChild", "FindFirstChildOfClass", "FindFirstAncestor", "FindFirstAncestorOfClass",
+		"GetChildren", "GetDescendants", "GetFullName", "GetService", "IsA", "Clone", "Destroy",
+		"Position", "Orientation", "Size", "Transparency", "Anchored", "CanCollide", "CastShadow",
+		"Velocity", "AngularVelocity", "Density", "Friction", "Elasticity",
+		"Source",
+		"X", "Y", "Z", "Magnitude", "Unit", "Dot", "Cross",
+		"Connect", "Disconnect", "Connected", "Wait",
+	};
+	static_assert(std::size(atomNames) == static_cast<size_t>(Atom::Count));
+
+	/* registry keys */
+	constexpr const char* instanceCacheKey = "engine.instances";
+
+	struct InstanceHandle {
+		InstancePtr instance;
+		/* resolved once when the userdata is created so member access never casts */
+		BasePart* part = nullptr;
+		Script* script = nullptr;
+	};
+
+	enum class SignalKind : uint8_t { ChildAdded, ChildRemoved, Destroying, DescendantAdded, DescendantRemoving };
+
+	struct SignalHandle {
+		InstancePtr owner;
+		SignalKind kind;
+	};
+
+	struct ConnectionHandle {
+		uint32_t id = 0;
+	};
+
+	Atom toAtom(int atom) {
+		return atom >= 0 && atom < static_cast<int>(Atom::Count) ? static_cast<Atom>(atom) : Atom::Count;
+	}
+
+	template<typename T>
+	T* checkTagged(lua_State* L, int index, int tag, const char* typeName) {
+		auto* value = static_cast<T*>(lua_touserdatatagged(L, index, tag));
+		if (!value) luaL_typeerror(L, index, typeName);
+		return value;
+	}
+
+	template<typename T>
+	void pushTagged(lua_State* L, int tag, T value) {
+		new (lua_newuserdatataggedwithmetatable(L, sizeof(T), tag)) T(std::move(value));
+	}
+
+	template<typename T>
+	void registerDestructor(lua_State* L, int tag) {
+		lua_setuserdatadtor(L, tag, [](lua_State*, void* userdata) { static_cast<T*>(userdata)->~T(); });
+	}
+
+	/* member names not covered by __index / __namecall are looked up in the metatable's __methods */
+	void pushMethod(lua_State* L, int tag, const char* key) {
+		lua_getuserdatametatable(L, tag);
+		lua_rawgetfield(L, -1, "__methods");
+		lua_rawgetfield(L, -1, key);
+		lua_remove(L, -2);
+		lua_remove(L, -2);
+	}
+
+	[[noreturn]] void invalidMember(lua_State* L, const char* key, const std::string& typeName) {
+		luaL_error(L, "%s is not a valid member of %s", key ? key : "?", typeName.c_str());
+	}
+
+	/* the parallel phase only reads the tree, other Actors are reading it at the same time */
+	void checkSerial(lua_State* L, const char* action) {
+		if (ScriptContext::fromState(L)->getScheduler().isParallel()) luaL_error(L, "%s is not safe in parallel, call task.synchronize first", action);
+	}
+
+	void pushString(lua_State* L, const std::string& value) {
+		lua_pushlstring(L, value.data(), value.size());
+	}
+
+	void pushInstances(lua_State* L, const std::vector<InstancePtr>& instances) {
+		lua_createtable(L, static_cast<int>(instances.size()), 0);
+		for (size_t i = 0; i < instances.size(); ++i) {
+			pushInstance(L, instances[i]);
+			lua_rawseti(L, -2, static_cast<int>(i + 1));
+		}
+	}
+
+	/* ---- Vector3 ----
+	 * Vector3 is Luau's native vector: a value type like number, so reading or writing a
+	 * property allocates nothing and arithmetic, ==, tostring and .X / .Y / .Z run in the VM.
+	 * The compiler is told that Vector3.new constructs one, which makes it a builtin call.
+	 * Only the members below go through the shared vector metatable. */
+
+	int vector3New(lua_State* L) {
+		const float x = static_cast<float>(luaL_optnumber(L, 1, 0.0));
+		const float y = static_cast<float>(luaL_optnumber(L, 2, 0.0));
+		const float z = static_cast<float>(luaL_optnumber(L, 3, 0.0));
+		pushVector3(L, { x, y, z });
+		return 1;
+	}
+
+	int vector3Dot(lua_State* L) {
+		lua_pushnumber(L, glm::dot(checkVector3(L, 1), checkVector3(L, 2)));
+		return 1;
+	}
+
+	int vector3Cross(lua_State* L) {
+		pushVector3(L, glm::cross(checkVector3(L, 1), checkVector3(L, 2)));
+		return 1;
+	}
+
+	int vector3Index(lua_State* L) {
+		const glm::vec3 value = checkVector3(L, 1);
+		int atom = -1;
+		const char* key = lua_tostringatom(L, 2, &atom);
+		switch (toAtom(atom)) {
+		case Atom::X: lua_pushnumber(L, value.x); return 1;
+		case Atom::Y: lua_pushnumber(L, value.y); return 1;
+		case Atom::Z: lua_pushnumber(L, value.z); return 1;
+		case Atom::Magnitude: lua_pushnumber(L, glm::length(value)); return 1;
+		case Atom::Unit: {
+			const float length = glm::length(value);
+			pushVector3(L, length > 0.0f ? value / length : glm::vec3(0.0f));
+			return 1;
+		}
+		case Atom::Dot: lua_pushcfunction(L, vector3Dot, "Dot"); return 1;
+		case Atom::Cross: lua_pushcfunction(L, vector3Cross, "Cross"); return 1;
+		default:
+			invalidMember(L, key, "Vector3");
+		}
+	}
+
+	int vector3Namecall(lua_State* L) {
+		int atom = -1;
+		const char* name = lua_namecallatom(L, &atom);
+		switch (toAtom(atom)) {
+		case Atom::Dot: return vector3Dot(L);
+		case Atom::Cross: return vector3Cross(L);
+		default: invalidMember(L, name, "Vector3");
+		}
+	}
+
+	/* ---- Instance ---- */
+
+	InstanceHandle* checkInstanceHandle(lua_State* L, int index) {
+		return checkTagged<InstanceHandle>(L, index, InstanceTag, "Instance");
+	}
+
+	void pushSignal(lua_State* L, const InstancePtr& owner, SignalKind kind) {
+		pushTagged(L, SignalTag, SignalHandle{ owner, kind });
+	}
+
+	/* a Lua error for a parent that would form a cycle, rather than setParent's exception crossing the VM */
+	void setParent(lua_State* L, Instance& instance, const InstancePtr& newParent) {
+		if (newParent && instance.isAncestorOf(newParent.get())) {
+			luaL_error(L, "Attempt to set parent of %s to %s would result in circular reference", instance.getFullName().c_str(), newParent->getFullName().c_str());
+		}
+		instance.setParent(newParent);
+	}
+
+	int instanceNew(lua_State* L) {
+		const char* className = luaL_checkstring(L, 1);
+		checkSerial(L, "Instance.new");
+		auto instance = InstanceFactory::getInstance().create(className);
+		if (!instance) luaL_error(L, "Unable to create an Instance of type \"%s\"", className);
+		if (!lua_isnoneornil(L, 2)) setParent(L, *instance, checkInstanceHandle(L, 2)->instance);
+		pushInstance(L, instance);
+		return 1;
+	}
+
+	int instanceFindFirstChild(lua_State* L) {
+		pushInstance(L, checkInstanceHandle(L, 1)->instance->findFirstChild(luaL_checkstring(L, 2)));
+		return 1;
+	}
+
+	int instanceFindFirstChildOfClass(lua_State* L) {
+		pushInstance(L, checkInstanceHandle(L, 1)->instance->findFirstChildOfClass(luaL_checkstring(L, 2)));
+		return 1;
+	}
+
+	int instanceFindFirstAncestor(lua_State* L) {
+		pushInstance(L, checkInstanceHandle(L, 1)->instance->findFirstAncestor(luaL_checkstring(L, 2)));
+		return 1;
+	}
+
+	int instanceFindFirstAncestorOfClass(lua_State* L) {
+		pushInstance(L, checkInstanceHandle(L, 1)->instance->findFirstAncestorOfClass(luaL_checkstring(L, 2)));
+		return 1;
+	}
+
+	int instanceGetChildren(lua_State* L) {
+		pushInstances(L, checkInstanceHandle(L, 1)->instance->getChildren());
+		return 1;
+	}
+
+	int instanceGetDescendants(lua_State* L) {
+		pushInstances(L, checkInstanceHandle(L, 1)->instance->getDescendants());
+		return 1;
+	}
+
+	int instanceGetFullName(lua_State* L) {
+		pushString(L, checkInstanceHandle(L, 1)->instance->getFullName());
+		return 1;
+	}
+
+	int instanceGetService(lua_State* L) {
+		const char* name = luaL_checkstring(L, 2);
+		auto service = checkInstanceHandle(L, 1)->instance->findFirstChild(name);
+		if (!service) luaL_error(L, "'%s' is not a valid Service name", name);
+		pushInstance(L, service);
+		return 1;
+	}
+
+	int instanceIsA(lua_State* L) {
+		const InstanceHandle* handle = checkInstanceHandle(L, 1);
+		const std::string_view className = luaL_checkstring(L, 2);
+		bool result = className == "Instance" || handle->instance->getClassName() == className;
+		if (!result && className == "BasePart") result = handle->part != nullptr;
+		lua_pushboolean(L, result);
+		return 1;
+	}
+
+	int instanceClone(lua_State* L) {
+		checkSerial(L, "Clone");
+		pushInstance(L, checkInstanceHandle(L, 1)->instance->clone());
+		return 1;
+	}
+
+	int instanceDestroy(lua_State* L) {
+		checkSerial(L, "Destroy");
+		checkInstanceHandle(L, 1)->instance->destroy();
+		return 0;
+	}
+
+	lua_CFunction getInstanceMethod(Atom atom) {
+		switch (atom) {
+		case Atom::FindFirstChild: return instanceFindFirstChild;
+		case Atom::FindFirstChildOfClass: return instanceFindFirstChildOfClass;
+		case Atom::FindFirstAncestor: return instanceFindFirstAncestor;
+		case Atom::FindFirstAncestorOfClass: return instanceFindFirstAncestorOfClass;
+		case Atom::GetChildren: return instanceGetChildren;
+		case Atom::GetDescendants: return instanceGetDescendants;
+		case Atom::GetFullName: return instanceGetFullName;
+		case Atom::GetService: return instanceGetService;
+		case Atom::IsA: return instanceIsA;
+		case Atom::Clone: return instanceClone;
+		case Atom::Destroy: return instanceDestroy;
+		default: return nullptr;
+		}
+	}
+
+	bool indexPart(lua_State* L, BasePart& part, Atom atom) {
+		switch (atom) {
+		case Atom::Position: pushVector3(L, part.position); return true;
+		case Atom::Orientation: pushVector3(L, part.orientation); return true;
+		case Atom::Size: pushVector3(L, part.size); return true;
+		case Atom::Velocity: pushVector3(L, part.velocity); return true;
+		case Atom::AngularVelocity: pushVector3(L, part.angularVelocity); return true;
+		case Atom::Transparency: lua_pushnumber(L, part.transparency); return true;
+		case Atom::Density: lua_pushnumber(L, part.density); return true;
+		case Atom::Friction: lua_pushnumber(L, part.friction); return true;
+		case Atom::Elasticity: lua_pushnumber(L, part.elasticity); return true;
+		case Atom::Anchored: lua_pushboolean(L, part.anchored); return true;
+		case Atom::CanCollide: lua_pushboolean(L, part.canCollide); return true;
+		case Atom::CastShadow: lua_pushboolean(L, part.castShadow); return true;
+		default: return false;
+		}
+	}
+
+	bool newIndexPart(lua_State* L, BasePart& part, Atom atom) {
+		switch (atom) {
+		case Atom::Position: part.position = checkVector3(L, 3); return true;
+		case Atom::Orientation: part.orientation = checkVector3(L, 3); return true;
+		case Atom::Size: part.size = checkVector3(L, 3); return true;
+		case Atom::Velocity: part.velocity = checkVector3(L, 3); return true;
+		case Atom::AngularVelocity: part.angularVelocity = checkVector3(L, 3); return true;
+		case Atom::Transparency: part.transparency = static_cast<float>(luaL_checknumber(L, 3)); return true;
+		case Atom::Density: part.density = static_cast<float>(luaL_checknumber(L, 3)); return true;
+		case Atom::Friction: part.friction = static_cast<float>(luaL_checknumber(L, 3)); return true;
+		case Atom::Elasticity: part.elasticity = static_cast<float>(luaL_checknumber(L, 3)); return true;
+		case Atom::Anchored: part.anchored = luaL_checkboolean(L, 3); return true;
+		case Atom::CanCollide: part.canCollide = luaL_checkboolean(L, 3); return true;
+		case Atom::CastShadow: part.castShadow = luaL_checkboolean(L, 3); return true;
+		default: return false;
+		}
+	}
+
+	int instanceIndex(lua_State* L) {
+		InstanceHandle* handle = checkInstanceHandle(L, 1);
+		Instance& instance = *handle->instance;
+		int atom = -1;
+		const char* key = lua_tostringatom(L, 2, &atom);
+		if (!key) luaL_typeerror(L, 2, "string");
+
+		const Atom member = toAtom(atom);
+		switch (member) {
+		case Atom::Name: pushString(L, instance.name); return 1;
+		case Atom::ClassName: pushString(L, instance.getClassName()); return 1;
+		case Atom::Parent: pushInstance(L, instance.parent.lock()); return 1;
+		case Atom::ChildAdded: pushSignal(L, handle->instance, SignalKind::ChildAdded); return 1;
+		case Atom::ChildRemoved: pushSignal(L, handle->instance, SignalKind::ChildRemoved); return 1;
+		case Atom::Destroying: pushSignal(L, handle->instance, SignalKind::Destroying); return 1;
+		case Atom::DescendantAdded: pushSignal(L, handle->instance, SignalKind::DescendantAdded); return 1;
+		case Atom::DescendantRemoving: pushSignal(L, handle->instance, SignalKind::DescendantRemoving); return 1;
+		default: break;
+		}
+		if (handle->part && indexPart(L, *handle->part, member)) return 1;
+		if (handle->script && member == Atom::Source) {
+			pushString(L, handle->script->source);
+			return 1;
+		}
+		if (getInstanceMethod(member)) {
+			pushMethod(L, InstanceTag, key);
+			return 1;
+		}
+
+		/* like Roblox, children are reachable by name when no member matches */
+		if (auto child = instance.findFirstChild(key)) {
+			pushInstance(L, child);
+			return 1;
+		}
+		invalidMember(L, key, instance.getClassName());
+	}
+
+	int instanceNewIndex(lua_State* L) {
+		InstanceHandle* handle = checkInstanceHandle(L, 1);
+		Instance& instance = *handle->instance;
+		int atom = -1;
+		const char* key = lua_tostringatom(L, 2, &atom);
+		if (!key) luaL_typeerror(L, 2, "string");
+		checkSerial(L, "Setting a property");
+
+		const Atom member = toAtom(atom);
+		switch (member) {
+		case Atom::Name:
+			instance.name = luaL_checkstring(L, 3);
+			return 0;
+		case Atom::Parent:
+			setParent(L, instance, lua_isnil(L, 3) ? nullptr : checkInstanceHandle(L, 3)->instance);
+			return 0;
+		default:
+			break;
+		}
+		if (handle->part && newIndexPart(L, *handle->part, member)) return 0;
+		if (handle->script && member == Atom::Source) {
+			handle->script->source = luaL_checkstring(L, 3);
+			return 0;
+		}
+		invalidMember(L, key, instance.getClassName());
+	}
+
+	int instanceNamecall(lua_State* L) {
+		int atom = -1;
+		const char* name = lua_namecallatom(L, &atom);
+		if (lua_CFunction method = getInstanceMethod(toAtom(atom))) return method(L);
+		invalidMember(L, name, checkInstanceHandle(L, 1)->instance->getClassName());
+	}
+
+	int instanceToString(lua_State* L) {
+		pushString(L, checkInstanceHandle(L, 1)->instance->name);
+		return 1;
+	}
+
+	/* ---- Signal / Connection ---- */
+
+	/* handler gets a PushArgs that pushes the fired event's arguments */
+	EventConnection connectSignal(const SignalHandle& signal, std::function<void(const ScriptContext::PushArgs&)> handler) {
+		Instance& owner = *signal.owner;
+		auto call = [handler]() { handler(nullptr); };
+		auto callWith = [handler](InstancePtr instance) {
+			handler([&instance](lua_State* thread) {
+				pushInstance(thread, instance);
+				return 1;
+			});
+		};
+		switch (signal.kind) {
+		case SignalKind::ChildAdded: return owner.childAdded.connect(call);
+		case SignalKind::ChildRemoved: return owner.childRemoved.connect(call);
+		case SignalKind::Destroying: return owner.destroyed.connect(call);
+		case SignalKind::DescendantAdded: return owner.descendantAdded.connect(callWith);
+		case SignalKind::DescendantRemoving: return owner.descendantRemoving.connect(callWith);
+		}
+		return EventConnection{};
+	}
+
+	int signalConnect(lua_State* L) {
+		const SignalHandle* handle = checkTagged<SignalHandle>(L, 1, SignalTag, "RBXScriptSignal");
+		luaL_checktype(L, 2, LUA_TFUNCTION);
+		ScriptContext* context = ScriptContext::fromState(L);
+
+		const uint32_t id = context->connect(L, lua_ref(L, 2), [&](uint32_t connectionId) {
+			return connectSignal(*handle, [context, connectionId](const ScriptContext::PushArgs& pushArgs) {
+				context->invokeConnection(connectionId, pushArgs);
+			});
+		});
+		pushTagged(L, ConnectionTag, ConnectionHandle{ id });
+		return 1;
+	}
+
+	/* yields until the signal fires, returning its arguments */
+	int signalWait(lua_State* L) {
+		const SignalHandle* handle = checkTagged<SignalHandle>(L, 1, SignalTag, "RBXScriptSignal");
+		if (!lua_isyieldable(L)) luaL_error(L, "Wait can't yield from here");
+		ScriptContext::fromState(L)->getScheduler().waitForEvent(L, [handle](TaskScheduler::EventResumer resume) {
+			return connectSignal(*handle, std::move(resume));
+		});
+		return lua_yield(L, 0);
+	}
+
+	int signalIndex(lua_State* L) {
+		checkTagged<SignalHandle>(L, 1, SignalTag, "RBXScriptSignal");
+		int atom = -1;
+		const char* key = lua_tostringatom(L, 2, &atom);
+		const Atom member = toAtom(atom);
+		if (member != Atom::Connect && member != Atom::Wait) invalidMember(L, key, "RBXScriptSignal");
+		pushMethod(L, SignalTag, key);
+		return 1;
+	}
+
+	int signalNamecall(lua_State* L) {
+		int atom = -1;
+		const char* name = lua_namecallatom(L, &atom);
+		switch (toAtom(atom)) {
+		case Atom::Connect: return signalConnect(L);
+		case Atom::Wait: return signalWait(L);
+		default: break;
+		}
+		invalidMember(L, name, "RBXScriptSignal");
+	}
+
+	int connectionDisconnect(lua_State* L) {
+		const ConnectionHandle* handle = checkTagged<ConnectionHandle>(L, 1, ConnectionTag, "RBXScriptConnection");
+		ScriptContext::fromState(L)->disconnect(handle->id);
+		return 0;
+	}
+
+	int connectionIndex(lua_State* L) {
+		const ConnectionHandle* handle = checkTagged<ConnectionHandle>(L, 1, ConnectionTag, "RBXScriptConnection");
+		int atom = -1;
+		const char* key = lua_tostringatom(L, 2, &atom);
+		switch (toAtom(atom)) {
+		case Atom::Connected:
+			lua_pushboolean(L, ScriptContext::fromState(L)->isConnected(handle->id));
+			return 1;
+		case Atom::Disconnect:
+			pushMethod(L, ConnectionTag, key);
+			return 1;
+		default:
+			invalidMember(L, key, "RBXScriptConnection");
+		}
+	}
+
+	int connectionNamecall(lua_State* L) {
+		int atom = -1;
+		const char* name = lua_namecallatom(L, &atom);
+		if (toAtom(atom) == Atom::Disconnect) return connectionDisconnect(L);
+		invalidMember(L, name, "RBXScriptConnection");
+	}
+
+	/* ---- registration ---- */
+
+	/* builds the metatable for tag from the metamethods and the methods reachable by plain indexing */
+	void registerType(lua_State* L, int tag, const char* typeName, const luaL_Reg* metamethods, const luaL_Reg* methods) {
+		lua_newtable(L);
+		for (const luaL_Reg* entry = metamethods; entry->name; ++entry) {
+			lua_pushcfunction(L, entry->func, entry->name);
+			lua_rawsetfield(L, -2, entry->name);
+		}
+		lua_pushstring(L, typeName);
+		lua_rawsetfield(L, -2, "__type");
+
+		lua_newtable(L);
+		for (const luaL_Reg* entry = methods; entry->name; ++entry) {
+			lua_pushcfunction(L, entry->func, entry->name);
+			lua_rawsetfield(L, -2, entry->name);
+		}
+		lua_setreadonly(L, -1, true);
+		lua_rawsetfield(L, -2, "__methods");
+
+		lua_setreadonly(L, -1, true);
+		lua_setuserdatametatable(L, tag);
+	}
+}
+
+int16_t LuaBindings::getAtom(const char* s, size_t length) {
+	static const auto atoms = []() {
+		std::unordered_map<std::string_view, int16_t> table;
+		for (size_t i = 0; i < std::size(atomNames); ++i) table.emplace(atomNames[i], static_cast<int16_t>(i));
+		return table;
+	}();
+	auto it = atoms.find(std::string_view(s, length));
+	return it == atoms.end() ? -1 : it->second;
+}
+
+lua_CompileOptions LuaBindings::compileOptions() {
+	lua_CompileOptions options{};
+	options.optimizationLevel = 1;
+	options.debugLevel = 1;
+	options.vectorLib = "Vector3";
+	options.vectorCtor = "new";
+	options.vectorType = "Vector3";
+	return options;
+}
+
+void LuaBindings::open(lua_State* L, const InstancePtr& dataModel) {
+	/* weak values, an Instance's userdata lives only as long as scripts reference it */
+	lua_newtable(L);
+	lua_newtable(L);
+	lua_pushstring(L, "v");
+	lua_rawsetfield(L, -2, "__mode");
+	lua_setmetatable(L, -2);
+	lua_rawsetfield(L, LUA_REGISTRYINDEX, instanceCacheKey);
+
+	const luaL_Reg instanceMetamethods[] = {
+		{ "__index", instanceIndex },
+		{ "__newindex", instanceNewIndex },
+		{ "__namecall", instanceNamecall },
+		{ "__tostring", instanceToString },
+		{ nullptr, nullptr },
+	};
+	const luaL_Reg instanceMethods[] = {
+		{ "FindFirstChild", instanceFindFirstChild },
+		{ "FindFirstChildOfClass", instanceFindFirstChildOfClass },
+		{ "FindFirstAncestor", instanceFindFirstAncestor },
+		{ "FindFirstAncestorOfClass", instanceFindFirstAncestorOfClass },
+		{ "GetChildren", instanceGetChildren },
+		{ "GetDescendants", instanceGetDescendants },
+		{ "GetFullName", instanceGetFullName },
+		{ "GetService", instanceGetService },
+		{ "IsA", instanceIsA },
+		{ "Clone", instanceClone },
+		{ "Destroy", instanceDestroy },
+		{ nullptr, nullptr },
+	};
+	registerType(L, InstanceTag, "Instance", instanceMetamethods, instanceMethods);
+	registerDestructor<InstanceHandle>(L, InstanceTag);
+
+	/* vectors have one metatable for the whole type, set through any vector value */
+	lua_pushvector(L, 0.0f, 0.0f, 0.0f);
+	lua_newtable(L);
+	lua_pushcfunction(L, vector3Index, "__index");
+	lua_rawsetfield(L, -2, "__index");
+	lua_pushcfunction(L, vector3Namecall, "__namecall");
+	lua_rawsetfield(L, -2, "__namecall");
+	lua_setreadonly(L, -1, true);
+	lua_setmetatable(L, -2);
+	lua_pop(L, 1);
+
+	const luaL_Reg signalMetamethods[] = {
+		{ "__index", signalIndex },
+		{ "__namecall", signalNamecall },
+		{ nullptr, nullptr },
+	};
+	const luaL_Reg signalMethods[] = {
+		{ "Connect", signalConnect },
+		{ "Wait", signalWait },
+		{ nullptr, nullptr },
+	};
+	registerType(L, SignalTag, "RBXScriptSignal", signalMetamethods, signalMethods);
+	registerDestructor<SignalHandle>(L, SignalTag);
+
+	const luaL_Reg connectionMetamethods[] = {
+		{ "__index", connectionIndex },
+		{ "__namecall", connectionNamecall },
+		{ nullptr, nullptr },
+	};
+	const luaL_Reg connectionMethods[] = {
+		{ "Disconnect", connectionDisconnect },
+		{ nullptr, nullptr },
+	};
+	registerType(L, ConnectionTag, "RBXScriptConnection", connectionMetamethods, connectionMethods);
+
+	const luaL_Reg instanceLibrary[] = {
+		{ "new", instanceNew },
+		{ nullptr, nullptr },
+	};
+	luaL_register(L, "Instance", instanceLibrary);
+	lua_pop(L, 1);
+
+	const luaL_Reg vector3Library[] = {
+		{ "new", vector3New },
+		{ nullptr, nullptr },
+	};
+	luaL_register(L, "Vector3", vector3Library);
+	pushVector3(L, glm::vec3(0.0f));
+	lua_rawsetfield(L, -2, "zero");
+	pushVector3(L, glm::vec3(1.0f));
+	lua_rawsetfield(L, -2, "one");
+	lua_pop(L, 1);
+
+	pushInstance(L, dataModel);
+	lua_setglobal(L, "game");
+	if (auto workspace = dataModel->findFirstChild("Workspace")) {
+		pushInstance(L, workspace);
+		lua_setglobal(L, "workspace");
+	}
+}
+
+void LuaBindings::pushInstance(lua_State* L, const InstancePtr& instance) {
+	if (!instance) {
+		lua_pushnil(L);
+		return;
+	}
+
+	lua_rawgetfield(L, LUA_REGISTRYINDEX, instanceCacheKey);
+	lua_pushlightuserdata(L, instance.get());
+	if (lua_rawget(L, -2) != LUA_TNIL) {
+		lua_remove(L, -2);
+		return;
+	}
+	lua_pop(L, 1);
+
+	pushTagged(L, InstanceTag, InstanceHandle{ instance, dynamic_cast<BasePart*>(instance.get()), dynamic_cast<Script*>(instance.get()) });
+	lua_pushlightuserdata(L, instance.get());
+	lua_pushvalue(L, -2);
+	lua_rawset(L, -4);
+	lua_remove(L, -2);
+}
+
+Instance* LuaBindings::checkInstance(lua_State* L, int index) {
+	return checkInstanceHandle(L, index)->instance.get();
+}
+
+void LuaBindings::pushVector3(lua_State* L, const glm::vec3& value) {
+	lua_pushvector(L, value.x, value.y, value.z);
+}
+
+glm::vec3 LuaBindings::checkVector3(lua_State* L, int index) {
+	const float* value = lua_tovector(L, index);
+	if (!value) luaL_typeerror(L, index, "Vector3");
+	return { value[0], value[1], value[2] };
+}
@@ -0,0 +1,165 @@
+#include <Scripting/ScriptContext.h>
+#include <Scripting/LuaBindings.h>
+#include <Instance/Instance.h>
+#include <Instance/Script.h>
+#include <lua.h>
+#include <lualib.h>
+#include <luacode.h>
+#include <memory>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+ScriptContext::ScriptContext(const InstancePtr& dataModel, const InstancePtr& actor, BytecodeCache& bytecodeCache)
+	: m_dataModel(dataModel), m_actor(actor), m_scheduler(*this), m_bytecodeCache(bytecodeCache) {
+	m_state = luaL_newstate();
+	if (!m_state) throw std::runtime_error("Failed to create Luau state");
+
+	/* before anything interns a string, atoms are assigned at string creation */
+	lua_Callbacks* callbacks = lua_callbacks(m_state);
+	callbacks->userdata = this;
+	callbacks->useratom = LuaBindings::getAtom;
+	callbacks->interrupt = interrupt;
+	callbacks->userthread = userthread;
+
+	luaL_openlibs(m_state);
+	TaskScheduler::openLibrary(m_state);
+	LuaBindings::open(m_state, m_dataModel);
+	/* globals become read-only, scripts get their own environment in runScript */
+	luaL_sandbox(m_state);
+}
+
+ScriptContext::~ScriptContext() {
+	/* handlers point back at this context, they must be gone before the VM */
+	for (auto& [id, connection] : m_connections) connection.connection.disconnect();
+	m_connections.clear();
+	m_scheduler.clear();
+	lua_close(m_state);
+}
+
+ScriptContext* ScriptContext::fromState(lua_State* L) {
+	return static_cast<ScriptContext*>(lua_callbacks(L)->userdata);
+}
+
+void ScriptContext::runScripts() {
+	for (const auto& inst : m_dataModel->getDescendants()) {
+		auto script = std::dynamic_pointer_cast<Script>(inst);
+		if (script && script->findFirstAncestorOfClass("Actor") == m_actor) {
+			runScript(script->source, script->getFullName(), script);
+		}
+	}
+}
+
+bool ScriptContext::runScript(const std::string& source, const std::string& chunkName, const std::shared_ptr<Script>& script) {
+	const lua_CompileOptions options = LuaBindings::compileOptions();
+
+	std::string bytecode = m_bytecodeCache.getBytecode(source, options);
+	if (bytecode.empty()) {
+		std::println("[{}] failed to compile", chunkName);
+		return false;
+	}
+
+	lua_State* thread = lua_newthread(m_state);
+	luaL_sandboxthread(thread);
+	lua_setthreaddata(thread, m_scheduler.createScriptStats(chunkName));
+	if (script) {
+		LuaBindings::pushInstance(thread, script);
+		lua_setglobal(thread, "script");
+	}
+
+	const std::string loadName = "=" + chunkName;
+	int loadStatus = luau_load(thread, loadName.c_str(), bytecode.data(), bytecode.size(), 0);
+	/* cached bytecode this Luau can't load, e.g. from another version: compile it afresh instead */
+	if (loadStatus != LUA_OK && bytecode[0] != 0) {
+		std::string compiled = m_bytecodeCache.refresh(source, options);
+		if (!compiled.empty() && compiled != bytecode) {
+			lua_pop(thread, 1);
+			bytecode = std::move(compiled);
+			loadStatus = luau_load(thread, loadName.c_str(), bytecode.data(), bytecode.size(), 0);
+		}
+	}
+	if (loadStatus != LUA_OK) {
+		std::println("[{}] {}", chunkName, lua_tostring(thread, -1));
+		lua_pop(m_state, 1);
+		return false;
+	}
+
+	const bool succeeded = resume(thread, 0);
+	lua_pop(m_state, 1);
+	return succeeded;
+}
+
+uint32_t ScriptContext::connect(lua_State* L, int functionRef, const std::function<EventConnection(uint32_t)>& connectEvent) {
+	const uint32_t id = m_nextConnectionId++;
+	auto* stats = static_cast<TaskScheduler::ScriptStats*>(lua_getthreaddata(L));
+	m_connections.emplace(id, ScriptConnection{ connectEvent(id), functionRef, stats });
+	return id;
+}
+
+void ScriptContext::disconnect(uint32_t id) {
+	auto it = m_connections.find(id);
+	if (it == m_connections.end()) return;
+	it->second.connection.disconnect();
+	lua_unref(m_state, it->second.functionRef);
+	m_connections.erase(it);
+}
+
+bool ScriptContext::isConnected(uint32_t id) const {
+	return m_connections.contains(id);
+}
+
+void ScriptContext::invokeConnection(uint32_t id, const PushArgs& pushArgs) {
+	/* a handler disconnected while its event was firing may still be called once */
+	auto it = m_connections.find(id);
+	if (it == m_connections.end()) return;
+
+	lua_State* thread = lua_newthread(m_state);
+	lua_setthreaddata(thread, it->second.stats);
+	lua_getref(thread, it->second.functionRef);
+	const int argumentCount = pushArgs ? pushArgs(thread) : 0;
+	resume(thread, argumentCount);
+	lua_pop(m_state, 1);
+}
+
+bool ScriptContext::resume(lua_State* thread, int argumentCount) {
+	const double start = lua_clock();
+	/* task.spawn and events fired from a script resume other threads inside this one,
+	 * they share the outermost deadline */
+	if (m_resumeDepth++ == 0) m_resumeDeadline = start + m_scheduler.getSettings().scriptTimeoutSeconds;
+	const double outerNestedSeconds = m_nestedSeconds;
+	m_nestedSeconds = 0.0;
+
+	const int status = lua_resume(thread, nullptr, argumentCount);
+
+	const double elapsed = lua_clock() - start;
+	auto* stats = static_cast<TaskScheduler::ScriptStats*>(lua_getthreaddata(thread));
+	if (stats) {
+		const double milliseconds = (elapsed - m_nestedSeconds) * 1000.0;
+		stats->totalMilliseconds += milliseconds;
+		stats->pendingMilliseconds += milliseconds;
+		++stats->resumeCount;
+	}
+	m_nestedSeconds = outerNestedSeconds + elapsed;
+	--m_resumeDepth;
+
+	if (status == LUA_OK || status == LUA_YIELD) return true;
+
+	const char* message = lua_tostring(thread, -1);
+	std::println("[{}] {}\n{}", stats ? stats->name : "script", message ? message : "error object is not a string", lua_debugtrace(thread));
+	return false;
+}
+
+void ScriptContext::interrupt(lua_State* L, int gc) {
+	/* gc >= 0 is a GC step, erroring there is not allowed */
+	if (gc >= 0) return;
+	ScriptContext* context = fromState(L);
+	if (context->m_resumeDepth > 0 && lua_clock() > context->m_resumeDeadline) {
+		luaL_error(L, "Script timeout: exhausted allowed execution time");
+	}
+}
+
+void ScriptContext::userthread(lua_State* parent, lua_State* thread) {
+	/* coroutines and task threads are charged to the script that created them */
+	if (parent) lua_setthreaddata(thread, lua_getthreaddata(parent));
+}
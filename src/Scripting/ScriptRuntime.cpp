@@ -0,0 +1,46 @@
+#include <Scripting/ScriptRuntime.h>
+#include <Profiling/Profiler.h>
+#include <Instance/Actor.h>
+#include <chrono>
+#include <memory>
+
+ScriptRuntime::ScriptRuntime(const InstancePtr& dataModel, ThreadPool& pool) : m_dataModel(dataModel), m_pool(pool) {
+	m_contexts.push_back(std::make_unique<ScriptContext>(m_dataModel));
+}
+
+void ScriptRuntime::start() {
+	for (const auto& inst : m_dataModel->getDescendants()) {
+		if (std::dynamic_pointer_cast<Actor>(inst)) m_contexts.push_back(std::make_unique<ScriptContext>(m_dataModel, inst));
+	}
+	m_stats.actorCount = m_contexts.size() - 1;
+
+	for (auto& context : m_contexts) context->runScripts();
+}
+
+void ScriptRuntime::step(double now) {
+	using Milliseconds = std::chrono::duration<double, std::milli>;
+
+	PROFILE_ZONE("Scripts");
+	auto start = std::chrono::steady_clock::now();
+	for (auto& context : m_contexts) context->getScheduler().step(now);
+	m_stats.serialMilliseconds = Milliseconds(std::chrono::steady_clock::now() - start).count();
+
+	/* the main context never has parallel work, it can't desynchronize */
+	start = std::chrono::steady_clock::now();
+	const size_t actorCount = m_contexts.size() - 1;
+	if (actorCount == 1) {
+		PROFILE_ZONE("Actor");
+		m_contexts[1]->getScheduler().stepParallel();
+	}
+	else if (actorCount > 1) {
+		m_pool.parallelFor(actorCount, [this](size_t actor) {
+			PROFILE_ZONE("Actor");
+			m_contexts[actor + 1]->getScheduler().stepParallel();
+		});
+	}
+	m_stats.parallelMilliseconds = Milliseconds(std::chrono::steady_clock::now() - start).count();
+
+	start = std::chrono::steady_clock::now();
+	for (auto& context : m_contexts) context->getScheduler().resumeSerial();
+	m_stats.serialMilliseconds += Milliseconds(std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,226 @@
+#include <Scripting/TaskScheduler.h>
+#include <Scripting/ScriptContext.h>
+#include <lua.h>
+#include <lualib.h>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace {
+	/* moves the function (or thread) at index 1 and the arguments after it onto a thread, leaves the thread on L */
+	lua_State* prepareTask(lua_State* L, int& argumentCount) {
+		lua_State* thread;
+		if (lua_type(L, 1) == LUA_TTHREAD) {
+			thread = lua_tothread(L, 1);
+			argumentCount = lua_gettop(L) - 1;
+			lua_xmove(L, thread, argumentCount);
+		}
+		else {
+			luaL_checktype(L, 1, LUA_TFUNCTION);
+			thread = lua_newthread(L);
+			lua_insert(L, 1);
+			argumentCount = lua_gettop(L) - 2;
+			lua_xmove(L, thread, argumentCount + 1);
+		}
+		return thread;
+	}
+
+	TaskScheduler& getScheduler(lua_State* L) {
+		return ScriptContext::fromState(L)->getScheduler();
+	}
+
+	int taskWait(lua_State* L) {
+		const double seconds = luaL_optnumber(L, 1, 0.0);
+		if (!lua_isyieldable(L)) luaL_error(L, "task.wait can't yield from here");
+		getScheduler(L).waitFor(L, seconds);
+		return lua_yield(L, 0);
+	}
+
+	int taskSpawn(lua_State* L) {
+		int argumentCount;
+		lua_State* thread = prepareTask(L, argumentCount);
+		ScriptContext::fromState(L)->resume(thread, argumentCount);
+		return 1;
+	}
+
+	int taskDefer(lua_State* L) {
+		int argumentCount;
+		lua_State* thread = prepareTask(L, argumentCount);
+		getScheduler(L).defer(thread, argumentCount);
+		return 1;
+	}
+
+	int taskDesynchronize(lua_State* L) {
+		ScriptContext* context = ScriptContext::fromState(L);
+		if (!context->getActor()) luaL_error(L, "task.desynchronize can only be called from a script under an Actor");
+		TaskScheduler& scheduler = context->getScheduler();
+		if (scheduler.isParallel()) return 0;
+		if (!lua_isyieldable(L)) luaL_error(L, "task.desynchronize can't yield from here");
+		scheduler.desynchronize(L);
+		return lua_yield(L, 0);
+	}
+
+	int taskSynchronize(lua_State* L) {
+		TaskScheduler& scheduler = getScheduler(L);
+		if (!scheduler.isParallel()) return 0;
+		if (!lua_isyieldable(L)) luaL_error(L, "task.synchronize can't yield from here");
+		scheduler.synchronize(L);
+		return lua_yield(L, 0);
+	}
+
+	int taskDelay(lua_State* L) {
+		const double seconds = luaL_checknumber(L, 1);
+		lua_remove(L, 1);
+		int argumentCount;
+		lua_State* thread = prepareTask(L, argumentCount);
+		getScheduler(L).delay(thread, argumentCount, seconds);
+		return 1;
+	}
+}
+
+TaskScheduler::TaskScheduler(ScriptContext& context) : m_context(context) {}
+
+void TaskScheduler::openLibrary(lua_State* L) {
+	const luaL_Reg taskLibrary[] = {
+		{ "wait", taskWait },
+		{ "spawn", taskSpawn },
+		{ "defer", taskDefer },
+		{ "delay", taskDelay },
+		{ "desynchronize", taskDesynchronize },
+		{ "synchronize", taskSynchronize },
+		{ nullptr, nullptr },
+	};
+	luaL_register(L, "task", taskLibrary);
+	lua_pop(L, 1);
+}
+
+bool TaskScheduler::laterTimer(const Timer& a, const Timer& b) {
+	if (a.resumeAt != b.resumeAt) return a.resumeAt > b.resumeAt;
+	return a.sequence > b.sequence;
+}
+
+int TaskScheduler::refThread(lua_State* thread) {
+	lua_pushthread(thread);
+	const int ref = lua_ref(thread, -1);
+	lua_pop(thread, 1);
+	return ref;
+}
+
+void TaskScheduler::schedule(lua_State* thread, int argumentCount, double seconds, bool returnsElapsed) {
+	Timer timer;
+	timer.resumeAt = m_now + std::max(seconds, 0.0);
+	timer.sequence = m_nextSequence++;
+	timer.ready = { thread, refThread(thread), argumentCount };
+	timer.waitStart = m_now;
+	timer.returnsElapsed = returnsElapsed;
+	timer.parallel = m_parallel;
+	m_timers.push_back(timer);
+	std::push_heap(m_timers.begin(), m_timers.end(), laterTimer);
+}
+
+void TaskScheduler::waitFor(lua_State* thread, double seconds) {
+	schedule(thread, 0, seconds, true);
+}
+
+void TaskScheduler::delay(lua_State* thread, int argumentCount, double seconds) {
+	schedule(thread, argumentCount, seconds, false);
+}
+
+void TaskScheduler::defer(lua_State* thread, int argumentCount) {
+	(m_parallel ? m_parallelReady : m_ready).push_back({ thread, refThread(thread), argumentCount });
+}
+
+void TaskScheduler::desynchronize(lua_State* thread) {
+	m_parallelReady.push_back({ thread, refThread(thread), 0 });
+}
+
+void TaskScheduler::synchronize(lua_State* thread) {
+	m_ready.push_back({ thread, refThread(thread), 0 });
+}
+
+void TaskScheduler::waitForEvent(lua_State* thread, const std::function<EventConnection(EventResumer)>& connectEvent) {
+	const uint64_t id = m_nextEventWait++;
+	auto& wait = m_eventWaits[id];
+	wait.ready = { thread, refThread(thread), 0 };
+	wait.connection = connectEvent([this, id](const PushArgs& pushArgs) {
+		auto it = m_eventWaits.find(id);
+		if (it == m_eventWaits.end()) return;
+
+		ReadyThread ready = it->second.ready;
+		if (pushArgs) ready.argumentCount = pushArgs(ready.thread);
+		m_ready.push_back(ready);
+		/* one-shot, the handler being run is a copy so dropping the connection here is safe */
+		m_eventWaits.erase(it);
+	});
+}
+
+void TaskScheduler::step(double now) {
+	m_now = now;
+	m_stats.resumedLastStep = 0;
+	m_stats.stepMilliseconds = 0.0;
+
+	for (auto& stats : m_scriptStats) {
+		stats.frameMilliseconds = stats.pendingMilliseconds;
+		stats.pendingMilliseconds = 0.0;
+	}
+
+	while (!m_timers.empty() && m_timers.front().resumeAt <= now) {
+		std::pop_heap(m_timers.begin(), m_timers.end(), laterTimer);
+		Timer timer = m_timers.back();
+		m_timers.pop_back();
+		if (timer.returnsElapsed) {
+			lua_pushnumber(timer.ready.thread, now - timer.waitStart);
+			++timer.ready.argumentCount;
+		}
+		(timer.parallel ? m_parallelReady : m_ready).push_back(timer.ready);
+	}
+
+	resumeQueue(m_ready);
+}
+
+void TaskScheduler::stepParallel() {
+	m_parallel = true;
+	resumeQueue(m_parallelReady);
+	m_parallel = false;
+}
+
+void TaskScheduler::resumeSerial() {
+	resumeQueue(m_ready);
+}
+
+void TaskScheduler::resumeQueue(std::deque<ReadyThread>& queue) {
+	const auto start = std::chrono::steady_clock::now();
+
+	/* threads readied while resuming (task.defer, events) wait for the next resumption point */
+	const size_t count = queue.size();
+	size_t resumed = 0;
+	while (resumed < count) {
+		const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (resumed > 0 && elapsed >= m_settings.resumeBudgetMilliseconds) break;
+
+		const ReadyThread ready = queue.front();
+		queue.pop_front();
+		m_context.resume(ready.thread, ready.argumentCount);
+		lua_unref(m_context.getState(), ready.ref);
+		++resumed;
+	}
+
+	m_stats.waitingCount = m_timers.size() + m_eventWaits.size();
+	m_stats.readyCount = m_ready.size();
+	m_stats.parallelReadyCount = m_parallelReady.size();
+	m_stats.resumedLastStep += resumed;
+	m_stats.stepMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void TaskScheduler::clear() {
+	m_eventWaits.clear();
+	m_timers.clear();
+	m_ready.clear();
+	m_parallelReady.clear();
+}
+
+TaskScheduler::ScriptStats* TaskScheduler::createScriptStats(std::string name) {
+	auto& stats = m_scriptStats.emplace_back();
+	stats.name = std::move(name);
+	return &stats;
+}
@@ -4,10 +4,18 @@
 #include <stdexcept>
 #include <vector>
 #include <iostream>
+#include <Profiling/StatsRegistry.h>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+namespace {
+	void countUniformUpload() {
+		static auto& uniformUploads = StatsRegistry::getInstance().counter("Render/UniformUploads");
+		uniformUploads.add();
+	}
+}
+
 GLuint Shader::compileShader(const std::string& source, GLenum shaderType) {
 	GLuint id = glCreateShader(shaderType);
 	const char* src = source.c_str();
@@ -72,32 +80,42 @@ Shader::~Shader() {
 }
 
 void Shader::use() const {
+	static auto& programBinds = StatsRegistry::getInstance().counter("Render/ProgramBinds");
+	programBinds.add();
 	glUseProgram(m_programId);
 }
 
 void Shader::setMat4(const std::string& name, const glm::mat4& mat) const {
+	countUniformUpload();
 	glProgramUniformMatrix4fv(m_programId, glGetUniformLocation(m_programId, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
 }
 void Shader::setMat3(const std::string& name, const glm::mat3& mat) const {
+	countUniformUpload();
 	glProgramUniformMatrix3fv(m_programId, glGetUniformLocation(m_programId, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
 }
 
 void Shader::setInt(const std::string& name, const int value) const {
+	countUniformUpload();
 	glProgramUniform1i(m_programId, glGetUniformLocation(m_programId, name.c_str()), value);
 }
 
 void Shader::setFloat(const std::string& name, float value) const{
+	countUniformUpload();
 	glProgramUniform1f(m_programId, glGetUniformLocation(m_programId, name.c_str()), value);
 }
 void Shader::setFloat2(const std::string& name, float x, float y) const{
+	countUniformUpload();
 	glProgramUniform2f(m_programId, glGetUniformLocation(m_programId, name.c_str()), x, y);
 }
 void Shader::setFloat3(const std::string& name, float x, float y, float z) const{
+	countUniformUpload();
 	glProgramUniform3f(m_programId, glGetUniformLocation(m_programId, name.c_str()), x, y, z);
 }
 void Shader::setFloat2(const std::string& name, glm::vec2 vec) const{
+	countUniformUpload();
 	glProgramUniform2fv(m_programId, glGetUniformLocation(m_programId, name.c_str()), 1, glm::value_ptr(vec));
 }
 void Shader::setFloat3(const std::string& name, glm::vec3 vec) const {
+	countUniformUpload();
 	glProgramUniform3fv(m_programId, glGetUniformLocation(m_programId, name.c_str()), 1, glm::value_ptr(vec));
 }
\ No newline at end of file
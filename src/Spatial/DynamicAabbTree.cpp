@@ -0,0 +1,250 @@
+#include <Spatial/DynamicAabbTree.h>
+#include <Spatial/Aabb.h>
+#include <algorithm>
+#include <cassert>
+
+DynamicAabbTree::DynamicAabbTree(float margin) : m_margin(margin) {}
+
+void DynamicAabbTree::clear() {
+	m_nodes.clear();
+	m_root = nullNode;
+	m_freeList = nullNode;
+	m_proxyCount = 0;
+}
+
+int32_t DynamicAabbTree::allocateNode() {
+	if (m_freeList == nullNode) {
+		m_nodes.emplace_back();
+		m_nodes.back().height = 0;
+		return static_cast<int32_t>(m_nodes.size() - 1);
+	}
+	const int32_t index = m_freeList;
+	m_freeList = m_nodes[index].parent;
+	m_nodes[index] = Node{};
+	m_nodes[index].height = 0;
+	return index;
+}
+
+void DynamicAabbTree::freeNode(int32_t index) {
+	m_nodes[index].parent = m_freeList;
+	m_nodes[index].height = -1;
+	m_freeList = index;
+}
+
+int32_t DynamicAabbTree::createProxy(const Aabb& aabb, uint32_t userData) {
+	const int32_t proxyId = allocateNode();
+	const glm::vec3 margin(m_margin);
+	m_nodes[proxyId].aabb = { aabb.min - margin, aabb.max + margin };
+	m_nodes[proxyId].userData = userData;
+	insertLeaf(proxyId);
+	++m_proxyCount;
+	return proxyId;
+}
+
+void DynamicAabbTree::destroyProxy(int32_t proxyId) {
+	assert(m_nodes[proxyId].isLeaf());
+	removeLeaf(proxyId);
+	freeNode(proxyId);
+	--m_proxyCount;
+}
+
+bool DynamicAabbTree::moveProxy(int32_t proxyId, const Aabb& aabb, const glm::vec3& displacement) {
+	if (m_nodes[proxyId].aabb.contains(aabb)) {
+		return false;
+	}
+
+	removeLeaf(proxyId);
+
+	const glm::vec3 margin(m_margin);
+	Aabb fat{ aabb.min - margin, aabb.max + margin };
+	/* extend in the direction of travel so steadily moving proxies reinsert less often */
+	const glm::vec3 predicted = displacement * 2.0f;
+	fat.min += glm::min(predicted, glm::vec3(0.0f));
+	fat.max += glm::max(predicted, glm::vec3(0.0f));
+	m_nodes[proxyId].aabb = fat;
+
+	insertLeaf(proxyId);
+	return true;
+}
+
+void DynamicAabbTree::refit(int32_t index) {
+	while (index != nullNode) {
+		index = balance(index);
+		Node& node = m_nodes[index];
+		const Node& child1 = m_nodes[node.child1];
+		const Node& child2 = m_nodes[node.child2];
+		node.height = 1 + std::max(child1.height, child2.height);
+		node.aabb = Aabb::merge(child1.aabb, child2.aabb);
+		index = node.parent;
+	}
+}
+
+void DynamicAabbTree::insertLeaf(int32_t leaf) {
+	if (m_root == nullNode) {
+		m_root = leaf;
+		m_nodes[leaf].parent = nullNode;
+		return;
+	}
+
+	const Aabb leafAabb = m_nodes[leaf].aabb;
+	int32_t index = m_root;
+	while (!m_nodes[index].isLeaf()) {
+		const Node& node = m_nodes[index];
+		const float area = node.aabb.getSurfaceArea();
+		const float combinedArea = Aabb::merge(node.aabb, leafAabb).getSurfaceArea();
+
+		/* cost of making a new parent for this node and the leaf */
+		const float cost = 2.0f * combinedArea;
+		/* minimum cost of pushing the leaf further down */
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto descendCost = [&](int32_t child) {
+			const Aabb& childAabb = m_nodes[child].aabb;
+			const float merged = Aabb::merge(leafAabb, childAabb).getSurfaceArea();
+			if (m_nodes[child].isLeaf()) return merged + inheritanceCost;
+			return merged - childAabb.getSurfaceArea() + inheritanceCost;
+		};
+		const float cost1 = descendCost(node.child1);
+		const float cost2 = descendCost(node.child2);
+
+		if (cost < cost1 && cost < cost2) break;
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const int32_t sibling = index;
+	const int32_t oldParent = m_nodes[sibling].parent;
+	const int32_t newParent = allocateNode();
+	m_nodes[newParent].parent = oldParent;
+	m_nodes[newParent].aabb = Aabb::merge(leafAabb, m_nodes[sibling].aabb);
+	m_nodes[newParent].height = m_nodes[sibling].height + 1;
+	m_nodes[newParent].child1 = sibling;
+	m_nodes[newParent].child2 = leaf;
+
+	if (oldParent != nullNode) {
+		if (m_nodes[oldParent].child1 == sibling) m_nodes[oldParent].child1 = newParent;
+		else m_nodes[oldParent].child2 = newParent;
+	}
+	else {
+		m_root = newParent;
+	}
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	refit(m_nodes[leaf].parent);
+}
+
+void DynamicAabbTree::removeLeaf(int32_t leaf) {
+	if (leaf == m_root) {
+		m_root = nullNode;
+		return;
+	}
+
+	const int32_t parent = m_nodes[leaf].parent;
+	const int32_t grandParent = m_nodes[parent].parent;
+	const int32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	if (grandParent != nullNode) {
+		if (m_nodes[grandParent].child1 == parent) m_nodes[grandParent].child1 = sibling;
+		else m_nodes[grandParent].child2 = sibling;
+		m_nodes[sibling].parent = grandParent;
+		freeNode(parent);
+		refit(grandParent);
+	}
+	else {
+		m_root = sibling;
+		m_nodes[sibling].parent = nullNode;
+		freeNode(parent);
+	}
+}
+
+/* rotates the taller child up when the subtree heights differ by more than one */
+int32_t DynamicAabbTree::balance(int32_t iA) {
+	Node& A = m_nodes[iA];
+	if (A.isLeaf() || A.height < 2) {
+		return iA;
+	}
+
+	const int32_t iB = A.child1;
+	const int32_t iC = A.child2;
+	Node& B = m_nodes[iB];
+	Node& C = m_nodes[iC];
+	const int32_t balanceFactor = C.height - B.height;
+
+	if (balanceFactor > 1) {
+		const int32_t iF = C.child1;
+		const int32_t iG = C.child2;
+		Node& F = m_nodes[iF];
+		Node& G = m_nodes[iG];
+
+		C.child1 = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+		if (C.parent != nullNode) {
+			if (m_nodes[C.parent].child1 == iA) m_nodes[C.parent].child1 = iC;
+			else m_nodes[C.parent].child2 = iC;
+		}
+		else {
+			m_root = iC;
+		}
+
+		if (F.height > G.height) {
+			C.child2 = iF;
+			A.child2 = iG;
+			G.parent = iA;
+			A.aabb = Aabb::merge(B.aabb, G.aabb);
+			C.aabb = Aabb::merge(A.aabb, F.aabb);
+			A.height = 1 + std::max(B.height, G.height);
+			C.height = 1 + std::max(A.height, F.height);
+		}
+		else {
+			C.child2 = iG;
+			A.child2 = iF;
+			F.parent = iA;
+			A.aabb = Aabb::merge(B.aabb, F.aabb);
+			C.aabb = Aabb::merge(A.aabb, G.aabb);
+			A.height = 1 + std::max(B.height, F.height);
+			C.height = 1 + std::max(A.height, G.height);
+		}
+		return iC;
+	}
+
+	if (balanceFactor < -1) {
+		const int32_t iD = B.child1;
+		const int32_t iE = B.child2;
+		Node& D = m_nodes[iD];
+		Node& E = m_nodes[iE];
+
+		B.child1 = iA;
+		B.parent = A.parent;
+		A.parent = iB;
+		if (B.parent != nullNode) {
+			if (m_nodes[B.parent].child1 == iA) m_nodes[B.parent].child1 = iB;
+			else m_nodes[B.parent].child2 = iB;
+		}
+		else {
+			m_root = iB;
+		}
+
+		if (D.height > E.height) {
+			B.child2 = iD;
+			A.child1 = iE;
+			E.parent = iA;
+			A.aabb = Aabb::merge(C.aabb, E.aabb);
+			B.aabb = Aabb::merge(A.aabb, D.aabb);
+			A.height = 1 + std::max(C.height, E.height);
+			B.height = 1 + std::max(A.height, D.height);
+		}
+		else {
+			B.child2 = iE;
+			A.child1 = iD;
+			D.parent = iA;
+			A.aabb = Aabb::merge(C.aabb, D.aabb);
+			B.aabb = Aabb::merge(A.aabb, E.aabb);
+			A.height = 1 + std::max(C.height, D.height);
+			B.height = 1 + std::max(A.height, E.height);
+		}
+		return iB;
+	}
+
+	return iA;
+}
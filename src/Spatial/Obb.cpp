@@ -0,0 +1,116 @@
+#include <Spatial/Obb.h>
+#include <Spatial/Aabb.h>
+#include <Instance/BasePart.h>
+#include <glm/glm.hpp>
+#include <cmath>
+#include <limits>
+
+Obb Obb::fromPart(const BasePart& part) {
+	return { part.position, part.getRotationMatrix(), part.size * 0.5f };
+}
+
+Obb Obb::fromAabb(const Aabb& aabb) {
+	return { aabb.getCenter(), glm::mat3(1.0f), aabb.getExtents() };
+}
+
+Aabb Obb::getBounds() const {
+	glm::vec3 extent{ 0.0f };
+	for (int axis = 0; axis < 3; ++axis) {
+		extent += glm::abs(axes[axis]) * halfExtents[axis];
+	}
+	return { center - extent, center + extent };
+}
+
+glm::vec3 Obb::closestPoint(const glm::vec3& point) const {
+	const glm::vec3 d = point - center;
+	glm::vec3 result = center;
+	for (int axis = 0; axis < 3; ++axis) {
+		const float distance = glm::clamp(glm::dot(d, axes[axis]), -halfExtents[axis], halfExtents[axis]);
+		result += axes[axis] * distance;
+	}
+	return result;
+}
+
+float Obb::distanceSquared(const glm::vec3& point) const {
+	const glm::vec3 d = point - closestPoint(point);
+	return glm::dot(d, d);
+}
+
+// separating axis test over the 15 candidate axes (Ericson, Real-Time Collision Detection 4.4.1)
+bool Obb::overlaps(const Obb& other) const {
+	constexpr float epsilon = 1e-6f;
+	float R[3][3], absR[3][3];
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			R[i][j] = glm::dot(axes[i], other.axes[j]);
+			absR[i][j] = std::abs(R[i][j]) + epsilon;
+		}
+	}
+
+	const glm::vec3 d = other.center - center;
+	const float t[3] = { glm::dot(d, axes[0]), glm::dot(d, axes[1]), glm::dot(d, axes[2]) };
+	const glm::vec3& a = halfExtents;
+	const glm::vec3& b = other.halfExtents;
+
+	for (int i = 0; i < 3; ++i) {
+		const float rb = b[0] * absR[i][0] + b[1] * absR[i][1] + b[2] * absR[i][2];
+		if (std::abs(t[i]) > a[i] + rb) return false;
+	}
+
+	for (int j = 0; j < 3; ++j) {
+		const float ra = a[0] * absR[0][j] + a[1] * absR[1][j] + a[2] * absR[2][j];
+		const float distance = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+		if (std::abs(distance) > ra + b[j]) return false;
+	}
+
+	for (int i = 0; i < 3; ++i) {
+		const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+		for (int j = 0; j < 3; ++j) {
+			const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+			const float ra = a[i1] * absR[i2][j] + a[i2] * absR[i1][j];
+			const float rb = b[j1] * absR[i][j2] + b[j2] * absR[i][j1];
+			const float distance = t[i2] * R[i1][j] - t[i1] * R[i2][j];
+			if (std::abs(distance) > ra + rb) return false;
+		}
+	}
+	return true;
+}
+
+bool Obb::intersectsRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& outDistance, glm::vec3& outNormal) const {
+	const glm::vec3 relative = origin - center;
+	float enter = 0.0f;
+	float exit = maxDistance;
+	int enterAxis = -1;
+	float enterSign = 0.0f;
+
+	for (int axis = 0; axis < 3; ++axis) {
+		const float o = glm::dot(relative, axes[axis]);
+		const float dir = glm::dot(direction, axes[axis]);
+		const float extent = halfExtents[axis];
+
+		if (std::abs(dir) < std::numeric_limits<float>::epsilon()) {
+			if (o < -extent || o > extent) return false;
+			continue;
+		}
+
+		const float inv = 1.0f / dir;
+		float t0 = (-extent - o) * inv;
+		float t1 = (extent - o) * inv;
+		float sign = -1.0f;
+		if (t0 > t1) {
+			std::swap(t0, t1);
+			sign = 1.0f;
+		}
+		if (t0 > enter) {
+			enter = t0;
+			enterAxis = axis;
+			enterSign = sign;
+		}
+		exit = std::min(exit, t1);
+		if (enter > exit) return false;
+	}
+
+	outDistance = enter;
+	outNormal = enterAxis >= 0 ? axes[enterAxis] * enterSign : -glm::normalize(direction);
+	return true;
+}
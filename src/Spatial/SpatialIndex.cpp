@@ -0,0 +1,170 @@
+#include <Spatial/SpatialIndex.h>
+#include <Profiling/Profiler.h>
+#include <Spatial/Obb.h>
+#include <Instance/BasePart.h>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+glm::vec3 SpatialIndex::computeExtent(const BasePart& part) {
+	return Obb::fromPart(part).getBounds().getExtents();
+}
+
+void SpatialIndex::attach(const InstancePtr& root) {
+	detach();
+	if (!root) return;
+
+	for (const auto& inst : root->getDescendants()) {
+		if (auto part = std::dynamic_pointer_cast<BasePart>(inst)) insert(part);
+	}
+	m_addedConnection = root->descendantAdded.connect([this](InstancePtr inst) {
+		if (auto part = std::dynamic_pointer_cast<BasePart>(inst)) insert(part);
+	});
+	m_removingConnection = root->descendantRemoving.connect([this](InstancePtr inst) {
+		if (auto part = dynamic_cast<BasePart*>(inst.get())) remove(part);
+	});
+}
+
+void SpatialIndex::detach() {
+	m_addedConnection.disconnect();
+	m_removingConnection.disconnect();
+	m_tree.clear();
+	m_proxies.clear();
+	m_freeProxies.clear();
+	m_lookup.clear();
+}
+
+void SpatialIndex::insert(const std::shared_ptr<BasePart>& part) {
+	if (!part || m_lookup.contains(part.get())) return;
+
+	uint32_t index;
+	if (!m_freeProxies.empty()) {
+		index = m_freeProxies.back();
+		m_freeProxies.pop_back();
+	}
+	else {
+		index = static_cast<uint32_t>(m_proxies.size());
+		m_proxies.emplace_back();
+	}
+
+	auto& proxy = m_proxies[index];
+	proxy.part = part;
+	proxy.position = part->position;
+	proxy.orientation = part->orientation;
+	proxy.size = part->size;
+	proxy.extent = computeExtent(*part);
+	proxy.treeId = m_tree.createProxy({ part->position - proxy.extent, part->position + proxy.extent }, index);
+	m_lookup.emplace(part.get(), index);
+}
+
+void SpatialIndex::remove(const BasePart* part) {
+	auto it = m_lookup.find(part);
+	if (it == m_lookup.end()) return;
+
+	auto& proxy = m_proxies[it->second];
+	m_tree.destroyProxy(proxy.treeId);
+	proxy = Proxy{};
+	m_freeProxies.push_back(it->second);
+	m_lookup.erase(it);
+}
+
+void SpatialIndex::update() {
+	PROFILE_ZONE("SpatialIndex");
+	for (auto& proxy : m_proxies) {
+		if (!proxy.part) continue;
+		const BasePart& part = *proxy.part;
+		if (part.position == proxy.position && part.orientation == proxy.orientation && part.size == proxy.size) continue;
+
+		if (part.orientation != proxy.orientation || part.size != proxy.size) {
+			proxy.orientation = part.orientation;
+			proxy.size = part.size;
+			proxy.extent = computeExtent(part);
+		}
+		const glm::vec3 displacement = part.position - proxy.position;
+		proxy.position = part.position;
+		m_tree.moveProxy(proxy.treeId, { part.position - proxy.extent, part.position + proxy.extent }, displacement);
+	}
+}
+
+std::optional<RaycastResult> SpatialIndex::raycast(const glm::vec3& origin, const glm::vec3& direction, const Filter& filter) const {
+	const float maxDistance = glm::length(direction);
+	if (maxDistance <= 0.0f) return std::nullopt;
+	const glm::vec3 unitDirection = direction / maxDistance;
+
+	std::optional<RaycastResult> closest;
+	m_tree.raycast(origin, unitDirection, maxDistance, [&](int32_t treeId, float currentMax) -> float {
+		const auto& part = m_proxies[m_tree.getUserData(treeId)].part;
+		if (filter && !filter(*part)) return currentMax;
+
+		float distance;
+		glm::vec3 normal;
+		if (!Obb::fromPart(*part).intersectsRay(origin, unitDirection, currentMax, distance, normal)) return currentMax;
+
+		closest = RaycastResult{ part, origin + unitDirection * distance, normal, distance };
+		/* a hit at distance 0 means the ray starts inside, nothing can be closer */
+		return distance;
+	});
+	return closest;
+}
+
+std::vector<std::shared_ptr<BasePart>> SpatialIndex::getPartsInBox(const glm::vec3& center, const glm::vec3& size, const glm::vec3& orientation, const Filter& filter) const {
+	const Obb box{ center, BasePart::orientationToMatrix(orientation), size * 0.5f };
+	std::vector<std::shared_ptr<BasePart>> result;
+	m_tree.query(box.getBounds(), [&](int32_t treeId) {
+		const auto& part = m_proxies[m_tree.getUserData(treeId)].part;
+		if ((!filter || filter(*part)) && box.overlaps(Obb::fromPart(*part))) {
+			result.push_back(part);
+		}
+		return true;
+	});
+	return result;
+}
+
+std::vector<std::shared_ptr<BasePart>> SpatialIndex::getPartsInRadius(const glm::vec3& center, float radius, const Filter& filter) const {
+	const Aabb bounds{ center - glm::vec3(radius), center + glm::vec3(radius) };
+	const float radiusSquared = radius * radius;
+	std::vector<std::shared_ptr<BasePart>> result;
+	m_tree.query(bounds, [&](int32_t treeId) {
+		const auto& part = m_proxies[m_tree.getUserData(treeId)].part;
+		if ((!filter || filter(*part)) && Obb::fromPart(*part).distanceSquared(center) <= radiusSquared) {
+			result.push_back(part);
+		}
+		return true;
+	});
+	return result;
+}
+
+std::vector<std::shared_ptr<BasePart>> SpatialIndex::getNearestParts(const glm::vec3& point, size_t k, const Filter& filter) const {
+	std::vector<std::shared_ptr<BasePart>> result;
+	if (k == 0) return result;
+
+	/* max-heap of the best k so far, the top is the current pruning distance */
+	using Candidate = std::pair<float, const std::shared_ptr<BasePart>*>;
+	std::vector<Candidate> best;
+	best.reserve(k + 1);
+	auto farther = [](const Candidate& a, const Candidate& b) { return a.first < b.first; };
+
+	m_tree.queryNearest(point, [&](int32_t treeId) -> float {
+		const auto& part = m_proxies[m_tree.getUserData(treeId)].part;
+		if (!filter || filter(*part)) {
+			best.emplace_back(Obb::fromPart(*part).distanceSquared(point), &part);
+			std::push_heap(best.begin(), best.end(), farther);
+			if (best.size() > k) {
+				std::pop_heap(best.begin(), best.end(), farther);
+				best.pop_back();
+			}
+		}
+		return best.size() < k ? std::numeric_limits<float>::infinity() : best.front().first;
+	});
+
+	std::sort_heap(best.begin(), best.end(), farther);
+	result.reserve(best.size());
+	for (const auto& [distance, part] : best) result.push_back(*part);
+	return result;
+}
+
+size_t SpatialIndex::size() const {
+	return m_lookup.size();
+}
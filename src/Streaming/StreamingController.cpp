@@ -0,0 +1,144 @@
+#include <Streaming/StreamingController.h>
+#include <Profiling/Profiler.h>
+#include <PlaceSerializer/PlaceDeserializer.h>
+#include <Instance/Part.h>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <print>
+#include <string>
+#include <vector>
+
+StreamingController::StreamingController(std::string filename, PlaceDocument document, Settings settings, ThreadPool& pool)
+	: m_filename(std::move(filename)), m_document(std::move(document)), m_settings(settings), m_pool(pool) {
+	m_regions.resize(m_document.regions.size());
+	for (size_t i = 0; i < m_regions.size(); ++i) {
+		auto& region = m_regions[i];
+		region.info = m_document.regions[i];
+		region.estimatedBytes = region.info.size + static_cast<size_t>(region.info.instanceCount) * sizeof(Part);
+	}
+}
+
+StreamingController::~StreamingController() {
+	for (auto& region : m_regions) {
+		if (region.pending.valid()) region.pending.wait();
+	}
+}
+
+void StreamingController::update(const glm::vec3& focus) {
+	PROFILE_ZONE("Streaming");
+	const float regionSize = m_document.streamingRegionSize;
+	if (regionSize <= 0.0f) return;
+
+	for (auto& region : m_regions) {
+		const glm::vec3 boundsMin = glm::vec3(region.info.cell) * regionSize;
+		const glm::vec3 boundsMax = boundsMin + glm::vec3(regionSize);
+		const glm::vec3 outside = glm::max(glm::max(boundsMin - focus, focus - boundsMax), glm::vec3(0.0f));
+		region.distance = glm::length(outside);
+	}
+
+	for (auto& region : m_regions) {
+		if (region.state != RegionState::Loading) continue;
+		if (region.pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+			finishLoad(region);
+		}
+	}
+
+	for (auto& region : m_regions) {
+		if (region.state == RegionState::Loaded && region.distance > m_settings.unloadRadius) {
+			unload(region);
+		}
+	}
+
+	std::vector<Region*> candidates;
+	for (auto& region : m_regions) {
+		if (region.state == RegionState::Unloaded && region.distance <= m_settings.targetRadius) {
+			candidates.push_back(&region);
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), [](const Region* a, const Region* b) { return a->distance < b->distance; });
+
+	for (auto* region : candidates) {
+		if (m_pendingCount >= m_settings.maxConcurrentLoads) break;
+
+		while (m_memoryUsage + region->estimatedBytes > m_settings.memoryBudgetBytes) {
+			Region* farthest = nullptr;
+			for (auto& loaded : m_regions) {
+				if (loaded.state != RegionState::Loaded || loaded.distance <= region->distance) continue;
+				if (!farthest || loaded.distance > farthest->distance) farthest = &loaded;
+			}
+			if (!farthest) break;
+			unload(*farthest);
+		}
+		if (m_memoryUsage + region->estimatedBytes > m_settings.memoryBudgetBytes) break;
+
+		region->state = RegionState::Loading;
+		m_memoryUsage += region->estimatedBytes;
+		++m_pendingCount;
+		region->pending = m_pool.submit([filename = m_filename, info = region->info]() {
+			return PlaceDeserializer::deserializeRegion(filename, info);
+		});
+	}
+}
+
+void StreamingController::finishLoad(Region& region) {
+	--m_pendingCount;
+
+	PlaceRegionContents contents;
+	try {
+		contents = region.pending.get();
+	}
+	catch (const std::exception& e) {
+		std::println("Failed to stream region ({}, {}, {}): {}", region.info.cell.x, region.info.cell.y, region.info.cell.z, e.what());
+		region.state = RegionState::Unloaded;
+		m_memoryUsage -= region.estimatedBytes;
+		return;
+	}
+
+	if (region.distance > m_settings.unloadRadius) {
+		region.state = RegionState::Unloaded;
+		m_memoryUsage -= region.estimatedBytes;
+		return;
+	}
+
+	region.roots.reserve(contents.roots.size());
+	for (auto& [root, parentReferent] : contents.roots) {
+		if (parentReferent < 0 || static_cast<size_t>(parentReferent) >= m_document.referents.size()) continue;
+		auto par = m_document.referents[parentReferent].lock();
+		if (!par) continue;
+		root->setParent(par);
+		region.roots.push_back(std::move(root));
+	}
+	region.state = RegionState::Loaded;
+	++m_loadedCount;
+}
+
+void StreamingController::unload(Region& region) {
+	for (auto& root : region.roots) {
+		root->destroy();
+	}
+	region.roots.clear();
+	region.state = RegionState::Unloaded;
+	m_memoryUsage -= region.estimatedBytes;
+	--m_loadedCount;
+}
+
+size_t StreamingController::getRegionCount() const {
+	return m_regions.size();
+}
+
+size_t StreamingController::getLoadedRegionCount() const {
+	return m_loadedCount;
+}
+
+size_t StreamingController::getPendingRegionCount() const {
+	return m_pendingCount;
+}
+
+size_t StreamingController::getMemoryUsage() const {
+	return m_memoryUsage;
+}
+
+const StreamingController::Settings& StreamingController::getSettings() const {
+	return m_settings;
+}
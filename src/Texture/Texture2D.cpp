@@ -5,6 +5,14 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 #include <memory>
+#include <Profiling/StatsRegistry.h>
+
+namespace {
+	StatsRegistry::Gauge& textureBytes() {
+		static auto& gauge = StatsRegistry::getInstance().gauge("GPU/TextureBytes");
+		return gauge;
+	}
+}
 
 Texture2D::Texture2D(const std::string& filename) {
 	if (filename.empty()) {
@@ -17,26 +25,38 @@ Texture2D::Texture2D(const std::string& filename) {
 	if (!image) {
 		throw std::runtime_error("Texture2D: failed to load image");
 	}
-	m_size = glm::uvec2(width, height);
-
-	glCreateTextures(GL_TEXTURE_2D, 1, &m_id);
+	upload(image, width, height);
+}
 
-	glBindTexture(GL_TEXTURE_2D, m_id);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+Texture2D::Texture2D(std::span<const uint8_t> encoded) {
+	int width = 0, height = 0;
+	auto image = stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()), &width, &height, nullptr, 4);
+	if (!image) {
+		throw std::runtime_error("Texture2D: failed to decode image");
+	}
+	upload(image, width, height);
+}
 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+/* takes ownership of image */
+void Texture2D::upload(unsigned char* image, int width, int height) {
+	m_size = glm::uvec2(width, height);
+	textureBytes().add(static_cast<int64_t>(getGpuByteSize()));
 
+	glCreateTextures(GL_TEXTURE_2D, 1, &m_id);
+	glTextureStorage2D(m_id, 1, GL_RGBA8, width, height);
+	glTextureSubImage2D(m_id, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, image);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	glTextureParameteri(m_id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTextureParameteri(m_id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTextureParameteri(m_id, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTextureParameteri(m_id, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
 	stbi_image_free(image);
 }
 void Texture2D::bind(unsigned int slot) const {
-	glActiveTexture(GL_TEXTURE0 + slot);
-	glBindTexture(GL_TEXTURE_2D, m_id);
+	static auto& textureBinds = StatsRegistry::getInstance().counter("Render/TextureBinds");
+	textureBinds.add();
+	glBindTextureUnit(slot, m_id);
 }
 
 glm::uvec2 Texture2D::getSize() const {
@@ -45,6 +65,7 @@ glm::uvec2 Texture2D::getSize() const {
 
 Texture2D::~Texture2D() {
 	if (m_id != 0) {
+		textureBytes().sub(static_cast<int64_t>(getGpuByteSize()));
 		glDeleteTextures(1, &m_id);
 		m_id = 0;
 	}
@@ -1,7 +1,16 @@
 #include <Texture/TextureCubeMap.h>
+#include <stdexcept>
 #include <string>
 #include <glad/glad.h>
 #include <stb/stb_image.h>
+#include <Profiling/StatsRegistry.h>
+
+namespace {
+	StatsRegistry::Gauge& textureBytes() {
+		static auto& gauge = StatsRegistry::getInstance().gauge("GPU/TextureBytes");
+		return gauge;
+	}
+}
 
 
 TextureCubeMap::TextureCubeMap(
@@ -20,32 +29,75 @@ TextureCubeMap::TextureCubeMap(
 		backFilename.c_str(),
 		frontFilename.c_str(),
 	};
-	glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_id);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, m_id);
-
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-	
+	std::array<Face, 6> decoded;
 	for (size_t i = 0; i < 6; i++) {
-		const auto texFace = GL_TEXTURE_CUBE_MAP_POSITIVE_X + i;
+		decoded[i].data = stbi_load(faces[i], &decoded[i].width, &decoded[i].height, nullptr, 3);
+	}
+	upload(decoded);
+}
 
-		int width, height;
-		const auto data = stbi_load(faces[i], &width, &height, nullptr, 3);
-		if (!data) continue;
-		glTexImage2D(texFace, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-		stbi_image_free(data);
+TextureCubeMap::TextureCubeMap(const std::array<std::span<const uint8_t>, 6>& encodedFaces) {
+	const std::span<const uint8_t> faces[6] = {
+		encodedFaces[3],
+		encodedFaces[2],
+		encodedFaces[4],
+		encodedFaces[5],
+		encodedFaces[1],
+		encodedFaces[0],
+	};
+	std::array<Face, 6> decoded;
+	for (size_t i = 0; i < 6; i++) {
+		decoded[i].data = stbi_load_from_memory(faces[i].data(), static_cast<int>(faces[i].size()), &decoded[i].width, &decoded[i].height, nullptr, 3);
 	}
-	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	upload(decoded);
+}
+
+void TextureCubeMap::upload(std::array<Face, 6>& faces) {
+	/* immutable storage needs one size for every face up front, faces that failed to decode are left undefined */
+	const Face* sized = nullptr;
+	for (const auto& face : faces) {
+		if (!face.data) continue;
+		if (!sized) sized = &face;
+		else if (face.width != sized->width || face.height != sized->height) sized = nullptr;
+		if (!sized) break;
+	}
+	if (!sized) {
+		for (auto& face : faces) {
+			if (face.data) stbi_image_free(face.data);
+		}
+		throw std::runtime_error("TextureCubeMap: no faces decoded, or faces differ in size");
+	}
+	const int width = sized->width;
+	const int height = sized->height;
+
+	glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_id);
+	glTextureStorage2D(m_id, 1, GL_RGB8, width, height);
+	for (size_t i = 0; i < faces.size(); i++) {
+		if (!faces[i].data) continue;
+		/* a cube map's faces are the layers of its storage, in GL order */
+		glTextureSubImage3D(m_id, 0, 0, 0, static_cast<GLint>(i), width, height, 1, GL_RGB, GL_UNSIGNED_BYTE, faces[i].data);
+		stbi_image_free(faces[i].data);
+		faces[i].data = nullptr;
+	}
+
+	glTextureParameteri(m_id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTextureParameteri(m_id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTextureParameteri(m_id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTextureParameteri(m_id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTextureParameteri(m_id, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+	m_byteSize = static_cast<size_t>(width) * height * 3 * faces.size();
+	textureBytes().add(static_cast<int64_t>(m_byteSize));
 }
 
 void TextureCubeMap::bind(unsigned int slot) const {
-	glBindTexture(GL_TEXTURE_CUBE_MAP, m_id);
+	static auto& textureBinds = StatsRegistry::getInstance().counter("Render/TextureBinds");
+	textureBinds.add();
+	glBindTextureUnit(slot, m_id);
 }
 TextureCubeMap::~TextureCubeMap() {
-	if (!m_id) {
+	if (m_id) {
+		textureBytes().sub(static_cast<int64_t>(m_byteSize));
 		glDeleteTextures(1, &m_id);
 		m_id = 0;
 	}
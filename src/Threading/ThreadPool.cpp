@@ -0,0 +1,106 @@
+#include <Threading/ThreadPool.h>
+#include <Profiling/Profiler.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+ThreadPool::ThreadPool(size_t threadCount) {
+	if (threadCount == 0) {
+		const auto hardware = std::thread::hardware_concurrency();
+		threadCount = hardware > 1 ? hardware - 1 : 1;
+	}
+	m_workers.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; ++i) {
+		m_workers.emplace_back([this, i](std::stop_token stop) { workerLoop(stop, i); });
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	for (auto& worker : m_workers) {
+		worker.request_stop();
+	}
+	m_condition.notify_all();
+	m_workers.clear();
+}
+
+ThreadPool& ThreadPool::getInstance() {
+	static ThreadPool instance;
+	return instance;
+}
+
+size_t ThreadPool::getThreadCount() const {
+	return m_workers.size();
+}
+
+void ThreadPool::enqueue(std::function<void()> job) {
+	{
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_jobs.push_back(std::move(job));
+	}
+	m_condition.notify_one();
+}
+
+void ThreadPool::workerLoop(std::stop_token stop, size_t index) {
+	Profiler::getInstance().setThreadName("Worker " + std::to_string(index));
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lk(m_mutex);
+			if (!m_condition.wait(lk, stop, [this]() { return !m_jobs.empty(); })) {
+				return;
+			}
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+		job();
+	}
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+	if (count == 0) return;
+	if (count == 1 || m_workers.empty()) {
+		for (size_t i = 0; i < count; ++i) fn(i);
+		return;
+	}
+
+	struct Shared {
+		std::atomic<size_t> next{ 0 };
+		std::atomic<size_t> done{ 0 };
+		std::mutex mutex;
+		std::condition_variable finished;
+		std::exception_ptr error;
+	};
+	auto shared = std::make_shared<Shared>();
+
+	auto run = [shared, count, &fn]() {
+		size_t completed = 0;
+		for (size_t i = shared->next.fetch_add(1); i < count; i = shared->next.fetch_add(1)) {
+			try {
+				fn(i);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lk(shared->mutex);
+				if (!shared->error) shared->error = std::current_exception();
+			}
+			++completed;
+		}
+		if (completed && shared->done.fetch_add(completed) + completed == count) {
+			std::lock_guard<std::mutex> lk(shared->mutex);
+			shared->finished.notify_all();
+		}
+	};
+
+	const size_t helpers = std::min(m_workers.size(), count - 1);
+	for (size_t i = 0; i < helpers; ++i) {
+		enqueue(run);
+	}
+	run();
+
+	std::unique_lock<std::mutex> lk(shared->mutex);
+	shared->finished.wait(lk, [&]() { return shared->done.load() == count; });
+	if (shared->error) std::rethrow_exception(shared->error);
+}
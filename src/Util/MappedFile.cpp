@@ -0,0 +1,108 @@
+#include <Util/MappedFile.h>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this == &other) return *this;
+	close();
+	m_data = std::exchange(other.m_data, nullptr);
+	m_size = std::exchange(other.m_size, 0);
+	m_open = std::exchange(other.m_open, false);
+#ifdef _WIN32
+	m_file = std::exchange(other.m_file, nullptr);
+	m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+	return *this;
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string& filename) {
+	close();
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		return false;
+	}
+	m_file = file;
+	m_open = true;
+	if (size.QuadPart == 0) return true;
+
+	m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_mapping) {
+		close();
+		return false;
+	}
+	m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!m_data) {
+		close();
+		return false;
+	}
+	m_size = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+
+void MappedFile::close() {
+	if (m_data) UnmapViewOfFile(m_data);
+	if (m_mapping) CloseHandle(m_mapping);
+	if (m_file) CloseHandle(m_file);
+	m_data = nullptr;
+	m_mapping = nullptr;
+	m_file = nullptr;
+	m_size = 0;
+	m_open = false;
+}
+#else
+bool MappedFile::open(const std::string& filename) {
+	close();
+	const int descriptor = ::open(filename.c_str(), O_RDONLY);
+	if (descriptor < 0) return false;
+
+	struct stat status {};
+	if (fstat(descriptor, &status) != 0) {
+		::close(descriptor);
+		return false;
+	}
+	m_open = true;
+	if (status.st_size > 0) {
+		void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if (data == MAP_FAILED) {
+			::close(descriptor);
+			m_open = false;
+			return false;
+		}
+		m_data = static_cast<const uint8_t*>(data);
+		m_size = static_cast<size_t>(status.st_size);
+	}
+	/* the mapping keeps the file alive */
+	::close(descriptor);
+	return true;
+}
+
+void MappedFile::close() {
+	if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+	m_data = nullptr;
+	m_size = 0;
+	m_open = false;
+}
+#endif
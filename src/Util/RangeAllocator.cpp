@@ -0,0 +1,193 @@
+#include <Util/RangeAllocator.h>
+#include <algorithm>
+#include <bit>
+
+RangeAllocator::RangeAllocator(size_t capacity) {
+	reset(capacity);
+}
+
+void RangeAllocator::mapInsert(size_t size, uint32_t& firstLevel, uint32_t& secondLevel) {
+	/* sizes below secondLevelCount get a bin each in the first row, larger ones 16 bins per power of two */
+	if (size < secondLevelCount) {
+		firstLevel = 0;
+		secondLevel = static_cast<uint32_t>(size);
+		return;
+	}
+	const uint32_t log2 = static_cast<uint32_t>(std::bit_width(size) - 1);
+	firstLevel = log2 - secondLevelBits + 1;
+	secondLevel = static_cast<uint32_t>(size >> (log2 - secondLevelBits)) - secondLevelCount;
+}
+
+void RangeAllocator::mapSearch(size_t size, uint32_t& firstLevel, uint32_t& secondLevel) {
+	if (size >= secondLevelCount) {
+		const uint32_t log2 = static_cast<uint32_t>(std::bit_width(size) - 1);
+		size += (size_t(1) << (log2 - secondLevelBits)) - 1;
+	}
+	mapInsert(size, firstLevel, secondLevel);
+}
+
+uint32_t RangeAllocator::newBlock() {
+	if (!m_unusedBlocks.empty()) {
+		const uint32_t block = m_unusedBlocks.back();
+		m_unusedBlocks.pop_back();
+		m_blocks[block] = Block();
+		return block;
+	}
+	m_blocks.emplace_back();
+	return static_cast<uint32_t>(m_blocks.size() - 1);
+}
+
+void RangeAllocator::releaseBlock(uint32_t block) {
+	m_unusedBlocks.push_back(block);
+}
+
+void RangeAllocator::insertFree(uint32_t block) {
+	uint32_t firstLevel, secondLevel;
+	mapInsert(m_blocks[block].size, firstLevel, secondLevel);
+	uint32_t& head = m_freeHeads[firstLevel * secondLevelCount + secondLevel];
+	m_blocks[block].free = true;
+	m_blocks[block].previousFree = invalid;
+	m_blocks[block].nextFree = head;
+	if (head != invalid) m_blocks[head].previousFree = block;
+	head = block;
+	m_firstLevelBitmap |= uint64_t(1) << firstLevel;
+	m_secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+}
+
+void RangeAllocator::removeFree(uint32_t block) {
+	uint32_t firstLevel, secondLevel;
+	mapInsert(m_blocks[block].size, firstLevel, secondLevel);
+	uint32_t& head = m_freeHeads[firstLevel * secondLevelCount + secondLevel];
+	auto& removed = m_blocks[block];
+	if (removed.previousFree != invalid) m_blocks[removed.previousFree].nextFree = removed.nextFree;
+	if (removed.nextFree != invalid) m_blocks[removed.nextFree].previousFree = removed.previousFree;
+	if (head == block) {
+		head = removed.nextFree;
+		if (head == invalid) {
+			m_secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+			if (m_secondLevelBitmaps[firstLevel] == 0) m_firstLevelBitmap &= ~(uint64_t(1) << firstLevel);
+		}
+	}
+	removed.free = false;
+	removed.previousFree = removed.nextFree = invalid;
+}
+
+uint32_t RangeAllocator::findFree(size_t size) const {
+	uint32_t firstLevel, secondLevel;
+	mapSearch(size, firstLevel, secondLevel);
+	if (firstLevel < firstLevelCount) {
+		uint32_t secondLevelMap = m_secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+		uint64_t firstLevelMap = firstLevel + 1 < firstLevelCount ? m_firstLevelBitmap & (~uint64_t(0) << (firstLevel + 1)) : 0;
+		if (secondLevelMap != 0 || firstLevelMap != 0) {
+			if (secondLevelMap == 0) {
+				firstLevel = static_cast<uint32_t>(std::countr_zero(firstLevelMap));
+				secondLevelMap = m_secondLevelBitmaps[firstLevel];
+			}
+			secondLevel = static_cast<uint32_t>(std::countr_zero(secondLevelMap));
+			return m_freeHeads[firstLevel * secondLevelCount + secondLevel];
+		}
+	}
+
+	/* the search rounds size up a bin, missing blocks in size's own bin that still fit it, e.g. the whole buffer */
+	mapInsert(size, firstLevel, secondLevel);
+	if (firstLevel >= firstLevelCount) return invalid;
+	for (uint32_t block = m_freeHeads[firstLevel * secondLevelCount + secondLevel]; block != invalid; block = m_blocks[block].nextFree) {
+		if (m_blocks[block].size >= size) return block;
+	}
+	return invalid;
+}
+
+RangeAllocator::Handle RangeAllocator::allocate(size_t size) {
+	size = std::max<size_t>(size, 1);
+	const uint32_t block = findFree(size);
+	if (block == invalid) return invalid;
+	removeFree(block);
+
+	/* the rest of the block goes back as a free block of its own */
+	if (m_blocks[block].size > size) {
+		const uint32_t rest = newBlock();
+		auto& allocated = m_blocks[block];
+		m_blocks[rest].offset = allocated.offset + size;
+		m_blocks[rest].size = allocated.size - size;
+		m_blocks[rest].previous = block;
+		m_blocks[rest].next = allocated.next;
+		if (allocated.next != invalid) m_blocks[allocated.next].previous = rest;
+		else m_last = rest;
+		allocated.next = rest;
+		allocated.size = size;
+		insertFree(rest);
+	}
+	m_used += size;
+	return block;
+}
+
+void RangeAllocator::free(Handle handle) {
+	if (handle == invalid || m_blocks[handle].free) return;
+	uint32_t block = handle;
+	m_used -= m_blocks[block].size;
+
+	const uint32_t previous = m_blocks[block].previous;
+	if (previous != invalid && m_blocks[previous].free) {
+		removeFree(previous);
+		m_blocks[previous].size += m_blocks[block].size;
+		m_blocks[previous].next = m_blocks[block].next;
+		if (m_blocks[block].next != invalid) m_blocks[m_blocks[block].next].previous = previous;
+		else m_last = previous;
+		releaseBlock(block);
+		block = previous;
+	}
+	const uint32_t next = m_blocks[block].next;
+	if (next != invalid && m_blocks[next].free) {
+		removeFree(next);
+		m_blocks[block].size += m_blocks[next].size;
+		m_blocks[block].next = m_blocks[next].next;
+		if (m_blocks[next].next != invalid) m_blocks[m_blocks[next].next].previous = block;
+		else m_last = block;
+		releaseBlock(next);
+	}
+	insertFree(block);
+}
+
+void RangeAllocator::grow(size_t capacity) {
+	if (capacity <= m_capacity) return;
+	const size_t added = capacity - m_capacity;
+	if (m_last != invalid && m_blocks[m_last].free) {
+		removeFree(m_last);
+		m_blocks[m_last].size += added;
+		insertFree(m_last);
+	}
+	else {
+		const uint32_t block = newBlock();
+		m_blocks[block].offset = m_capacity;
+		m_blocks[block].size = added;
+		m_blocks[block].previous = m_last;
+		if (m_last != invalid) m_blocks[m_last].next = block;
+		m_last = block;
+		insertFree(block);
+	}
+	m_capacity = capacity;
+}
+
+void RangeAllocator::reset(size_t capacity) {
+	m_blocks.clear();
+	m_unusedBlocks.clear();
+	m_firstLevelBitmap = 0;
+	m_secondLevelBitmaps.fill(0);
+	m_freeHeads.fill(invalid);
+	m_last = invalid;
+	m_capacity = 0;
+	m_used = 0;
+	grow(capacity);
+}
+
+size_t RangeAllocator::getLargestFree() const {
+	if (m_firstLevelBitmap == 0) return 0;
+	/* only the highest occupied bin can hold it, but its blocks vary in size */
+	const uint32_t firstLevel = static_cast<uint32_t>(std::bit_width(m_firstLevelBitmap) - 1);
+	const uint32_t secondLevel = static_cast<uint32_t>(std::bit_width(m_secondLevelBitmaps[firstLevel]) - 1);
+	size_t largest = 0;
+	for (uint32_t block = m_freeHeads[firstLevel * secondLevelCount + secondLevel]; block != invalid; block = m_blocks[block].nextFree) {
+		largest = std::max(largest, m_blocks[block].size);
+	}
+	return largest;
+}
@@ -0,0 +1,56 @@
+#include "Test.h"
+#include <Instance/Instance.h>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+	bool setParentThrows(const InstancePtr& instance, const InstancePtr& newParent) {
+		try {
+			instance->setParent(newParent);
+		}
+		catch (const std::runtime_error&) {
+			return true;
+		}
+		return false;
+	}
+
+	/* parenting into a cycle must throw and leave the tree as it was, not hang the ancestor walks */
+	void testCircularParentRejected() {
+		auto a = std::make_shared<Instance>();
+		auto b = std::make_shared<Instance>();
+		auto c = std::make_shared<Instance>();
+		b->setParent(a);
+		c->setParent(b);
+
+		Test::check(setParentThrows(a, a), "parenting to itself throws");
+		Test::check(setParentThrows(a, b), "parenting to a child throws");
+		Test::check(setParentThrows(a, c), "parenting to a deeper descendant throws");
+		Test::check(a->parent.expired() && b->parent.lock() == a && c->parent.lock() == b, "tree unchanged after a rejected parent");
+		Test::check(a->getChildren().size() == 1 && b->getChildren().size() == 1 && c->getChildren().empty(), "children unchanged after a rejected parent");
+		Test::check(a->isAncestorOf(c.get()) && !c->isAncestorOf(a.get()), "isAncestorOf");
+
+		/* moving c up under a is fine, and a then still has no parent */
+		c->setParent(a);
+		Test::check(c->parent.lock() == a && b->getChildren().empty() && a->getChildren().size() == 2, "reparented to an ancestor");
+	}
+
+	void testDescendantEvents() {
+		auto root = std::make_shared<Instance>();
+		auto child = std::make_shared<Instance>();
+		auto grandchild = std::make_shared<Instance>();
+		grandchild->setParent(child);
+		int added = 0, removing = 0;
+		auto addedConnection = root->descendantAdded.connect([&added](InstancePtr) { ++added; });
+		auto removingConnection = root->descendantRemoving.connect([&removing](InstancePtr) { ++removing; });
+		child->setParent(root);
+		Test::check(added == 2, "descendantAdded fires for the subtree");
+		child->setParent(nullptr);
+		Test::check(removing == 2, "descendantRemoving fires for the subtree");
+	}
+}
+
+int main() {
+	testCircularParentRejected();
+	testDescendantEvents();
+	return 0;
+}
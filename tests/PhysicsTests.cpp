@@ -0,0 +1,97 @@
+#include "Test.h"
+#include <Instance/BasePart.h>
+#include <Instance/InstanceFactory.h>
+#include <Physics/PhysicsWorld.h>
+#include <memory>
+#include <vector>
+
+/* steps the same scenes in separate worlds and checks the results, headless */
+
+namespace {
+	constexpr float dt = 1.0f / 60.0f;
+
+	struct Scene {
+		InstancePtr root;
+		std::vector<std::shared_ptr<BasePart>> parts;
+	};
+
+	std::shared_ptr<BasePart> createPart(Scene& scene, glm::vec3 position, glm::vec3 size, bool anchored) {
+		auto part = std::static_pointer_cast<BasePart>(InstanceFactory::getInstance().create("Part"));
+		part->position = position;
+		part->size = size;
+		part->anchored = anchored;
+		part->setParent(scene.root);
+		scene.parts.push_back(part);
+		return part;
+	}
+
+	/* tilted boxes dropped in overlapping columns onto a baseplate, so they collide into several islands */
+	Scene createPile() {
+		Scene scene;
+		scene.root = std::make_shared<Instance>();
+		createPart(scene, glm::vec3(0.0f), glm::vec3(200.0f, 2.0f, 200.0f), true);
+		for (int column = 0; column < 6; ++column) {
+			for (int level = 0; level < 8; ++level) {
+				auto part = createPart(scene, glm::vec3(column * 20.0f - 50.0f + level * 0.3f, 4.0f + level * 3.0f, (column % 2) * 0.5f), glm::vec3(2.0f, 2.0f, 2.0f), false);
+				part->orientation = glm::vec3(level * 7.0f, column * 11.0f, 5.0f);
+			}
+		}
+		return scene;
+	}
+
+	Scene simulate(bool multithreaded, int steps) {
+		PhysicsWorld::Settings settings;
+		settings.multithreaded = multithreaded;
+		PhysicsWorld world(settings);
+		auto scene = createPile();
+		world.attach(scene.root);
+		for (int i = 0; i < steps; ++i) world.step(dt);
+		return scene;
+	}
+
+	/* bitwise, a deterministic step has no tolerance */
+	bool same(const Scene& a, const Scene& b) {
+		if (a.parts.size() != b.parts.size()) return false;
+		for (size_t i = 0; i < a.parts.size(); ++i) {
+			const auto& x = *a.parts[i];
+			const auto& y = *b.parts[i];
+			if (x.position != y.position || x.orientation != y.orientation || x.velocity != y.velocity || x.angularVelocity != y.angularVelocity) return false;
+		}
+		return true;
+	}
+
+	void testDeterminism() {
+		const auto first = simulate(true, 180);
+		const auto second = simulate(true, 180);
+		const auto serial = simulate(false, 180);
+		const auto& top = *first.parts.back();
+		Test::check(top.position.y < 25.0f && top.position.y > 1.0f, "the pile fell onto the baseplate");
+		Test::check(same(first, second), "same scene, same transforms");
+		Test::check(same(first, serial), "same transforms on one thread");
+	}
+
+	/* a sleeping stack must fall once the anchored part under it is removed */
+	void testRemovingSupportWakesBodies() {
+		Scene scene;
+		scene.root = std::make_shared<Instance>();
+		auto support = createPart(scene, glm::vec3(0.0f), glm::vec3(4.0f, 1.0f, 4.0f), true);
+		auto lower = createPart(scene, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(2.0f, 1.0f, 2.0f), false);
+		auto upper = createPart(scene, glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(2.0f, 1.0f, 2.0f), false);
+		PhysicsWorld world;
+		world.attach(scene.root);
+		for (int i = 0; i < 300; ++i) world.step(dt);
+		Test::check(world.getStats().awakeBodyCount == 0, "the stack falls asleep");
+
+		const float restingHeight = lower->position.y;
+		support->setParent(nullptr);
+		for (int i = 0; i < 30; ++i) world.step(dt);
+		Test::check(world.getStats().awakeBodyCount == 2, "both boxes woke");
+		Test::check(lower->position.y < restingHeight - 1.0f && upper->position.y < restingHeight, "the stack falls");
+	}
+}
+
+int main() {
+	testDeterminism();
+	testRemovingSupportWakesBodies();
+	return 0;
+}
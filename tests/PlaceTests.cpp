@@ -0,0 +1,198 @@
+#include "Test.h"
+#include <Instance/BasePart.h>
+#include <Instance/InstanceFactory.h>
+#include <Instance/Script.h>
+#include <PlaceSerializer/PlaceDeserializer.h>
+#include <PlaceSerializer/PlaceFormat.h>
+#include <PlaceSerializer/PlaceSerializer.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* writes a place, reads it back and compares every property the format stores */
+
+namespace {
+	InstancePtr create(const std::string& className, const std::string& name, const InstancePtr& parent) {
+		auto instance = InstanceFactory::getInstance().create(className);
+		instance->name = name;
+		instance->setParent(parent);
+		return instance;
+	}
+
+	std::shared_ptr<BasePart> createPart(const std::string& name, const InstancePtr& parent, glm::vec3 position) {
+		auto part = std::static_pointer_cast<BasePart>(create("Part", name, parent));
+		part->position = position;
+		part->orientation = glm::vec3(10.0f, 20.0f, 30.0f);
+		part->size = glm::vec3(1.0f, 2.0f, 3.0f);
+		part->color = glm::u8vec3(12, 34, 56);
+		part->transparency = 0.25f;
+		part->castShadow = false;
+		part->anchored = false;
+		part->friction = 0.9f;
+		return part;
+	}
+
+	/* a DataModel with a Workspace of parts spread over several cells, one with a child, and a script */
+	InstancePtr createPlace() {
+		auto root = InstanceFactory::getInstance().create("DataModel");
+		root->name = "Game";
+		auto workspace = create("Instance", "Workspace", root);
+		for (int i = 0; i < 8; ++i) createPart("Part" + std::to_string(i), workspace, glm::vec3(i * 100.0f, 0.0f, -i * 50.0f));
+		createPart("Child", workspace->findFirstChild("Part3"), glm::vec3(300.0f, 5.0f, -150.0f));
+		auto script = std::static_pointer_cast<Script>(create("Script", "Main", root));
+		script->source = "print(\"hello\")";
+		return root;
+	}
+
+	void checkSame(Instance& expected, Instance& actual) {
+		Test::check(actual.name == expected.name, "name");
+		Test::check(actual.getClassName() == expected.getClassName(), "class name");
+		if (auto* part = dynamic_cast<BasePart*>(&expected)) {
+			auto* other = dynamic_cast<BasePart*>(&actual);
+			Test::check(other != nullptr, "BasePart class");
+			Test::check(other->position == part->position && other->orientation == part->orientation && other->size == part->size, "BasePart transform");
+			Test::check(other->color == part->color && other->transparency == part->transparency, "BasePart appearance");
+			Test::check(other->castShadow == part->castShadow && other->anchored == part->anchored && other->canCollide == part->canCollide, "BasePart flags");
+			Test::check(other->density == part->density && other->friction == part->friction && other->elasticity == part->elasticity, "BasePart material");
+		}
+		if (auto* script = dynamic_cast<Script*>(&expected)) {
+			auto* other = dynamic_cast<Script*>(&actual);
+			Test::check(other != nullptr && other->source == script->source, "Script source");
+		}
+		const auto expectedChildren = expected.getChildren();
+		const auto actualChildren = actual.getChildren();
+		Test::check(actualChildren.size() == expectedChildren.size(), "child count");
+		for (size_t i = 0; i < expectedChildren.size(); ++i) checkSame(*expectedChildren[i], *actualChildren[i]);
+	}
+
+	std::vector<char> readFile(const std::string& filename) {
+		std::ifstream file{ filename, std::ios::binary };
+		return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	}
+
+	void writeFile(const std::string& filename, const std::vector<char>& bytes) {
+		std::ofstream file{ filename, std::ios::binary | std::ios::trunc };
+		file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	bool throws(const std::string& filename) {
+		try {
+			PlaceDeserializer::deserialize(filename);
+		}
+		catch (const std::runtime_error&) {
+			return true;
+		}
+		return false;
+	}
+
+	void writeChunk(PlaceFormat::ByteWriter& out, const char (&type)[4], const PlaceFormat::ByteWriter& payload) {
+		PlaceFormat::ChunkHeader header{};
+		std::memcpy(header.type, type, sizeof(header.type));
+		header.length = static_cast<uint32_t>(payload.buffer.size());
+		out.write(header);
+		out.writeBytes(payload.buffer.data(), payload.buffer.size());
+	}
+
+	/* a place of plain Instances, referent i parented to parents[i], written by hand so it can be malformed */
+	void writePlace(const std::string& filename, const std::vector<int32_t>& parents) {
+		const auto count = static_cast<uint32_t>(parents.size());
+		PlaceFormat::ByteWriter out;
+		PlaceFormat::Header header{};
+		std::memcpy(header.magic, PlaceFormat::magic, sizeof(header.magic));
+		header.version = PlaceFormat::version;
+		header.classCount = 1;
+		header.instanceCount = count;
+		out.write(header);
+
+		PlaceFormat::ByteWriter instances;
+		instances.write(uint32_t(0));
+		instances.writeString("Instance");
+		instances.write(count);
+		for (uint32_t i = 0; i < count; ++i) instances.write(static_cast<int32_t>(i));
+		writeChunk(out, PlaceFormat::chunkInstances, instances);
+
+		PlaceFormat::ByteWriter links;
+		links.write(count);
+		for (uint32_t i = 0; i < count; ++i) links.write(static_cast<int32_t>(i));
+		for (const auto parent : parents) links.write(parent);
+		writeChunk(out, PlaceFormat::chunkParents, links);
+		writeChunk(out, PlaceFormat::chunkEnd, PlaceFormat::ByteWriter{});
+
+		std::ofstream file{ filename, std::ios::binary | std::ios::trunc };
+		file.write(reinterpret_cast<const char*>(out.buffer.data()), static_cast<std::streamsize>(out.buffer.size()));
+	}
+
+	bool openThrows(const std::string& filename) {
+		try {
+			PlaceDeserializer::open(filename);
+		}
+		catch (const std::runtime_error&) {
+			return true;
+		}
+		return false;
+	}
+}
+
+int main() {
+	const auto directory = std::filesystem::temp_directory_path();
+	const std::string filename = (directory / "PlaceTests.place").string();
+	const std::string streamedFilename = (directory / "PlaceTests.streamed.place").string();
+	const std::string corruptFilename = (directory / "PlaceTests.corrupt.place").string();
+	const auto place = createPlace();
+
+	PlaceSerializer::serialize(place, filename);
+	const auto loaded = PlaceDeserializer::deserialize(filename);
+	Test::check(loaded != nullptr, "deserialize returns a root");
+	checkSame(*place, *loaded);
+
+	/* streamed: the body has no Workspace parts, the regions hold all of them and their children */
+	PlaceSerializer::serialize(place, streamedFilename, 256.0f);
+	auto document = PlaceDeserializer::open(streamedFilename);
+	Test::check(document.streamingRegionSize == 256.0f, "streaming region size");
+	Test::check(document.regions.size() > 1, "parts split over several regions");
+	Test::check(document.root->findFirstChild("Workspace")->getChildren().empty(), "streamed parts left out of the body");
+	uint32_t streamed = 0;
+	for (const auto& region : document.regions) {
+		const auto contents = PlaceDeserializer::deserializeRegion(streamedFilename, region);
+		streamed += contents.instanceCount;
+		for (const auto& [root, parent] : contents.roots) {
+			Test::check(parent >= 0 && static_cast<size_t>(parent) < document.referents.size(), "region parent in the body");
+			Test::check(document.referents[parent].lock()->name == "Workspace", "region parts parented to Workspace");
+			checkSame(*place->findFirstChild("Workspace")->findFirstChild(root->name), *root);
+		}
+	}
+	Test::check(streamed == 9, "every part and child streamed");
+
+	/* a class id past the header's class count must be rejected, not index past the class table */
+	auto bytes = readFile(filename);
+	const size_t classIdOffset = sizeof(PlaceFormat::Header) + sizeof(PlaceFormat::ChunkHeader);
+	Test::check(std::memcmp(bytes.data() + sizeof(PlaceFormat::Header), PlaceFormat::chunkInstances, 4) == 0, "body starts with INST");
+	const uint32_t badClassId = 0xFFFFFFFFu;
+	std::memcpy(bytes.data() + classIdOffset, &badClassId, sizeof(badClassId));
+	writeFile(corruptFilename, bytes);
+	Test::check(throws(corruptFilename), "out of range class id rejected");
+
+	/* and so must a file cut short */
+	bytes = readFile(filename);
+	bytes.resize(bytes.size() / 2);
+	writeFile(corruptFilename, bytes);
+	Test::check(throws(corruptFilename), "truncated place rejected");
+
+	/* parent links from the file must not be able to form a cycle, which would hang setParent */
+	writePlace(corruptFilename, { -1, 0, 1 });
+	Test::check(!openThrows(corruptFilename), "hand-written place loads");
+	writePlace(corruptFilename, { -1, 1 });
+	Test::check(openThrows(corruptFilename), "self-parented instance rejected");
+	writePlace(corruptFilename, { -1, 2, 1 });
+	Test::check(openThrows(corruptFilename), "parent cycle rejected");
+
+	std::filesystem::remove(filename);
+	std::filesystem::remove(streamedFilename);
+	std::filesystem::remove(corruptFilename);
+	return 0;
+}
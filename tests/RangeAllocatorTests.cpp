@@ -0,0 +1,94 @@
+#include "Test.h"
+#include <Util/RangeAllocator.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+	void testAllocateAndCoalesce() {
+		RangeAllocator ranges(1000);
+		const auto a = ranges.allocate(100);
+		const auto b = ranges.allocate(200);
+		const auto c = ranges.allocate(300);
+		Test::check(a != RangeAllocator::invalid && b != RangeAllocator::invalid && c != RangeAllocator::invalid, "allocations fit");
+		Test::check(ranges.get(a).offset == 0 && ranges.get(b).offset == 100 && ranges.get(c).offset == 300, "an empty allocator packs ranges back to back");
+		Test::check(ranges.getUsed() == 600 && ranges.getLargestFree() == 400, "used and free after allocating");
+
+		/* a hole the size of a freed range is reused */
+		ranges.free(a);
+		const auto reused = ranges.allocate(100);
+		Test::check(ranges.get(reused).offset == 0, "freed range reused");
+
+		/* freeing both neighbours of b merges all three, then the free tail */
+		ranges.free(reused);
+		ranges.free(c);
+		Test::check(ranges.getLargestFree() == 700, "c merged with the free tail");
+		ranges.free(b);
+		Test::check(ranges.getUsed() == 0 && ranges.getLargestFree() == 1000, "everything merged back into one range");
+		const auto all = ranges.allocate(1000);
+		Test::check(all != RangeAllocator::invalid && ranges.get(all).offset == 0, "the whole capacity allocates once merged");
+	}
+
+	void testLimits() {
+		RangeAllocator ranges(64);
+		Test::check(ranges.allocate(65) == RangeAllocator::invalid, "too large a request fails");
+		const auto empty = ranges.allocate(0);
+		Test::check(ranges.get(empty).size == 1 && ranges.getUsed() == 1, "zero-sized requests take one unit");
+		const auto rest = ranges.allocate(63);
+		Test::check(rest != RangeAllocator::invalid && ranges.allocate(1) == RangeAllocator::invalid, "full");
+
+		/* growing adds a free tail; once rest is freed it merges with it */
+		ranges.grow(128);
+		Test::check(ranges.getCapacity() == 128 && ranges.getLargestFree() == 64, "grown");
+		ranges.free(rest);
+		Test::check(ranges.getLargestFree() == 127, "freed range merged with the grown tail");
+
+		ranges.reset(32);
+		Test::check(ranges.getCapacity() == 32 && ranges.getUsed() == 0 && ranges.getLargestFree() == 32, "reset");
+	}
+
+	/* random allocations and frees against a plain list of live ranges */
+	void testRandom() {
+		constexpr size_t capacity = 1 << 16;
+		RangeAllocator ranges(capacity);
+		std::mt19937 random(1234);
+		struct Live {
+			RangeAllocator::Handle handle;
+			RangeAllocator::Range range;
+		};
+		std::vector<Live> live;
+		size_t used = 0;
+		for (int i = 0; i < 20000; ++i) {
+			if (live.empty() || random() % 3 != 0) {
+				const size_t size = 1 + random() % 512;
+				const auto handle = ranges.allocate(size);
+				if (handle == RangeAllocator::invalid) continue;
+				const auto range = ranges.get(handle);
+				Test::check(range.size == size && range.offset + range.size <= capacity, "range within capacity");
+				for (const auto& other : live) {
+					Test::check(range.offset + range.size <= other.range.offset || other.range.offset + other.range.size <= range.offset, "ranges don't overlap");
+				}
+				live.push_back({ handle, range });
+				used += size;
+			}
+			else {
+				const size_t index = random() % live.size();
+				ranges.free(live[index].handle);
+				used -= live[index].range.size;
+				live[index] = live.back();
+				live.pop_back();
+			}
+			Test::check(ranges.getUsed() == used, "used matches the live ranges");
+		}
+		for (const auto& range : live) ranges.free(range.handle);
+		Test::check(ranges.getUsed() == 0 && ranges.getLargestFree() == capacity, "everything coalesces once freed");
+	}
+}
+
+int main() {
+	testAllocateAndCoalesce();
+	testLimits();
+	testRandom();
+	return 0;
+}
@@ -0,0 +1,146 @@
+#include "Test.h"
+#include <ResourceManager/ResourceCache.h>
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct Resource {
+		size_t gpuBytes = 0;
+		size_t cpuBytes = 0;
+
+		size_t getGpuByteSize() const { return gpuBytes; }
+		size_t getCpuByteSize() const { return cpuBytes; }
+	};
+
+	constexpr int threadCount = 8;
+
+	/* every thread asks for the key at once; the loader is slow enough that the others find it pending */
+	void testConcurrentLoadsCoalesce() {
+		ResourceCache<Resource> cache;
+		std::atomic<int> loads{ 0 };
+		std::latch start(threadCount);
+		std::vector<std::shared_ptr<Resource>> results(threadCount);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < threadCount; ++i) {
+			threads.emplace_back([&, i]() {
+				start.arrive_and_wait();
+				results[i] = cache.getOrLoad("mesh", [&loads]() {
+					loads.fetch_add(1);
+					std::this_thread::sleep_for(std::chrono::milliseconds(50));
+					return std::make_shared<Resource>(Resource{ 100, 10 });
+				});
+			});
+		}
+		for (auto& thread : threads) thread.join();
+
+		Test::check(loads.load() == 1, "the loader ran once");
+		for (const auto& result : results) Test::check(result && result == results[0], "every thread got the same resource");
+		Test::check(cache.size() == 1 && cache.getGpuBytes() == 100 && cache.getCpuBytes() == 10, "one entry counted once");
+	}
+
+	/* the waiters see the loader's exception, and the key isn't left pending so a later call loads it */
+	void testFailedLoadPropagatesAndRetries() {
+		ResourceCache<Resource> cache;
+		std::atomic<int> loads{ 0 };
+		std::atomic<int> failures{ 0 };
+		std::latch start(threadCount);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < threadCount; ++i) {
+			threads.emplace_back([&]() {
+				start.arrive_and_wait();
+				try {
+					cache.getOrLoad("broken", [&loads]() -> std::shared_ptr<Resource> {
+						loads.fetch_add(1);
+						std::this_thread::sleep_for(std::chrono::milliseconds(50));
+						throw std::runtime_error("cannot load");
+					});
+				}
+				catch (const std::runtime_error&) {
+					failures.fetch_add(1);
+				}
+			});
+		}
+		for (auto& thread : threads) thread.join();
+
+		Test::check(loads.load() == 1, "the failing loader ran once");
+		Test::check(failures.load() == threadCount, "every waiter got the exception");
+		Test::check(cache.size() == 0 && cache.find("broken") == nullptr, "nothing cached for a failed load");
+
+		const auto retried = cache.getOrLoad("broken", []() { return std::make_shared<Resource>(Resource{ 1, 1 }); });
+		Test::check(retried && cache.find("broken") == retried, "a later call loads it");
+	}
+
+	void testEvictRespectsOutsideReferences() {
+		ResourceCache<Resource> cache;
+		auto held = cache.insert("texture", std::make_shared<Resource>(Resource{ 64, 8 }));
+		Test::check(cache.getEvictionCandidates().empty(), "a referenced entry isn't a candidate");
+		Test::check(!cache.evict("texture"), "evict refuses a referenced entry");
+		Test::check(cache.find("texture") == held, "the refused entry is still cached");
+
+		/* find() hands out a reference of its own */
+		auto found = cache.find("texture");
+		held.reset();
+		Test::check(!cache.evict("texture"), "evict refuses an entry a lookup returned");
+		found.reset();
+		Test::check(cache.evict("texture"), "evict drops the entry once unreferenced");
+		Test::check(cache.find("texture") == nullptr && !cache.evict("texture"), "gone after eviction");
+	}
+
+	void testByteTotals() {
+		ResourceCache<Resource> cache;
+		for (size_t i = 0; i < 10; ++i) cache.insert("resource" + std::to_string(i), std::make_shared<Resource>(Resource{ i * 100, i }));
+		Test::check(cache.getGpuBytes() == 4500 && cache.getCpuBytes() == 45, "totals add up");
+
+		/* replacing an entry swaps its bytes rather than adding them */
+		cache.insert("resource0", std::make_shared<Resource>(Resource{ 7, 7 }));
+		Test::check(cache.size() == 10 && cache.getGpuBytes() == 4507 && cache.getCpuBytes() == 52, "replaced entry counted once");
+
+		const auto candidates = cache.getEvictionCandidates();
+		Test::check(candidates.size() == 10, "every unreferenced entry is a candidate");
+		for (const auto& candidate : candidates) Test::check(cache.evict(candidate.key), "candidate evicted");
+		Test::check(cache.size() == 0 && cache.getGpuBytes() == 0 && cache.getCpuBytes() == 0, "totals back to zero");
+	}
+
+	/* lookups and loads racing evictions: whatever happens, the totals must match what is left */
+	void testConcurrentEviction() {
+		ResourceCache<Resource> cache;
+		constexpr int keyCount = 16;
+		std::atomic<bool> stop{ false };
+		std::vector<std::thread> threads;
+		for (int i = 0; i < threadCount - 1; ++i) {
+			threads.emplace_back([&, i]() {
+				for (int n = 0; !stop.load(); ++n) {
+					const auto key = std::to_string((i + n) % keyCount);
+					auto resource = cache.getOrLoad(key, []() { return std::make_shared<Resource>(Resource{ 10, 1 }); });
+					Test::check(resource && resource->gpuBytes == 10, "a live resource");
+				}
+			});
+		}
+		threads.emplace_back([&]() {
+			for (int n = 0; n < 2000; ++n) {
+				for (const auto& candidate : cache.getEvictionCandidates()) cache.evict(candidate.key);
+			}
+			stop.store(true);
+		});
+		for (auto& thread : threads) thread.join();
+
+		Test::check(cache.getGpuBytes() == cache.size() * 10 && cache.getCpuBytes() == cache.size(), "totals match the entries left");
+		for (const auto& candidate : cache.getEvictionCandidates()) cache.evict(candidate.key);
+		Test::check(cache.size() == 0 && cache.getGpuBytes() == 0 && cache.getCpuBytes() == 0, "everything evicts once idle");
+	}
+}
+
+int main() {
+	testConcurrentLoadsCoalesce();
+	testFailedLoadPropagatesAndRetries();
+	testEvictRespectsOutsideReferences();
+	testByteTotals();
+	testConcurrentEviction();
+	return 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+#include <print>
+#include <source_location>
+
+/*
+ * Minimal test harness. Every .cpp in tests is its own executable registered with ctest; a failed
+ * check() reports where and exits non-zero, so one failure fails the whole executable.
+ */
+namespace Test {
+	inline void check(bool condition, const char* what, std::source_location where = std::source_location::current()) {
+		if (condition) return;
+		std::println(stderr, "{}:{}: check failed: {}", where.file_name(), where.line(), what);
+		std::exit(1);
+	}
+}
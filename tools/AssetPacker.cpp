@@ -0,0 +1,74 @@
+/* STD DEPENDENCIES */
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <print>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* ASSETS */
+#include <Asset/AssetArchive.h>
+
+/*
+ * Packs loose resource files into an asset archive. Paths are stored as given, relative to the
+ * directory the client runs from, so pack from there:
+ *   GameEnginePacker resources/assets.elpack resources
+ * Directories are walked recursively, only files with a known asset type are packed from them.
+ */
+
+static bool readFile(const std::filesystem::path& path, std::vector<uint8_t>& bytes) {
+	std::ifstream file{ path, std::ios::binary };
+	if (!file.is_open()) return false;
+	bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return !file.bad();
+}
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		std::println("usage: {} <output.elpack> <directory|file>...", argv[0]);
+		return 1;
+	}
+	const std::string outputFilename = argv[1];
+	const auto outputPath = std::filesystem::weakly_canonical(outputFilename);
+
+	AssetArchiveWriter writer;
+	auto add = [&writer](const std::filesystem::path& path) {
+		std::vector<uint8_t> bytes;
+		if (!readFile(path, bytes)) {
+			std::println("Cannot read {}", path.string());
+			return false;
+		}
+		writer.add(path.generic_string(), std::move(bytes));
+		return true;
+	};
+
+	for (int i = 2; i < argc; ++i) {
+		const std::filesystem::path input = argv[i];
+		if (std::filesystem::is_directory(input)) {
+			std::vector<std::filesystem::path> files;
+			for (const auto& item : std::filesystem::recursive_directory_iterator(input)) {
+				if (!item.is_regular_file()) continue;
+				if (AssetArchive::getType(item.path().string()) == AssetArchiveFormat::AssetType::Unknown) continue;
+				if (std::filesystem::weakly_canonical(item.path()) == outputPath) continue;
+				files.push_back(item.path());
+			}
+			/* directory order isn't stable, sort so the same inputs always give the same archive */
+			std::sort(files.begin(), files.end());
+			for (const auto& file : files) {
+				if (!add(file)) return 1;
+			}
+		}
+		else if (!add(input)) {
+			return 1;
+		}
+	}
+
+	if (!writer.write(outputFilename)) {
+		std::println("Cannot write {}", outputFilename);
+		return 1;
+	}
+	std::println("Packed {} assets into {}", writer.getEntryCount(), outputFilename);
+	return 0;
+}
@@ -0,0 +1,107 @@
+/* STD DEPENDENCIES */
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <print>
+#include <string>
+#include <vector>
+
+/* MESH */
+#include <MeshDeserializer/GlbDeserializer.h>
+#include <MeshDeserializer/CookedMeshSerializer.h>
+#include <MeshDeserializer/CookedMeshDeserializer.h>
+#include <Mesh/MeshOptimizer.h>
+#include <Mesh/MeshSimplifier.h>
+
+/*
+ * Cooks .glb meshes into the .emesh format MeshManager prefers (see CookedMeshFormat.h), writing
+ * each next to its source. Meshes are welded and reordered for the vertex cache and overdraw (see
+ * MeshOptimizer.h) unless --no-optimize is given, and get a chain of simplified levels of detail (see
+ * MeshSimplifier.h) unless --no-lods is given. Vertices are packed in VertexLayout::quantized() with
+ * 16-bit indices where they fit, as Mesh3D stores them. Directories are walked recursively; meshes
+ * whose cooked file is current and newer than the source are skipped unless --force is given.
+ *   GameEngineMeshCooker [--force] [--no-optimize] [--no-lods] <directory|file.glb>...
+ */
+
+static bool isGlb(const std::filesystem::path& path) {
+	auto extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return extension == ".glb";
+}
+
+static bool isCurrent(const std::filesystem::path& source, const std::filesystem::path& cooked) {
+	std::error_code error;
+	const auto cookedTime = std::filesystem::last_write_time(cooked, error);
+	if (error) return false;
+	return cookedTime >= std::filesystem::last_write_time(source, error) && !error && CookedMeshDeserializer::isCurrent(cooked.string());
+}
+
+int main(int argc, char** argv) {
+	bool force = false;
+	bool optimize = true;
+	bool lods = true;
+	std::vector<std::filesystem::path> sources;
+	for (int i = 1; i < argc; ++i) {
+		const std::string argument = argv[i];
+		if (argument == "--force") {
+			force = true;
+			continue;
+		}
+		if (argument == "--no-optimize") {
+			optimize = false;
+			continue;
+		}
+		if (argument == "--no-lods") {
+			lods = false;
+			continue;
+		}
+		if (std::filesystem::is_directory(argument)) {
+			for (const auto& item : std::filesystem::recursive_directory_iterator(argument)) {
+				if (item.is_regular_file() && isGlb(item.path())) sources.push_back(item.path());
+			}
+		}
+		else {
+			sources.push_back(argument);
+		}
+	}
+	if (sources.empty()) {
+		std::println("usage: {} [--force] [--no-optimize] [--no-lods] <directory|file.glb>...", argv[0]);
+		return 1;
+	}
+	std::sort(sources.begin(), sources.end());
+
+	size_t cooked = 0, skipped = 0, failed = 0;
+	for (const auto& source : sources) {
+		const auto target = std::filesystem::path(source).replace_extension(".emesh");
+		if (!force && isCurrent(source, target)) {
+			++skipped;
+			continue;
+		}
+		try {
+			const auto start = std::chrono::steady_clock::now();
+			auto data = GlbDeserializer::deserialize(source.string());
+			if (optimize) {
+				const auto report = MeshOptimizer::optimize(data);
+				std::println("Optimized {}: {} -> {} vertices, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}", source.string(), report.verticesBefore, report.verticesAfter, report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr);
+			}
+			if (lods) {
+				MeshSimplifier::generateLods(data);
+				for (size_t level = 0; level < data.lods.size(); ++level) {
+					std::println("  LOD {}: {} triangles, error {:.5f}", level, data.lods[level].indexCount / 3, data.lods[level].error);
+				}
+			}
+			CookedMeshSerializer::serialize(data, target.string());
+			const auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			std::println("Cooked {} ({} vertices, {} indices, {} levels) in {:.1f} ms", target.string(), data.vertices.size(), data.indices.size(), std::max<size_t>(data.lods.size(), 1), milliseconds);
+			++cooked;
+		}
+		catch (const std::exception& e) {
+			std::println("Cannot cook {}: {}", source.string(), e.what());
+			++failed;
+		}
+	}
+	std::println("{} cooked, {} up to date, {} failed", cooked, skipped, failed);
+	return failed ? 1 : 0;
+}